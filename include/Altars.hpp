@@ -0,0 +1,33 @@
+// Altars.hpp
+// Shrines placed by data rather than by Game.cpp: each altar is a new room of
+// Melas' temple holding a shrine from the registry (usually a module's, see
+// ShrineModule.h), opened off a room that's already there and part of its
+// wing. The game reads assets/altars.txt when it builds the temple; an altar
+// whose shrine isn't loaded is left out, so a module ships with its lines in
+// that file and nothing else.
+//
+// File format, `#` comments, one `key = value` per line; `altar` starts the
+// next one:
+//   altar = tyche                                  (shrine key)
+//   room  = The Cast Bones                         (title of the new room)
+//   from  = Room of Borrowed Things, south         (existing room, way in)
+//   text  = Knucklebones drift across the floor... (description)
+// The way back is the opposite direction.
+#pragma once
+#include "Map.hpp"   // Dir
+#include <string>
+#include <vector>
+
+struct AltarSpec {
+    std::string shrine;        // registry key, label or alias
+    std::string room;
+    std::string from;
+    Dir dir = Dir::Count;      // from `from` into the new room
+    std::string description;
+};
+
+// On failure returns false with "name:line: what" in error.
+bool ParseAltars(const std::string& text, const std::string& name,
+                 std::vector<AltarSpec>& out, std::string& error);
+// A missing file is no altars, not an error.
+bool LoadAltars(const std::string& path, std::vector<AltarSpec>& out, std::string& error);
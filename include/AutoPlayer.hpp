@@ -0,0 +1,86 @@
+// AutoPlayer.hpp
+#ifndef AUTOPLAYER_HPP
+#define AUTOPLAYER_HPP
+
+#include "ShrineModel.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Plays a Melas run as well as it can be played for a chosen ending.
+// Expectimax over which wing to visit next (each once, Eris ends the run),
+// how to play its shrine (menu picks, and whether to get the riddles, notes
+// or letter right), with the dice averaged exactly through ShrineModel.
+// Fragments are picked up on the way, as in the game: six in the Persephone
+// wing, two on the way to Demeter's altar, +1 Will each; the letter can only
+// be solved holding all eight. Values are memoized per (stats, corruption,
+// scored flags, wings visited, target) in an open-addressed table.
+
+// The nine wings, in hub order. Bit i of BotState::visited = wing i.
+std::size_t BotWingCount();
+Deity BotWing(std::size_t i);
+
+struct BotState {
+    model::State stats;
+    std::uint16_t visited = 0;
+
+    bool seen(Deity wing) const;
+    // stats key (27 bits) | visited (9 bits)
+    std::uint64_t key() const {
+        return static_cast<std::uint64_t>(stats.key()) |
+               (static_cast<std::uint64_t>(visited) << model::State::kKeyBits);
+    }
+};
+
+// Visit a wing and play its shrine this way. shrine == Default: stop playing.
+struct BotMove {
+    Deity shrine = Deity::Default;
+    model::ShrinePlay play;
+    std::string describe() const;
+};
+
+struct BotOptions {
+    bool nyxHasPages = false;   // journal hooks wired (not yet in Game)
+    bool allowStop   = true;    // may walk away before Eris, with no ending
+};
+
+class AutoPlayer {
+public:
+    AutoPlayer(const Stats& start, int startCorruption, BotOptions opt = {});
+
+    const BotState& start() const { return start_; }
+
+    // Best chance of ending the run with `target`, playing for it perfectly.
+    double bestChance(Ending target) { return value(target, start_); }
+    double bestChance(Ending target, const BotState& s) { return value(target, s); }
+    // A move that achieves it (first of the best, in wing order).
+    BotMove bestMove(Ending target, const BotState& s);
+
+    // Every way `move` can go from s (fragment pickups included). Branches
+    // that don't end the run come with the wing marked visited.
+    void expand(const BotState& s, const BotMove& move, std::vector<model::Branch>& out,
+                std::vector<BotState>& next) const;
+
+    std::size_t tableSize() const { return used_; }
+    std::size_t nodesExpanded() const { return expanded_; }
+
+private:
+    double value(Ending target, const BotState& s);
+    void moves(const BotState& s, std::vector<BotMove>& out) const;
+    double moveValue(Ending target, const BotState& s, const BotMove& m);
+
+    // transposition table: key+1 (0 = empty) -> value
+    double* lookup(std::uint64_t key);
+    void store(std::uint64_t key, double v);
+
+    BotOptions opt_;
+    BotState start_;
+    std::vector<std::uint64_t> keys_;
+    std::vector<double> values_;
+    std::size_t used_ = 0;
+    std::size_t expanded_ = 0;
+};
+
+#endif // AUTOPLAYER_HPP
@@ -0,0 +1,63 @@
+// BalanceParams.hpp
+// The tuning numbers behind the shrines: the DCs, the Eris score thresholds
+// and the stat rewards that used to sit inline in ShrineBehavior.cpp, its
+// scripts (balance(name)) and ShrineModel. A run reads them through
+// InteractionContext::balance, so a simulation can try other numbers without
+// touching the game's; the game's come from assets/balance.txt.
+//
+// File format, one per line, `#` comments, keys as in BalanceParamDefs():
+//   eris_plead_dc = 8
+// Keys left out keep their defaults.
+#pragma once
+#include <cstddef>
+#include <string>
+
+struct BalanceParams {
+    // False Hermes: the Will DC is base + corruption / step
+    int hermesBaseDc         = 7;
+    int hermesCorruptionStep = 25;
+    int hermesEscapeNerve    = 2;    // walked out
+    int hermesTrapCorruption = 10;   // sealed in
+    // Thanatos
+    int thanatosRefuseWill   = 1;
+    // Hecate
+    int hecatePastWill       = 2;
+    int hecatePresentWill    = 2;    // lost
+    // Pan
+    int panMasteredNerve     = 2;
+    // Eris
+    int erisPleadDc          = 8;    // Will
+    int erisResistDc         = 9;    // Nerve
+    int erisPleadScore       = 4;    // eris_score for the plead bonus
+    int erisPleadBonus       = 2;
+    int erisResistScore      = 5;    // eris_score for advantage on the resist
+    int erisPleadWill        = 2;    // won, and lost
+    int erisResistNerve      = 2;
+    int erisClaimedCorruption= 5;
+};
+
+// One tunable: its file key, where it lives, and the range a search may try.
+struct BalanceParamDef {
+    const char* key;
+    int BalanceParams::*field;
+    int lo, hi;
+};
+
+const BalanceParamDef* BalanceParamDefs();
+std::size_t BalanceParamCount();
+int BalanceParamIndex(const std::string& key);   // -1 if unknown
+
+// Fill `out` from `text` (defaults for anything not named). On failure
+// returns false with "name:line: what" in error and leaves `out` as it was.
+bool ParseBalanceParams(const std::string& text, const std::string& name,
+                        BalanceParams& out, std::string& error);
+bool LoadBalanceParams(const std::string& path, BalanceParams& out, std::string& error);
+// The file form, every key, `header` as leading # lines.
+std::string FormatBalanceParams(const BalanceParams& p, const std::string& header = "");
+
+// The session's numbers: assets/balance.txt, loaded on first call (the
+// defaults if it's missing or broken; the error goes to stderr once).
+const BalanceParams& Balance();
+// Load another file as the session's instead (game --balance). False, with
+// the session's numbers unchanged, if it doesn't parse.
+bool UseBalanceFile(const std::string& path, std::string& error);
@@ -0,0 +1,33 @@
+// CancelToken.hpp
+// Who stops a blocked prompt. One token per session, shared by whoever owns
+// the session (the game, a server connection) and everything that waits on
+// its input. cancel() may come from any thread; input waits poll the token
+// and unwind, and the first reason given is the one that sticks.
+#pragma once
+#include <atomic>
+#include <cstdint>
+
+class CancelToken {
+public:
+    enum class Reason : std::uint8_t { None, EndOfInput, Timeout, Requested };
+
+    void cancel(Reason why = Reason::Requested) noexcept {
+        auto none = static_cast<std::uint8_t>(Reason::None);
+        reason_.compare_exchange_strong(none, static_cast<std::uint8_t>(why));
+    }
+    bool cancelled() const noexcept { return reason() != Reason::None; }
+    Reason reason() const noexcept { return static_cast<Reason>(reason_.load()); }
+    void reset() noexcept { reason_.store(static_cast<std::uint8_t>(Reason::None)); }
+
+private:
+    std::atomic<std::uint8_t> reason_{static_cast<std::uint8_t>(Reason::None)};
+};
+
+inline const char* CancelReasonName(CancelToken::Reason r) {
+    switch (r) {
+        case CancelToken::Reason::EndOfInput: return "end of input";
+        case CancelToken::Reason::Timeout:    return "idle timeout";
+        case CancelToken::Reason::Requested:  return "cancelled";
+        default:                              return "none";
+    }
+}
@@ -0,0 +1,35 @@
+// Dice.hpp
+#ifndef DICE_HPP
+#define DICE_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+// Bulk d10s for batch simulations. Four xoshiro128++ generators run side by
+// side (one SSE2 register per state word), and each 32-bit output becomes one
+// roll by Lemire's multiply-shift. The rare biased outputs (6 in 2^32) are
+// thrown away and that lane draws again, so every face is exactly 1/10.
+// The scalar build produces the same rolls, lane for lane.
+//
+// Not a replacement for RNG: shrine code keeps its mt19937 so seeded
+// transcripts stay put. This is for the simulators.
+class D10Stream {
+public:
+    static constexpr std::size_t kLanes = 4;
+
+    explicit D10Stream(std::uint64_t seed = 1);
+
+    void fill(std::uint8_t* out, std::size_t n);   // n rolls, each 1..10
+    int next();                                    // one roll
+
+private:
+    void draw(std::uint8_t* out, std::size_t blocks);   // blocks * kLanes rolls
+    std::uint32_t stepLane(std::size_t lane);           // scalar xoshiro128++ on one lane
+
+    static constexpr std::size_t kBuffer = 64;
+    alignas(16) std::uint32_t s_[4][kLanes];   // state word w of lane l at s_[w][l]
+    std::uint8_t buf_[kBuffer];
+    std::size_t pos_ = kBuffer;
+};
+
+#endif // DICE_HPP
@@ -0,0 +1,63 @@
+// EndingAnalyzer.hpp
+#ifndef ENDINGANALYZER_HPP
+#define ENDINGANALYZER_HPP
+
+#include "BalanceParams.hpp"
+#include "Mechanics.hpp"   // Stats, WorldView, CheckMods
+#include "Theme.hpp"       // Deity
+#include <array>
+#include <cstddef>
+#include <vector>
+
+// Exact ending odds for a run through the shrines, no sampling.
+// Every shrine in ShrineBehavior is a small tree of menus and d10 checks, so we
+// push a probability distribution over (stats, corruption, scored flags)
+// through the route one shrine at a time and merge identical states as we go.
+// The numbers baked into RunShrine (5 Apollo riddles with 4 options, Pan's
+// 5 rounds of notes 1..5) are mirrored in EndingAnalyzer.cpp; the tunable
+// ones come from BalanceParams like the shrines'.
+
+enum class Ending {
+    None,            // route finished (or Eris plea failed) without an ending
+    EndlessHall,     // False Hermes trap
+    ThanatosSleep,   // lay down and rest
+    JoinedChoir,     // Eris: join the Bone Choir
+    LysaiaTurns,     // Eris: plead, and she listens
+    Overcame,        // Eris: resist and win
+    Claimed,         // Eris: resist and lose
+    Count
+};
+constexpr int kEndingCount = static_cast<int>(Ending::Count);
+const char* endingName(Ending e);
+
+// How the player plays each shrine.
+struct AnalyzerPolicy {
+    std::vector<Deity> route;            // shrines in the order they're visited
+    WorldView view = WorldView::Corrupted;
+
+    int  demeterFragments  = 8;          // Persephone fragments held at Demeter
+    bool demeterKnowsOrder = true;       // false = random order (1 in 8!)
+    bool nyxHasPages       = false;      // journal hooks wired (not yet in Game)
+    int  apolloKnown       = 5;          // riddles answered right for sure; rest guessed
+    int  hecateDoor        = 1;          // 1 past, 2 future, 3 present
+    int  panRecall         = 5;          // longest note run repeated perfectly; longer ones guessed
+    int  thanatosChoice    = 2;          // 1 rest (ending), 2 keep moving
+    int  erisChoice        = 1;          // 1 resist, 2 plead, 3 join
+
+    const BalanceParams* balance = nullptr;   // shrine numbers; null = the session's (Balance())
+};
+
+struct EndingReport {
+    std::array<double, kEndingCount> probability{};
+    // expected change from the starting values, over every way the run can go
+    double health = 0, will = 0, insight = 0, nerve = 0, corruption = 0;
+    double pBroken = 0;                  // ends with health or will at 0
+    std::size_t peakStates = 0;          // largest distribution carried between shrines
+};
+
+// The route every wing in hub order, Eris last.
+std::vector<Deity> DefaultShrineRoute();
+
+EndingReport AnalyzeEndings(const Stats& start, int startCorruption, const AnalyzerPolicy& policy);
+
+#endif // ENDINGANALYZER_HPP
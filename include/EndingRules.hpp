@@ -0,0 +1,77 @@
+// EndingRules.hpp
+#pragma once
+#include "FlagStore.hpp"
+#include "Mechanics.hpp"   // PlayerState
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// ---- Rules as data --------------------------------------------------------------
+// An ending or a score rule is "these flags set, these clear, these stats in
+// range". The tables live in EndingRules.cpp; RuleSet compiles them once into
+// per-word flag masks plus a short list of stat compares, so checking a rule is
+// a few ANDs instead of a string lookup per flag.
+
+enum class StatField : std::uint8_t { Health, Will, Insight, Nerve, Corruption };
+enum class Cmp : std::uint8_t { AtLeast, AtMost };
+
+struct StatCond {
+    StatField stat;
+    Cmp cmp;
+    int value;
+};
+
+struct RuleDef {
+    const char* id;
+    std::vector<const char*> allOf;    // flags that must be set
+    std::vector<const char*> noneOf;   // flags that must be clear
+    std::vector<StatCond> stats;
+    int weight = 0;                    // score rules: added when the rule holds
+    const char* title = "";            // endings: shown on the game-over screen
+};
+
+// Endings, checked in order (first match wins).
+const std::vector<RuleDef>& EndingRuleDefs();
+// What Eris weighs at the end: what the player learned and did.
+const std::vector<RuleDef>& ErisScoreDefs();
+
+// ---- Compiled form --------------------------------------------------------------
+class RuleSet {
+public:
+    explicit RuleSet(const std::vector<RuleDef>& defs);
+
+    std::size_t size() const { return rules_.size(); }
+    const RuleDef& def(std::size_t i) const { return *rules_[i].def; }
+
+    bool holds(std::size_t i, const FlagStore& flags, const PlayerState& ps) const;
+    // Index of the first rule that holds, or -1.
+    int firstHolding(const FlagStore& flags, const PlayerState& ps) const;
+    // Sum of weights of the rules that hold.
+    int score(const FlagStore& flags, const PlayerState& ps) const;
+
+    // Incremental use: only rules that mention `flag` can change when it does.
+    bool watches(FlagId flag) const;
+    const std::vector<std::uint16_t>& rulesWatching(FlagId flag) const;
+    bool hasStatRules() const { return hasStatRules_; }
+
+private:
+    struct MaskTerm {
+        std::uint32_t word;
+        std::uint64_t require, forbid;
+    };
+    struct Rule {
+        const RuleDef* def;
+        std::uint32_t firstTerm, termCount;
+        std::uint32_t firstStat, statCount;
+    };
+
+    std::vector<Rule> rules_;
+    std::vector<MaskTerm> terms_;
+    std::vector<StatCond> stats_;
+    std::vector<std::vector<std::uint16_t>> watchers_;   // by FlagId
+    bool hasStatRules_ = false;
+};
+
+// Compiled once on first use.
+const RuleSet& EndingRules();
+const RuleSet& ErisScoreRules();
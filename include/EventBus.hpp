@@ -0,0 +1,93 @@
+// EventBus.hpp
+#pragma once
+#include "ItemCatalog.hpp"   // ItemId
+#include "Theme.hpp"         // Deity
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+using FlagId = std::uint16_t;   // interned flag name, see FlagStore
+
+// ---- Events -------------------------------------------------------------------
+// Plain values only, so they copy into the queue without allocating.
+struct RoomEntered {
+    int room;            // room index / TempleMap node id
+    bool passingThrough; // true while auto-travelling through it
+};
+
+struct ShrineResolved {
+    Deity deity;
+    int shrineId;
+    int healthDelta, willDelta, insightDelta, nerveDelta, corruptionDelta;
+};
+
+struct ItemGained {
+    ItemId item;
+    int charges;
+};
+
+struct FlagChanged {
+    FlagId flag;
+    bool value;
+};
+
+// ---- Bus ----------------------------------------------------------------------
+// Systems post events as things happen; subscribers get them in post order
+// when the owner flushes (once per command). The queue is a ring allocated
+// once up front, so posting and delivering never allocate. Subscribers may
+// post more events while being flushed; those go out in the same flush.
+class EventBus {
+public:
+    explicit EventBus(std::size_t capacity = 256);
+
+    template <class E> using Handler = std::function<void(const E&)>;
+
+    // Registration is setup-time; handlers run in the order they subscribed.
+    void subscribe(Handler<RoomEntered> fn)    { roomEntered_.push_back(std::move(fn)); }
+    void subscribe(Handler<ShrineResolved> fn) { shrineResolved_.push_back(std::move(fn)); }
+    void subscribe(Handler<ItemGained> fn)     { itemGained_.push_back(std::move(fn)); }
+    void subscribe(Handler<FlagChanged> fn)    { flagChanged_.push_back(std::move(fn)); }
+
+    void post(const RoomEntered& e)    { push(Event(e)); }
+    void post(const ShrineResolved& e) { push(Event(e)); }
+    void post(const ItemGained& e)     { push(Event(e)); }
+    void post(const FlagChanged& e)    { push(Event(e)); }
+
+    // Deliver everything queued. Returns how many events went out.
+    std::size_t flush();
+    void discard() { head_ = count_ = 0; }   // drop queued events (world reset)
+
+    std::size_t pending() const { return count_; }
+    std::size_t dropped() const { return dropped_; }   // lost to a full queue mid-flush
+
+private:
+    enum class Type : std::uint8_t { RoomEntered, ShrineResolved, ItemGained, FlagChanged };
+    struct Event {
+        Type type;
+        union {
+            RoomEntered roomEntered;
+            ShrineResolved shrineResolved;
+            ItemGained itemGained;
+            FlagChanged flagChanged;
+        };
+        Event() : type(Type::RoomEntered), roomEntered{-1, false} {}
+        explicit Event(const RoomEntered& e)    : type(Type::RoomEntered),    roomEntered(e) {}
+        explicit Event(const ShrineResolved& e) : type(Type::ShrineResolved), shrineResolved(e) {}
+        explicit Event(const ItemGained& e)     : type(Type::ItemGained),     itemGained(e) {}
+        explicit Event(const FlagChanged& e)    : type(Type::FlagChanged),    flagChanged(e) {}
+    };
+
+    void push(const Event& e);
+    void deliver(const Event& e) const;
+
+    std::vector<Event> ring_;
+    std::size_t head_ = 0, count_ = 0;
+    std::size_t dropped_ = 0;
+    bool flushing_ = false;
+
+    std::vector<Handler<RoomEntered>>    roomEntered_;
+    std::vector<Handler<ShrineResolved>> shrineResolved_;
+    std::vector<Handler<ItemGained>>     itemGained_;
+    std::vector<Handler<FlagChanged>>    flagChanged_;
+};
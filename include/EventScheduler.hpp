@@ -0,0 +1,132 @@
+// EventScheduler.hpp
+#pragma once
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// ---- Timed events -------------------------------------------------------------
+// Things that happen later rather than because of a command: the temple
+// whispering, corruption seeping in, a journal line the player never wrote,
+// the candle burning down, the prologue's nights. Plain values like the
+// EventBus's; whoever drains the scheduler decides what each one does.
+enum class TimedKind : std::uint8_t {
+    Whisper,          // arg: line index
+    CorruptionCreep,
+    Hallucination,
+    CandleLow,
+    CandleOut,
+    Omen,             // prologue night; arg: line index
+};
+
+struct TimedEvent {
+    TimedKind kind;
+    std::int32_t arg = 0;
+};
+
+// Names one scheduled event until it fires or is cancelled. Stale handles
+// (already fired, cancelled, or from another wheel) are harmless.
+struct TimerHandle {
+    std::uint32_t index = ~0u;
+    std::uint32_t gen = 0;
+    std::uint8_t wheel = 0;
+};
+
+// ---- Timer wheel ----------------------------------------------------------------
+// Hierarchical: 4 levels of 64 slots, each level 64 times coarser than the
+// one below, so 2^24 ticks ahead land in a slot directly and anything further
+// waits in an overflow list. An event sits in the level where its due tick
+// first differs from now and drops a level each time that slot comes round,
+// so scheduling, cancelling and firing are O(1) and advancing past empty
+// slots is a bit scan. Events live in one pool, linked by index; nothing
+// allocates once the pool has grown to the busiest moment.
+//
+// Advancing only moves what's due to a ready queue; next() hands those out
+// in due order (same tick: the order they came due). Handlers may schedule
+// more while draining.
+class TimerWheel {
+public:
+    explicit TimerWheel(std::uint8_t id = 0) : id_(id) { clear(); }
+
+    // Due `delay` ticks from now; 0 is due at once (ready for next()).
+    TimerHandle schedule(std::uint64_t delay, const TimedEvent& e);
+    bool cancel(TimerHandle h);           // false if it already fired or went
+
+    void advance(std::uint64_t ticks);
+    bool next(TimedEvent& out);
+
+    void clear();                         // drop everything, back to tick 0; old handles go stale
+    std::uint64_t now() const { return now_; }
+    std::size_t pending() const { return pending_; }   // scheduled, not yet due
+    std::size_t ready() const { return ready_; }       // due, not yet taken
+
+private:
+    static constexpr int kBits = 6;
+    static constexpr int kSlots = 1 << kBits;
+    static constexpr int kLevels = 4;
+    static constexpr std::uint32_t kNil = ~0u;
+    // list ids: level * kSlots + slot, then these two
+    static constexpr std::uint16_t kOverflow = kLevels * kSlots;
+    static constexpr std::uint16_t kReady = kOverflow + 1;
+    static constexpr std::uint16_t kLists = kReady + 1;
+    static constexpr std::uint16_t kFree = kLists;
+
+    struct Node {
+        std::uint64_t due = 0;
+        TimedEvent event{TimedKind::Whisper};
+        std::uint32_t prev = kNil, next = kNil;
+        std::uint32_t gen = 0;
+        std::uint16_t list = kFree;
+    };
+    struct List { std::uint32_t head = kNil, tail = kNil; };
+
+    void place(std::uint32_t i);          // into the list its due tick says
+    void append(std::uint16_t list, std::uint32_t i);
+    void unlink(std::uint32_t i);
+    void release(std::uint32_t i);
+    void replaceAll(std::uint16_t list);  // re-place a slot that came round
+    void step(std::uint64_t to);          // now_ = to (a slot or block edge), then cascade + expire
+
+    // What an idle tick reads comes first, in one cache line; the slot heads
+    // are only touched when something is due.
+    std::uint64_t now_ = 0;
+    std::size_t pending_ = 0, ready_ = 0;
+    std::array<std::uint64_t, kLevels> occupied_{};   // bit per non-empty slot
+    std::uint32_t free_ = kNil;
+    std::uint8_t id_;
+    std::vector<Node> nodes_;
+    std::array<List, kLists> lists_{};
+};
+
+// ---- Per-session scheduler ------------------------------------------------------
+// One per player session: a wheel counted in turns and one on the
+// monotonic clock in 100 ms ticks. The owner calls turn() each time game
+// time passes, tick(now) whenever it's convenient (the game does it between commands, so
+// nothing prints over a half-typed line), then drains next(). Idle sessions
+// cost a couple of compares per call.
+class SessionScheduler {
+public:
+    using Clock = std::chrono::steady_clock;
+    static constexpr std::chrono::milliseconds kClockTick{100};
+
+    SessionScheduler() : turns_(0), clock_(1) {}
+
+    void start(Clock::time_point now) { clear(); origin_ = now; }
+    void clear() { turns_.clear(); clock_.clear(); }
+
+    TimerHandle inTurns(std::uint64_t turns, const TimedEvent& e) { return turns_.schedule(turns, e); }
+    TimerHandle in(std::chrono::milliseconds delay, const TimedEvent& e);   // rounded up to a tick
+    bool cancel(TimerHandle h) { return h.wheel == 0 ? turns_.cancel(h) : clock_.cancel(h); }
+
+    void turn() { turns_.advance(1); }
+    void tick(Clock::time_point now);
+    bool next(TimedEvent& out) { return turns_.next(out) || clock_.next(out); }
+
+    std::uint64_t turnsTaken() const { return turns_.now(); }
+    std::size_t pending() const { return turns_.pending() + clock_.pending(); }
+
+private:
+    TimerWheel turns_, clock_;
+    Clock::time_point origin_ = Clock::now();
+};
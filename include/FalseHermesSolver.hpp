@@ -0,0 +1,58 @@
+// FalseHermesSolver.hpp
+#ifndef FALSEHERMESSOLVER_HPP
+#define FALSEHERMESSOLVER_HPP
+
+#include "BalanceParams.hpp"
+#include <cstddef>
+#include <vector>
+
+// Exact odds for RunFalseHermesEndlessHall, for every starting (will, corruption).
+// The loop is a Markov chain over (successes, failures, will, corruption):
+// a pass bumps will, a fail adds corruption (and every 2nd fail costs will),
+// and the DC reads corruption, so each start is solved by walking the chain
+// to its ends. All 11 x 101 starts are solved once per set of balance
+// numbers (BalanceParams), on first use.
+
+// One way the loop can end: will/corruption as the loop leaves them,
+// before the Outcome (hermes_trap_corruption if trapped, hermes_escape_nerve
+// otherwise).
+struct HermesFinal {
+    int will;
+    int corruption;
+    bool trapped;
+    double p;
+};
+
+// Expected result of the whole shrine visit, Outcome applied.
+struct HermesOdds {
+    double trap = 0;         // P(Endless Hall)
+    double will = 0;         // expected will afterwards
+    double corruption = 0;   // expected corruption afterwards
+    double nerveDelta = 0;   // expected nerve from the Outcome (before the stat clamp)
+    double checks = 0;       // expected number of rolls
+};
+
+class FalseHermesTable {
+public:
+    static constexpr int kMaxWill = 10;
+    static constexpr int kMaxCorruption = 100;
+
+    static const FalseHermesTable& instance();   // for Balance(), solved on first call
+    // For other numbers (each set solved once, kept for the process; thread-safe).
+    static const FalseHermesTable& forBalance(const BalanceParams& b);
+
+    // Inputs are clamped to the stat ranges the game allows.
+    const HermesOdds& odds(int will, int corruption) const;
+    const HermesFinal* finalsBegin(int will, int corruption) const;
+    const HermesFinal* finalsEnd(int will, int corruption) const;
+
+private:
+    explicit FalseHermesTable(const BalanceParams& b);
+    static int index(int will, int corruption);
+
+    std::vector<HermesOdds> odds_;          // [will * 101 + corruption]
+    std::vector<HermesFinal> finals_;       // all starts, back to back
+    std::vector<std::size_t> finalsAt_;     // start -> first final; one extra at the end
+};
+
+#endif // FALSEHERMESSOLVER_HPP
@@ -0,0 +1,49 @@
+// FlagStore.hpp
+#pragma once
+#include "EventBus.hpp"   // FlagId, FlagChanged
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Story flags ("apollo_majority_right", ...). Names are interned to small ids
+// on first use; values are bits in 64-bit words. `flags["x"] = true` works as
+// it did with the old map, but a change of value also posts FlagChanged, so
+// endings, achievements etc. can listen instead of polling.
+//
+// Interning is process-wide: an id means the same flag in every store, so
+// anything compiled against ids (see EndingRules) works with any of them.
+class FlagStore {
+public:
+    class Ref {
+    public:
+        operator bool() const { return store_->get(id_); }
+        Ref& operator=(bool v) { store_->set(id_, v); return *this; }
+    private:
+        friend class FlagStore;
+        Ref(FlagStore* s, FlagId id) : store_(s), id_(id) {}
+        FlagStore* store_;
+        FlagId id_;
+    };
+
+    explicit FlagStore(EventBus* bus = nullptr) : bus_(bus) {}
+
+    Ref operator[](const std::string& name) { return Ref(this, intern(name)); }
+
+    // The name table is shared by every store and safe to use from any thread.
+    static FlagId intern(const std::string& name);
+    static const std::string& name(FlagId id);
+
+    bool get(FlagId id) const { return (word(id >> 6) >> (id & 63)) & 1u; }
+    void set(FlagId id, bool value);
+
+    // Raw bits, 64 flags per word (ids 64*w .. 64*w+63). Past the end reads 0.
+    std::uint64_t word(std::size_t w) const { return w < bits_.size() ? bits_[w] : 0; }
+
+    // Everything false again, quietly (new run). Interned ids stay valid.
+    void clear();
+
+private:
+    EventBus* bus_;
+    std::vector<std::uint64_t> bits_;
+};
@@ -1,7 +1,17 @@
-
 #pragma once
 #include "Mechanics.hpp"
 #include "PersephoneFragments.hpp"
+#include "ItemPlacement.hpp"
 #include <string>
+#include <vector>
+
+// Where Persephone's fragments lie in Melas' temple, as authored.
+const std::vector<SpawnEntry>& PersephoneFragmentSpawns();
+
+// Picks up everything lying in `room` and takes it off the placement.
+// Returns how many items were picked up.
+int PickUpItemsInRoom(InteractionContext& ctx, ItemPlacement& placement, int room);
 
-void CheckPersephoneLetterPickupsForRoom(InteractionContext& ctx, const std::string& roomTitle);
+// One item, picked up silently (fragments: journal line, +1 Will, once per run).
+// False if it was already taken.
+bool PickUpItem(InteractionContext& ctx, ItemId item);
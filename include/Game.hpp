@@ -9,6 +9,9 @@
 #include "utils.hpp"
 #include "Theme.hpp"   
 #include "JournalManager.hpp"
+#include "Pathfinding.hpp"
+#include <chrono>
+#include <cstdint>
 #include <unordered_set>
 #include <unordered_map>
 #include <vector>
@@ -29,6 +32,12 @@ public:
     // Utilities already used elsewhere
     void describeCurrentRoom();
     void setAccessibility(const AccessibilitySettings& as) { accessibility_ = as; }
+    // Scatter the fragments each descent instead of using the authored layout.
+    // A nonzero seed fixes the first descent's layout (replays, bug reports).
+    void setScatter(bool on, std::uint32_t seed = 0) { scatter_ = on; scatterSeed_ = seed; }
+    // Leave the session after this long with no input at a prompt (0 = wait
+    // forever). End of input always leaves.
+    void setInputTimeout(std::chrono::milliseconds idle);
 
 private:
     // ===== Prologue (Lysaia) =====
@@ -41,20 +50,29 @@ private:
     Player player;
     std::vector<Room> rooms;
 
-    // adjacency: currentRoomIndex -> (neighbor room name -> neighbor index)
-    std::unordered_map<int, std::unordered_map<std::string, int>> roomConnections;
+    // The room graph (exits + title index). Node ids are indices into `rooms`;
+    // movement, travel and the map display all read this one structure.
+    TempleMap templeMap;
+    // shortest-path next hops, rebuilt once per world after wiring
+    NextHopTable paths_;
+    // player map with fog of war, rendered once per world
+    MapView mapView_;
 
     std::unordered_map<int, Shrine> shrineRegistry; // shrineId -> Shrine
-    TempleMap templeMap;
     JournalManager journalManager;
     bool isRunning = false;
 
     // ===== Setup =====
     void loadRooms();          // (if used by main game)
     // --- Title lookup & wiring helpers ---
-int indexByTitle(const std::string& title) const;
+int addRoom(const Room& room);                      // appends to rooms + graph node
+int indexByTitle(const std::string& title) const;   // case-insensitive
+void indexWorld(const char* worldName);   // validate wiring, rebuild path table + map view
+void visitRoom(int id);     // mark visited (Room + map fog)
 void addEdge(int from, const std::string& dirLong, int to);
+void addReturn(int from, const std::string& dirLong, int to);   // one-way shortcut
 void addEdgeByTitle(const std::string& fromTitle, const std::string& dirLong, const std::string& toTitle);
+void addReturnByTitle(const std::string& fromTitle, const std::string& dirLong, const std::string& toTitle);
 void addEdgeBothByTitle(const std::string& fromTitle, const std::string& dirLong,
                         const std::string& toTitle,   const std::string& reverseDirLong);
 
@@ -62,6 +80,7 @@ void addEdgeBothByTitle(const std::string& fromTitle, const std::string& dirLong
     void setupPrologueConnectionsByTitle();
 // Main wiring
     void setupConnections();   // connect rooms in current map
+    void placeAltars();        // data-driven shrine rooms (assets/altars.txt)
 
     // ===== Main game (Melas, etc.) =====
     Phase phase_ = Phase::MainMenu;   // track where we are
@@ -70,12 +89,17 @@ void addEdgeBothByTitle(const std::string& fromTitle, const std::string& dirLong
     void waitForEnter();
     void printTitleBlock();
     void beginMelasRun();
+    void placeItems();          // fragments for this descent (authored or scattered)
     void gameLoop();           // full loop (not used by prologue)
-    void handleCommand(const std::string& input);
+    bool handleCommand(const std::string& input);   // true if game time passed
     void toggleAccessibility();
     void showMap();
+    void travelTo(const std::string& title);   // walk the shortest path, room by room
+    void wireEvents();                          // subscribe room/shrine/flag side effects
     bool firstFramePrinted_ = false;
     int lastEnteredRoom_ = -1;   // <--- NEW: which room we last "entered" for side-effects
+    bool scatter_ = false;
+    std::uint32_t scatterSeed_ = 0;
     // ...
 
 
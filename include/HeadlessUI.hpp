@@ -0,0 +1,41 @@
+// HeadlessUI.hpp
+#pragma once
+#include "Mechanics.hpp"   // RNG
+#include <string>
+
+// Compile-time UI backend for simulations: no std::function, no output.
+// It drops text (kDropsText), so shrines driven against it run quiet and never
+// build a line or a prompt; choices come from Policy, which only sees how
+// many options there are: `int choose(count)` (0 = open-ended) and
+// `std::string ask()`. Instantiate mechanics against it by including
+// ShrineBehaviorImpl.hpp / ShrineRunnerImpl.hpp in the simulation's
+// translation unit.
+template <class Policy>
+struct HeadlessUI {
+    static constexpr bool kDropsText = true;
+    Policy policy;
+
+    void print(const std::string&) {}
+    void waitForKey() {}
+    void flash(const std::string&, int) {}
+    int choose(int count) { return policy.choose(count); }
+    std::string ask(const std::string&) { return policy.ask(); }
+};
+
+// Uniformly random picks. Open-ended menus (no option list, e.g. Demeter's
+// fragment order) pick from 1..openRange. Free-text questions get "".
+struct RandomPolicy {
+    RNG* rng = nullptr;
+    int openRange = 8;
+
+    int choose(int count) { return rng->roll(1, count > 0 ? count : openRange); }
+    std::string ask() { return {}; }
+};
+
+// Always answers the same option (1-based); handy for forcing one branch.
+// Not for open-ended menus: Demeter's fragment order re-asks until every pick is new.
+struct FixedPolicy {
+    int pick = 1;
+    int choose(int) { return pick; }
+    std::string ask() { return {}; }
+};
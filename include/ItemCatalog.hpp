@@ -0,0 +1,57 @@
+// ItemCatalog.hpp
+#pragma once
+#include <array>
+#include <cstdint>
+#include <string>
+
+// Every item the game knows about, fixed at compile time. An ItemId is the
+// item's slot in the catalog, so inventories index arrays by it instead of
+// comparing string ids. String keys ("perse_frag_3") are only for save data
+// and debugging; look them up once with ItemIdFromKey.
+enum class ItemId : std::uint8_t {
+    // Persephone's letter, in its true order. Keep these first and together:
+    // their ids double as bits in the fragment mask.
+    PerseFrag1, PerseFrag2, PerseFrag3, PerseFrag4,
+    PerseFrag5, PerseFrag6, PerseFrag7, PerseFrag8,
+    Count
+};
+constexpr int kItemCount = static_cast<int>(ItemId::Count);
+constexpr int kPersephoneFragmentCount = 8;
+
+struct ItemDef {
+    const char* key;    // stable string id
+    const char* name;   // display name
+    const char* desc;   // flavor / fragment text
+};
+
+const ItemDef& ItemInfo(ItemId id);
+ItemId ItemIdFromKey(const std::string& key);   // ItemId::Count if unknown
+
+// Fragment n (1..8) <-> item id / mask bit
+inline ItemId PersephoneFragmentItem(int index1Based) {
+    return static_cast<ItemId>(static_cast<int>(ItemId::PerseFrag1) + index1Based - 1);
+}
+inline bool IsPersephoneFragment(ItemId id) {
+    return id >= ItemId::PerseFrag1 && id <= ItemId::PerseFrag8;
+}
+
+// Charges per catalog item in a flat array, plus the fragments held as
+// an 8-bit mask. Everything is O(1) and never allocates.
+class Inventory {
+public:
+    bool has(ItemId id) const { return charges_[slot(id)] > 0; }
+    int  charges(ItemId id) const { return charges_[slot(id)]; }
+    void add(ItemId id, int charges = 1);
+    bool consume(ItemId id);   // false if none left
+    void clear() { charges_.fill(0); fragments_ = 0; }
+
+    std::uint8_t fragmentMask() const { return fragments_; }   // bit n-1 = fragment n
+    bool hasAllFragments() const { return fragments_ == 0xFF; }
+
+private:
+    static int slot(ItemId id) { return static_cast<int>(id); }
+    void syncFragment(ItemId id);
+
+    std::array<std::int16_t, kItemCount> charges_{};
+    std::uint8_t fragments_ = 0;
+};
@@ -0,0 +1,53 @@
+// ItemPlacement.hpp
+#pragma once
+#include "ItemCatalog.hpp"
+#include "Map.hpp"
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// One row of a spawn table: `item` lies in the room titled `room`. Tables are
+// written against titles; placing one resolves them to room ids once.
+struct SpawnEntry {
+    const char* room;
+    ItemId item;
+};
+
+// Where a world's items lie, by room id (TempleMap node id). Every spawn is a
+// slot; each room keeps a bitmask of the slots still lying in it, so "is
+// anything here?" on entry is one load and a test, and picking something up
+// clears its bit. Built once per world: the authored layout, or the same
+// items scattered from a seed.
+class ItemPlacement {
+public:
+    static constexpr int kMaxSpawns = 64;   // bits in a room mask
+
+    void clear() { here_.clear(); count_ = 0; }
+
+    // Every row in its own room. Returns the titles the map doesn't know
+    // (those rows are left out).
+    std::vector<std::string> place(const TempleMap& map, const std::vector<SpawnEntry>& table);
+    // The same items, each in a random room other than `hub`, as spread out as
+    // the rooms allow. The same seed gives the same layout.
+    void scatter(const TempleMap& map, const std::vector<SpawnEntry>& table, std::uint32_t seed, int hub);
+
+    bool anythingIn(int room) const { return spawnsIn(room) != 0; }
+    // Slots still lying in `room`, bit s = slot s.
+    std::uint64_t spawnsIn(int room) const {
+        return room >= 0 && room < static_cast<int>(here_.size()) ? here_[static_cast<std::size_t>(room)] : 0;
+    }
+    ItemId item(int spawn) const { return items_[static_cast<std::size_t>(spawn)]; }
+    int roomOf(int spawn) const { return rooms_[static_cast<std::size_t>(spawn)]; }
+    void take(int spawn);   // gone from its room
+    int size() const { return count_; }
+
+private:
+    void reset(int rooms);
+    void add(int room, ItemId item);
+
+    std::vector<std::uint64_t> here_;   // per room id
+    std::array<ItemId, kMaxSpawns> items_{};
+    std::array<std::int16_t, kMaxSpawns> rooms_{};
+    int count_ = 0;
+};
@@ -2,38 +2,112 @@
 #ifndef MAP_HPP
 #define MAP_HPP
 
+#include "Theme.hpp"   // Deity
+#include <array>
+#include <cstdint>
 #include <string>
 #include <vector>
 #include <unordered_map>
 #include <iostream>
 
+// Exit directions, in the order the map and exit lists present them.
+enum class Dir : std::uint8_t {
+    North, NorthEast, East, SouthEast, South, SouthWest, West, NorthWest, Up, Down,
+    Count
+};
+constexpr int kDirCount = static_cast<int>(Dir::Count);
+
+Dir dirFromName(const std::string& name);   // "n"/"north" -> Dir::North, Dir::Count if not a direction
+const char* dirName(Dir d);                 // Dir::North -> "north"
+Dir oppositeDir(Dir d);                     // north <-> south, up <-> down, ...
+
 struct MapNode {
-    int id;                 // stable ID for movement later
+    int id;                 // same as the room index in Game::rooms
     std::string name;       // display name
     bool shrine;            // true if a shrine room
+    Deity deity = Deity::Default;
+    std::string locId;      // journal location id ("" if the room has none)
 };
 
+// The one room graph: movement, pathfinding and the map display all read it.
+// Node ids are room indices; each node has at most one exit per direction.
 class TempleMap {
 public:
-    // create nodes + edges for current design
-    void populateFromDesign();
+    using Exits = std::array<int, kDirCount>;   // -1 = no exit that way
+
+    // An exit that was wired twice to different rooms; the later one won.
+    struct EdgeClash { int from; Dir dir; int was; int now; };
+
+    void clear();
+    int  addNode(const std::string& name, bool shrine, Deity deity = Deity::Default,
+                 const std::string& locId = {});
+    void addEdge(int from, Dir d, int to);
+    // Deliberate shortcut with no way back (e.g. the quick returns to the hub);
+    // the validator doesn't ask for a reverse exit on these.
+    void addOneWay(int from, Dir d, int to);
+    // Title-wired exit. Unknown titles are remembered for the validator.
+    void addEdgeByTitle(const std::string& fromTitle, Dir d, const std::string& toTitle,
+                        bool oneWay = false);
 
-    // text outputs
-    void printAscii() const;                 // compact visual clusters
-    void printAdjacency() const;             // room graph (for debugging/movement)
+    int  exit(int from, Dir d) const;           // -1 if none
+    const Exits& exitsFrom(int id) const { return exits_[id]; }
+    int  indexByTitle(const std::string& title) const;   // case-insensitive, -1 if unknown
+    int  size() const { return static_cast<int>(nodes_.size()); }
+    bool isOneWay(int from, Dir d) const;
+
+    // Wiring mistakes seen since the last clear().
+    const std::vector<EdgeClash>&   clashes() const { return clashes_; }
+    const std::vector<std::string>& unresolvedTitles() const { return unresolved_; }
+
+    void printAdjacency() const;             // room graph (for debugging)
 
-    // data access for future movement
     const std::vector<MapNode>& nodes() const { return nodes_; }
-    const std::vector<std::vector<int>>& edges() const { return edges_; }
-    const std::unordered_map<std::string,int>& nameToId() const { return nameToId_; }
 
 private:
     std::vector<MapNode> nodes_;
-    std::vector<std::vector<int>> edges_;    // adjacency by node index
-    std::unordered_map<std::string,int> nameToId_;
+    std::vector<Exits> exits_;               // indexed by node id
+    std::vector<std::uint16_t> oneWay_;      // per node, bit per Dir
+    std::unordered_map<std::string,int> nameToId_;   // lowercased title -> id
+
+    std::vector<EdgeClash> clashes_;
+    std::vector<std::string> unresolved_;
+};
+
+// Player-facing map of a TempleMap with fog of war.
+// The whole layout is rendered once per world into one buffer; after that a
+// first visit or a change of position only rewrites the cells involved, and
+// showing the map is a single write of the cached text.
+class MapView {
+public:
+    // Attach to a freshly wired world. Forgets visits and the cached text.
+    void reset(const TempleMap& map, int hub = 0);
+    // Colors follow the deity themes; changing either knob re-renders once.
+    void setStyle(const AccessibilitySettings& as, ShrineState state);
+
+    // First visit lifts the fog on that room. Returns false if already visited.
+    bool markVisited(int id);
+    bool isVisited(int id) const;
+
+    // Cached text with `current` highlighted; patches at most two cells.
+    const std::string& render(int current);
+
+private:
+    struct CellSpan { size_t offset = 0; size_t length = 0; bool placed = false; };
+
+    const TempleMap* map_ = nullptr;
+    int hub_ = 0;
+    int current_ = -1;
+    AccessibilitySettings access_{};
+    ShrineState state_ = ShrineState::UNCORRUPTED;
+
+    std::vector<bool> visited_;       // indexed by room id
+    std::vector<CellSpan> cells_;     // where each room's cell sits in text_
+    std::string text_;
+    bool built_ = false;
 
-    int addNode(const std::string& name, bool shrine);
-    void addEdgeByName(const std::string& a, const std::string& b);
+    std::string cellText(int id) const;
+    void build();
+    void patchCell(int id);
 };
 
 #endif
@@ -1,7 +1,10 @@
 // Mechanics.hpp
 #pragma once
 #include "Theme.hpp"          // Deity, ShrineState
+#include "ItemCatalog.hpp"    // ItemId, Inventory
+#include "FlagStore.hpp"      // story flags
 #include <algorithm>
+#include <cstddef>
 #include <string>
 #include <vector>
 #include <functional>
@@ -10,6 +13,9 @@
 #include <unordered_map>
 #include <optional>
 
+class D10Stream;   // Dice.hpp
+struct BalanceParams;   // BalanceParams.hpp
+
 // Lysaia vs. Melas
 enum class WorldView { Uncorrupted, Corrupted };
 
@@ -18,6 +24,8 @@ struct Accessibility {
     bool colorDisabled = false;
     bool disableShake  = false;
     bool highContrast  = false;
+    bool showOdds      = false;   // print the chance of each skill check before it's rolled
+    int  panFlashMs    = 0;       // timed Pan: notes flash this long, answers race a clock (0 = off)
 };
 
 struct Stats {
@@ -34,13 +42,6 @@ struct Stats {
 }
 };
 
-struct InventoryItem {
-    std::string id;
-    std::string name;
-    std::string desc;
-    int charges = 1;
-};
-
 struct CheckMods {
     int  flat = 0;
     bool advantage = false;
@@ -54,8 +55,9 @@ struct Outcome {
     int insightDelta= 0;
     int nerveDelta  = 0;
     int corruptionDelta = 0;
-    std::vector<InventoryItem> itemsGained;
+    std::vector<ItemId>       itemsGained;
     std::vector<std::string>  flagsSet;
+    bool cancelled = false;   // input went away mid-shrine: apply none of this
 };
 
 class RNG {
@@ -65,6 +67,7 @@ public:
             std::chrono::high_resolution_clock::now().time_since_epoch().count());
         eng.seed(seed);
     }
+    explicit RNG(unsigned seed) { eng.seed(seed); }   // reproducible runs (tools, simulations)
     int roll(int minInclusive, int maxInclusive) {
         std::uniform_int_distribution<int> dist(minInclusive, maxInclusive);
         return dist(eng);
@@ -79,13 +82,13 @@ class PlayerState {
 public:
     Stats stats;
     int corruption = 0;
-    std::vector<InventoryItem> bag;
+    Inventory inventory;
     Accessibility access;
     WorldView view = WorldView::Uncorrupted;   // <-- fixed (had no member name)
 
-    bool hasItem(const std::string& id) const;
-    bool consumeItem(const std::string& id);
-    void addItem(const InventoryItem& it);
+    bool hasItem(ItemId id) const { return inventory.has(id); }
+    bool consumeItem(ItemId id)   { return inventory.consume(id); }
+    void addItem(ItemId id, int charges = 1) { inventory.add(id, charges); }
     void applyOutcome(const Outcome& out);
     bool isAlive() const { return stats.health > 0 && stats.will > 0; }
 };
@@ -94,6 +97,20 @@ class SkillCheck {
 public:
     // 1d10 + stat + mods vs DC (ties succeed)
     static bool resolve(RNG& rng, int dc, int statScore, const CheckMods& mods, int* outRoll = nullptr);
+
+    // Exact chance that resolve() succeeds, from the same d10 / best-of-two /
+    // worst-of-two rolls pickRoll uses. No dice involved.
+    static double successProbability(int dc, int statScore, const CheckMods& mods);
+    // Same for n checks at once (SSE2 when available, 4 per step). Results are
+    // floats; every chance is a multiple of 1/100 so nothing meaningful is lost.
+    static void successProbability(const int* dc, const int* statScore, const CheckMods* mods,
+                                   float* out, std::size_t n);
+
+    // n checks at once on bulk dice. Every check takes two d10s from `dice`
+    // (the second only counts with advantage/disadvantage), so lanes never
+    // branch. passed[i] = 1 on success; outRoll, if given, gets the die used.
+    static void resolveBatch(D10Stream& dice, const int* dc, const int* statScore, const CheckMods* mods,
+                             std::uint8_t* passed, std::size_t n, int* outRoll = nullptr);
 };
 
 // Journal bridge
@@ -111,7 +128,8 @@ struct InteractionContext {
     IJournalSink& journal;
     WorldView view;                 // playthrough
     ShrineState shrineState;        // this room/shrine’s state
-    std::unordered_map<std::string, bool>& flags;
+    FlagStore& flags;
+    const BalanceParams* balance = nullptr;   // tuning numbers; null = the session's (Balance())
 };
 
 // NOTE: Do NOT define Room or Shrine here.
@@ -0,0 +1,28 @@
+// Pathfinding.hpp
+#ifndef PATHFINDING_HPP
+#define PATHFINDING_HPP
+
+#include "Map.hpp"
+#include <vector>
+
+// All-pairs next-hop table over the room graph.
+// Rooms are unweighted, so we run one BFS per room (V * (V+E)) once per world;
+// after that every step of a route is a single table lookup.
+class NextHopTable {
+public:
+    void build(const TempleMap& map);
+    void clear();
+
+    // next room to step into when walking from -> to; -1 if unreachable (or from == to)
+    int next(int from, int to) const;
+    // number of steps on the shortest path; -1 if unreachable
+    int distance(int from, int to) const;
+
+    int size() const { return n_; }
+
+private:
+    int n_ = 0;
+    std::vector<int> next_;   // row-major: next_[from * n_ + to]
+};
+
+#endif // PATHFINDING_HPP
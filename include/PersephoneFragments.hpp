@@ -5,12 +5,13 @@
 #include <string>
 #include <utility>
 
-// Create the 8 corrupted fragments as InventoryItems.
-// id format: "perse_frag_<index>"
-std::vector<InventoryItem> MakePersephoneFragments();
+// The 8 corrupted fragments are catalog items (ItemId::PerseFrag1..8, text in
+// ItemCatalog.cpp); the player's set is Inventory::fragmentMask().
 
 // Inventory helpers
 bool HasAllPersephoneFragments(const PlayerState& ps);
+int  CountPersephoneFragments(const PlayerState& ps);
+// (true index 1..8, text) for each fragment held, in true order
 std::vector<std::pair<int,std::string>> GetOwnedPersephoneFragments(const PlayerState& ps);
 
 // Room pickup utility: call once when player enters the room that holds this fragment.
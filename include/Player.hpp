@@ -2,6 +2,7 @@
 #define PLAYER_HPP
 
 #include "JournalManager.hpp"
+#include "Map.hpp"
 #include <vector>
 #include <string>
 #include <iostream>
@@ -21,8 +22,8 @@ public:
     int getSanity() const;
     void loseSanity(int amount);
 
-    void move(const std::string& direction,
-              const std::unordered_map<int, std::unordered_map<std::string, int>>& roomConnections);
+    // Returns true if there was an exit that way (prints "No exit that way." otherwise).
+    bool move(const std::string& direction, const TempleMap& map);
 
     // Journal controls
     void writeToJournal(const std::string& entry);
@@ -0,0 +1,63 @@
+// PlayerBatch.hpp
+#ifndef PLAYERBATCH_HPP
+#define PLAYERBATCH_HPP
+
+#include "Mechanics.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Many simulated players at once, one array per field (structure of arrays).
+// Stats are int16 so eight lanes fit one SSE2 register; items are a bitmask,
+// one bit per ItemId held. Simulations don't stack charges: a lane holds an
+// item or it doesn't.
+//
+// Shrine code still runs one player at a time: load() a lane into a scratch
+// PlayerState, run the coroutine, stage its Outcome in an OutcomeBatch, and
+// when every lane has played, apply() them all in one vector pass.
+
+using ItemMask = std::uint64_t;
+static_assert(kItemCount <= 64, "ItemMask needs a bit per item");
+inline ItemMask ItemBit(ItemId id) { return ItemMask{1} << static_cast<int>(id); }
+
+// Arrays are padded to a multiple of kBatchLanes (padding stays zero).
+constexpr std::size_t kBatchLanes = 8;
+
+// What each lane's shrine did, staged until PlayerBatch::apply().
+struct OutcomeBatch {
+    std::vector<std::int16_t> health, will, insight, nerve, corruption;
+    std::vector<ItemMask> items;
+
+    explicit OutcomeBatch(std::size_t n = 0) { resize(n); }
+    void resize(std::size_t n);
+    void clear();                                   // all deltas back to zero
+    void set(std::size_t i, const Outcome& out);    // numeric part + items gained
+    std::size_t size() const { return size_; }
+
+private:
+    std::size_t size_ = 0;
+};
+
+struct PlayerBatch {
+    std::vector<std::int16_t> health, will, insight, nerve, corruption;
+    std::vector<ItemMask> items;
+
+    explicit PlayerBatch(std::size_t n = 0, const Stats& start = {}, int startCorruption = 0);
+    void resize(std::size_t n, const Stats& start = {}, int startCorruption = 0);
+    std::size_t size() const { return size_; }
+
+    // Lane <-> scalar player. load() fills stats, corruption and inventory
+    // (one charge per item) and leaves view/accessibility alone.
+    void load(std::size_t i, PlayerState& ps) const;
+    void store(std::size_t i, const PlayerState& ps);
+
+    // PlayerState::applyOutcome for every lane: add, clamp stats to 0..10 and
+    // corruption to 0..100, take the items.
+    void apply(const OutcomeBatch& d);
+    void clamp();
+
+private:
+    std::size_t size_ = 0;
+};
+
+#endif // PLAYERBATCH_HPP
@@ -0,0 +1,60 @@
+// RiddleBank.hpp
+// Apollo's riddles as content. The bank reads a riddle file once and keeps
+// the whole text in one string; every Riddle's prompt and options are views
+// into it. A RiddleBag deals riddles out of a bank for one session, so none
+// comes round again until the whole bank has been asked.
+//
+// File format (assets/riddles.txt), one riddle per line, `#` comments:
+//   difficulty | prompt | option | option | ...
+// difficulty 1..3, two to kRiddleMaxOptions options, the answer marked '*'.
+#pragma once
+#include "ShrineBehavior.hpp"   // Riddle, RiddleSet
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+class RiddleBank {
+public:
+    RiddleBank() = default;
+    // Riddles point into text_, so a bank stays where it was built.
+    RiddleBank(const RiddleBank&) = delete;
+    RiddleBank& operator=(const RiddleBank&) = delete;
+
+    // Replace the contents. On failure returns false with "name:line: what"
+    // in error and leaves the bank empty.
+    bool parse(std::string text, const std::string& name, std::string& error);
+    bool load(const std::string& path, std::string& error);
+
+    std::size_t size() const { return riddles_.size(); }
+    bool empty() const { return riddles_.empty(); }
+    const Riddle& operator[](std::size_t i) const { return riddles_[i]; }
+    int count(int difficulty) const;   // how many riddles carry this tag
+
+private:
+    std::string text_;
+    std::vector<Riddle> riddles_;
+};
+
+// assets/riddles.txt, loaded on first call. Empty if the file is missing or
+// broken (the error goes to stderr once); Apollo then asks his usual five.
+const RiddleBank& DefaultRiddleBank();
+
+// Shuffle-bag over a bank: a shuffled order dealt front to back, reshuffled
+// when it runs out. Holds the bank by reference. draw() allocates nothing.
+class RiddleBag {
+public:
+    explicit RiddleBag(const RiddleBank& bank, std::uint32_t seed = std::random_device{}());
+
+    // n different riddles (capped by the bank and RiddleSet::kMax), easiest
+    // first. Empty if the bank is.
+    RiddleSet draw(int n);
+    // Riddles not yet dealt in the current pass.
+    std::size_t left() const { return order_.size() - next_; }
+
+private:
+    const RiddleBank& bank_;
+    std::mt19937 rng_;
+    std::vector<std::uint16_t> order_;
+    std::size_t next_ = 0;
+};
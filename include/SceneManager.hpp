@@ -1,10 +1,16 @@
 #ifndef SCENEMANAGER_HPP
 #define SCENEMANAGER_HPP
 
+#include "CancelToken.hpp"
+#include <chrono>
+
+// The ENTER waits give up like any other prompt (see readLineOrCancel).
 class SceneManager {
 public:
-    static void introScene();
+    static void introScene(CancelToken& input, std::chrono::milliseconds idle = {});
     static void erisFinalScene();
+    static void endingScene(const char* title, CancelToken& input,
+                            std::chrono::milliseconds idle = {});   // game over; waits for ENTER
 };
 
 #endif
@@ -0,0 +1,34 @@
+// ScriptedUI.hpp
+#pragma once
+#include <deque>
+#include <string>
+#include <vector>
+
+// UI backend for driving shrines without a terminal (tests, tools, replays).
+// Answers are queued up front and consumed in order by choose()/ask();
+// everything the shrine says, and every prompt it shows, goes to the transcript.
+class ScriptedUI {
+public:
+    ScriptedUI& answer(int choice);                // next choose() returns this
+    ScriptedUI& answer(const std::string& text);   // next ask() returns this (choose() reads it as a number)
+
+    void print(const std::string& s);
+    int  choose(const std::string& prompt, const std::vector<std::string>& options);
+    std::string ask(const std::string& prompt);
+    void waitForKey() {}
+    void flash(const std::string& s, int /*ms*/) { print(s); }   // no clock: it just stays
+
+    const std::vector<std::string>& transcript() const { return transcript_; }
+    bool saw(const std::string& needle) const;     // any transcript line contains it
+    size_t pending() const { return answers_.size(); }
+    // Prompts hit after the script ran dry. choose() then counts up 1, 2, 3...
+    // so loops that reject a bad pick still finish; ask() returns "".
+    int unanswered() const { return misses_; }
+
+    void clear();
+
+private:
+    std::deque<std::string> answers_;
+    std::vector<std::string> transcript_;
+    int misses_ = 0;
+};
@@ -7,12 +7,14 @@
 #include "Player.hpp"
 #include "Room.hpp"
 #include "Theme.hpp"   // for ShrineState
+#include "ShrineRegistry.hpp"   // ShrineHandlerId
 
 class Shrine {
 private:
     std::string deityName;
     std::string shrineRoomName;
     ShrineState state = ShrineState::UNCORRUPTED;
+    ShrineHandlerId handler_ = kQuietShrine;   // the deity's mechanic, looked up once
     std::vector<Room> associatedRooms;
 
 public:
@@ -23,6 +25,7 @@ Shrine() = default;
     const std::string& getName() const noexcept;   // deity name (for UI coloring, etc.)
     std::string getDeityName() const;              // same as getName(), kept for compatibility
     std::string getShrineRoomName() const;
+    ShrineHandlerId handler() const noexcept { return handler_; }   // slot in Shrines()
 
     ShrineState getState() const;
     void setState(ShrineState newState);
@@ -2,9 +2,14 @@
 #pragma once
 #include "Mechanics.hpp"
 #include "UI.hpp"
+#include "ScriptedUI.hpp"
+#include "ShrineCoroutine.hpp"
+#include <array>
+#include <memory>
 #include <optional>
 #include <functional>
 #include <string>
+#include <string_view>
 #include <vector>
 
 // -- type aliases expected by ShrineBehavior.cpp
@@ -12,34 +17,119 @@ using TakeMelasEntryFn = std::function<std::optional<std::string>()>;
 using GiveMelasEntryFn = std::function<void(const std::string&)>;
 
 // -- Riddle shape expected by ShrineBehavior.cpp
+// The text is borrowed: prompt and options view storage that outlives every
+// shrine run (a RiddleBank's text, or string literals), so riddles are passed
+// around without copying a string.
+constexpr int kRiddleMaxOptions = 6;
 struct Riddle {
-    std::string prompt;
-    std::vector<std::string> options;
+    std::string_view prompt;
+    std::array<std::string_view, kRiddleMaxOptions> options{};
+    int optionCount = 0;
     int correctIndex1Based = 1;
+    int difficulty = 1;   // 1 easy .. 3 hard
 
     // compatibility aliases (if other code used different names)
-    std::string& question() { return prompt; }
-    const std::string& question() const { return prompt; }
+    std::string_view question() const { return prompt; }
     int correctIndex() const { return correctIndex1Based; }
 };
 
+// The riddles one Apollo visit asks, in order: pointers to Riddles that live
+// for the session (RiddleBank.hpp), never copies.
+struct RiddleSet {
+    static constexpr int kMax = 8;
+    std::array<const Riddle*, kMax> at{};
+    int count = 0;
+
+    void push(const Riddle& r) { if (count < kMax) at[count++] = &r; }
+    int size() const { return count; }
+    const Riddle& operator[](int i) const { return *at[i]; }
+    const Riddle* const* begin() const { return at.data(); }
+    const Riddle* const* end() const { return at.data() + count; }
+};
+
+// Timed Pan: each round's notes are flashed for showMs and wiped, and a
+// repeat only counts if it comes back within answerMs + perNoteMs per note.
+// showMs == 0 is the untimed game (notes stay up until Enter).
+struct PanTiming {
+    int showMs    = 0;
+    int answerMs  = 2500;
+    int perNoteMs = 700;
+};
+
+// Pan as the temple plays it: round r repeats r notes drawn from
+// 1..noteRange. StartPan and pan.shrine (pan_rounds() and friends) both read
+// this, so the script can't drift from the C++.
+struct PanRules {
+    int rounds    = 5;
+    int noteRange = 5;
+    PanTiming timing;
+};
+PanRules PanRulesFor(const PlayerState& player);   // timing.showMs = access.panFlashMs
+
+// Every mechanic is a ShrineCoroutine (ShrineCoroutine.hpp). Start* builds one
+// parked at its first line; step()/resume() it from whatever loop owns the
+// player. Nothing runs until the first step().
+std::unique_ptr<ShrineCoroutine> StartDemeterLetter_FromInventory(InteractionContext& ctx);
+std::unique_ptr<ShrineCoroutine> StartDemeterLetter_Uncorrupted(InteractionContext& ctx,
+                                                                 const std::vector<std::string>& choices);
+std::unique_ptr<ShrineCoroutine> StartNyxTrade(InteractionContext& ctx, TakeMelasEntryFn take = {},
+                                               GiveMelasEntryFn give = {});
+std::unique_ptr<ShrineCoroutine> StartApolloRiddles(InteractionContext& ctx, const RiddleSet& set);
+std::unique_ptr<ShrineCoroutine> StartHecateDoors(InteractionContext& ctx, GiveMelasEntryFn give = {});
+std::unique_ptr<ShrineCoroutine> StartPanMemory(InteractionContext& ctx, int rounds, int noteRange,
+                                                PanTiming timing = {});
+std::unique_ptr<ShrineCoroutine> StartFalseHermesEndlessHall(InteractionContext& ctx);
+std::unique_ptr<ShrineCoroutine> StartThanatosRest(InteractionContext& ctx);
+std::unique_ptr<ShrineCoroutine> StartErisFinal(InteractionContext& ctx);
+
+// Blocking forms: run the coroutine to the end against a UI backend.
+// Each is a template over that backend. A backend only needs:
+//   void print(const std::string&);
+//   int  choose(const std::string& prompt, const std::vector<std::string>& options);  // 1-based
+//        (or int choose(int count) with kDropsText, see ShrineCoroutine.hpp)
+//   std::string ask(const std::string& prompt);
+//   void waitForKey();
+//   void flash(const std::string& text, int ms);   // show, wait ms, wipe
+// The interactive UI (UI.hpp) and ScriptedUI are instantiated in
+// ShrineBehavior.cpp; for anything else (HeadlessUI<...>) include
+// ShrineBehaviorImpl.hpp.
+
 // Demeter
-Outcome RunDemeterLetter_FromInventory(InteractionContext& ctx, UI& ui);
-Outcome ShowDemeterLetter_Uncorrupted(InteractionContext& ctx, UI& ui);
-Outcome ShowDemeterLetter_Uncorrupted(InteractionContext& ctx, UI& ui,
-                                      const std::vector<std::string>& choices);
+template <class UIT> Outcome RunDemeterLetter_FromInventory(InteractionContext& ctx, UIT& ui);
+template <class UIT> Outcome ShowDemeterLetter_Uncorrupted(InteractionContext& ctx, UIT& ui);
+template <class UIT> Outcome ShowDemeterLetter_Uncorrupted(InteractionContext& ctx, UIT& ui,
+                                                           const std::vector<std::string>& choices);
 // Nyx
-Outcome RunNyxTrade(InteractionContext& ctx, UI& ui,
-                    TakeMelasEntryFn take = {},
-                    GiveMelasEntryFn give = {});
+template <class UIT> Outcome RunNyxTrade(InteractionContext& ctx, UIT& ui,
+                                         TakeMelasEntryFn take = {},
+                                         GiveMelasEntryFn give = {});
 
 // Apollo
-Outcome RunApolloRiddles(InteractionContext& ctx, UI& ui,
-                         const std::vector<Riddle>& set);
+template <class UIT> Outcome RunApolloRiddles(InteractionContext& ctx, UIT& ui,
+                                              const RiddleSet& set);
 
 // Hecate / Pan / False Hermes / Thanatos / Eris…
-Outcome RunHecateDoors(InteractionContext& ctx, UI& ui, GiveMelasEntryFn give = {});
-Outcome RunPanMemory(InteractionContext& ctx, UI& ui, int rounds, int noteRange);
-Outcome RunFalseHermesEndlessHall(InteractionContext& ctx, UI& ui);
-Outcome RunThanatosRest(InteractionContext& ctx, UI& ui);
-Outcome RunErisFinal(InteractionContext& ctx, UI& ui);
+template <class UIT> Outcome RunHecateDoors(InteractionContext& ctx, UIT& ui, GiveMelasEntryFn give = {});
+template <class UIT> Outcome RunPanMemory(InteractionContext& ctx, UIT& ui, int rounds, int noteRange,
+                                          PanTiming timing = {});
+template <class UIT> Outcome RunFalseHermesEndlessHall(InteractionContext& ctx, UIT& ui);
+template <class UIT> Outcome RunThanatosRest(InteractionContext& ctx, UIT& ui);
+template <class UIT> Outcome RunErisFinal(InteractionContext& ctx, UIT& ui);
+
+// Explicit instantiation list, shared by the extern declarations below and
+// the definitions in ShrineBehavior.cpp.
+#define SHRINE_BEHAVIOR_INSTANTIATE(EXTERN, UIT)                                                       \
+    EXTERN template Outcome RunDemeterLetter_FromInventory<UIT>(InteractionContext&, UIT&);             \
+    EXTERN template Outcome ShowDemeterLetter_Uncorrupted<UIT>(InteractionContext&, UIT&);              \
+    EXTERN template Outcome ShowDemeterLetter_Uncorrupted<UIT>(InteractionContext&, UIT&,               \
+                                                               const std::vector<std::string>&);        \
+    EXTERN template Outcome RunNyxTrade<UIT>(InteractionContext&, UIT&, TakeMelasEntryFn, GiveMelasEntryFn); \
+    EXTERN template Outcome RunApolloRiddles<UIT>(InteractionContext&, UIT&, const RiddleSet&);             \
+    EXTERN template Outcome RunHecateDoors<UIT>(InteractionContext&, UIT&, GiveMelasEntryFn);           \
+    EXTERN template Outcome RunPanMemory<UIT>(InteractionContext&, UIT&, int, int, PanTiming);          \
+    EXTERN template Outcome RunFalseHermesEndlessHall<UIT>(InteractionContext&, UIT&);                  \
+    EXTERN template Outcome RunThanatosRest<UIT>(InteractionContext&, UIT&);                            \
+    EXTERN template Outcome RunErisFinal<UIT>(InteractionContext&, UIT&);
+
+SHRINE_BEHAVIOR_INSTANTIATE(extern, UI)
+SHRINE_BEHAVIOR_INSTANTIATE(extern, ScriptedUI)
@@ -0,0 +1,72 @@
+// ShrineBehaviorImpl.hpp
+// Blocking Run* forms of the shrine coroutines declared in ShrineBehavior.hpp.
+// Only include this to instantiate them for a new UI backend.
+#pragma once
+#include "ShrineBehavior.hpp"
+#include "PersephoneFragments.hpp"   // kPersephoneLetterClean
+#include <string>
+#include <vector>
+
+// --------------------- DEMETER -----------------------------------------------
+template <class UIT>
+Outcome RunDemeterLetter_FromInventory(InteractionContext& ctx, UIT& ui) {
+    return DriveShrine(*StartDemeterLetter_FromInventory(ctx), ui);
+}
+
+// Show the uncorrupted Demeter letter using a provided set of lines.
+template <class UIT>
+Outcome ShowDemeterLetter_Uncorrupted(InteractionContext& ctx,
+                                      UIT& ui,
+                                      const std::vector<std::string>& choices)
+{
+    return DriveShrine(*StartDemeterLetter_Uncorrupted(ctx, choices), ui);
+}
+
+template <class UIT>
+Outcome ShowDemeterLetter_Uncorrupted(InteractionContext& ctx, UIT& ui) {
+    return ShowDemeterLetter_Uncorrupted(ctx, ui, kPersephoneLetterClean);
+}
+
+// --------------------- NYX ----------------------------------------------------
+template <class UIT>
+Outcome RunNyxTrade(InteractionContext& ctx, UIT& ui,
+                    TakeMelasEntryFn takeOne, GiveMelasEntryFn giveOne)
+{
+    return DriveShrine(*StartNyxTrade(ctx, std::move(takeOne), std::move(giveOne)), ui);
+}
+
+// --------------------- APOLLO -------------------------------------------------
+template <class UIT>
+Outcome RunApolloRiddles(InteractionContext& ctx, UIT& ui, const RiddleSet& set) {
+    return DriveShrine(*StartApolloRiddles(ctx, set), ui);
+}
+
+// --------------------- FALSE HERMES ------------------------------------------
+template <class UIT>
+Outcome RunFalseHermesEndlessHall(InteractionContext& ctx, UIT& ui) {
+    return DriveShrine(*StartFalseHermesEndlessHall(ctx), ui);
+}
+
+// --------------------- THANATOS ----------------------------------------------
+template <class UIT>
+Outcome RunThanatosRest(InteractionContext& ctx, UIT& ui) {
+    return DriveShrine(*StartThanatosRest(ctx), ui);
+}
+
+// --------------------- PAN ----------------------------------------------------
+template <class UIT>
+Outcome RunPanMemory(InteractionContext& ctx, UIT& ui, int rounds, int noteRange, PanTiming timing) {
+    return DriveShrine(*StartPanMemory(ctx, rounds, noteRange, timing), ui);
+}
+
+// --------------------- HECATE -------------------------------------------------
+template <class UIT>
+Outcome RunHecateDoors(InteractionContext& ctx, UIT& ui, GiveMelasEntryFn giveOne) {
+    return DriveShrine(*StartHecateDoors(ctx, std::move(giveOne)), ui);
+}
+
+// --------------------- ERIS ---------------------------------------------------
+template <class UIT>
+Outcome RunErisFinal(InteractionContext& ctx, UIT& ui) {
+    return DriveShrine(*StartErisFinal(ctx), ui);
+}
@@ -0,0 +1,180 @@
+// ShrineCoroutine.hpp
+// Shrine mechanics as resumable state machines. A coroutine runs until it
+// needs an answer, parks itself (a few bytes of members, no thread, no stack)
+// and carries on when resume() hands it the reply. One worker can keep any
+// number of players parked mid-riddle this way; DriveShrine() below is the
+// blocking loop the terminal game and the tools use.
+#pragma once
+#include "Mechanics.hpp"
+#include "BalanceParams.hpp"
+#include <chrono>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// What a parked shrine is waiting for. A quiet shrine (see setQuiet) leaves
+// text and options empty; count is filled in either way.
+struct ShrinePrompt {
+    enum class Kind : std::uint8_t { Choose, Ask, WaitKey, Flash };
+    Kind kind = Kind::WaitKey;
+    std::string text;
+    std::vector<std::string> options;   // Choose only
+    int count = 0;                      // Choose: how many options; 0 = open-ended pick
+    int ms = 0;                         // Flash: show text this long, then wipe it
+};
+
+struct ShrineReply {
+    int choice = 0;     // Choose
+    std::string text;   // Ask
+    // Ask: prompt up -> answer in, on the monotonic clock. Whoever drives the
+    // coroutine fills it in; DriveShrine times the ui.ask() call.
+    std::chrono::steady_clock::duration elapsed{};
+};
+
+class ShrineCoroutine {
+public:
+    explicit ShrineCoroutine(InteractionContext& ctx) : ctx_(ctx) {}
+    virtual ~ShrineCoroutine() = default;
+    ShrineCoroutine(const ShrineCoroutine&) = delete;
+    ShrineCoroutine& operator=(const ShrineCoroutine&) = delete;
+
+    // Run until the next prompt (false) or the end (true). The first call
+    // starts the shrine; later ones come through resume().
+    bool step() { if (!done_) done_ = run(); return done_; }
+    bool resume(const ShrineReply& reply) { reply_ = reply; return step(); }
+
+    bool done() const { return done_; }
+    const ShrinePrompt& prompt() const { return prompt_; }
+    const Outcome& outcome() const { return out_; }
+
+    // Lines printed since the last drain, oldest first.
+    std::vector<std::string> drainOutput() { return std::exchange(output_, {}); }
+
+    // Quiet: nobody reads the text (HeadlessUI), so lines and prompts aren't
+    // built at all. Set before the first step().
+    void setQuiet(bool quiet) { quiet_ = quiet; }
+
+protected:
+    // The body, written between SHRINE_CO_BEGIN / SHRINE_CO_END. Anything that
+    // has to survive a SHRINE_CO_AWAIT must be a member, not a local.
+    virtual bool run() = 0;
+
+    // One line, pieced together from text and numbers: print("(", n, "/5)").
+    // Nothing is built while quiet, so callers needn't check.
+    template <class... Parts>
+    void print(const Parts&... parts) {
+        if (quiet_) return;
+        std::string& line = output_.emplace_back();
+        (appendPart(line, parts), ...);
+    }
+    void blank(int lines) { if (!quiet_) output_.emplace_back(static_cast<std::size_t>(lines > 0 ? lines : 0), '\n'); }
+    bool quiet() const { return quiet_; }
+    // Accessibility: state a check's chance before rolling it, if asked to.
+    void showOdds(std::string_view what, int dc, int statScore, const CheckMods& mods);
+    const BalanceParams& balance() const { return ctx_.balance ? *ctx_.balance : Balance(); }
+
+    // Park on a prompt: these fill prompt_ in place, reusing its buffers.
+    template <class It>
+    void choose(std::string_view text, It first, It last) {
+        setPrompt(ShrinePrompt::Kind::Choose, text);
+        prompt_.count = static_cast<int>(std::distance(first, last));
+        if (!quiet_) for (; first != last; ++first) prompt_.options.emplace_back(textOf(*first));
+    }
+    void choose(std::string_view text, std::initializer_list<std::string_view> options = {}) {
+        choose(text, options.begin(), options.end());
+    }
+    void choose(std::string_view text, const std::vector<std::string>& options) {
+        choose(text, options.begin(), options.end());
+    }
+    void ask(std::string_view text) { setPrompt(ShrinePrompt::Kind::Ask, text); }
+    void waitForKey() { setPrompt(ShrinePrompt::Kind::WaitKey, {}); }
+    void flash(std::string_view text, int ms) { setPrompt(ShrinePrompt::Kind::Flash, text); prompt_.ms = ms; }
+
+    InteractionContext& ctx_;
+    Outcome out_;
+    ShrinePrompt prompt_;
+    ShrineReply reply_;   // answer to the last prompt, valid right after an await
+    int pc_ = 0;          // resume point (a source line, see the macros)
+
+private:
+    void setPrompt(ShrinePrompt::Kind kind, std::string_view text) {
+        prompt_.kind = kind;
+        prompt_.options.clear();
+        prompt_.count = prompt_.ms = 0;
+        if (quiet_) prompt_.text.clear(); else prompt_.text.assign(text);
+    }
+    template <class Part>
+    static void appendPart(std::string& line, const Part& part) {
+        if constexpr (std::is_arithmetic_v<Part>) line += std::to_string(part);
+        else line += textOf(part);
+    }
+    static std::string_view textOf(const char* s) { return s ? s : ""; }
+    static std::string_view textOf(std::string_view s) { return s; }
+
+    std::vector<std::string> output_;
+    bool quiet_ = false;
+    bool done_ = false;
+};
+
+// Duff's-device style resume points: each await records its line in pc_ and
+// returns; the next run() switches straight back to it.
+#define SHRINE_CO_BEGIN switch (pc_) { case 0:
+#define SHRINE_CO_AWAIT(promptExpr)                                            \
+    do { promptExpr; pc_ = __LINE__; return false; case __LINE__:; } while (0)
+#define SHRINE_CO_END } return true
+
+// --- blocking driver ----------------------------------------------------------
+// Backends whose input can go away (UI) report it through cancelled(); the
+// others (ScriptedUI, HeadlessUI) never stop early.
+template <class UIT, class = void>
+struct InputCanCancel : std::false_type {};
+template <class UIT>
+struct InputCanCancel<UIT, std::void_t<decltype(std::declval<const UIT&>().cancelled())>> : std::true_type {};
+
+// Backends that throw the text away say so with `static constexpr bool
+// kDropsText = true` and take `int choose(int count)` instead: the shrine then
+// runs quiet and builds no strings for them.
+template <class UIT, class = void>
+struct UIDropsText : std::false_type {};
+template <class UIT>
+struct UIDropsText<UIT, std::void_t<decltype(UIT::kDropsText)>> : std::bool_constant<UIT::kDropsText> {};
+
+// Works with any backend that has print/choose/ask/waitForKey/flash (see
+// ShrineBehavior.hpp). If the backend's input is cancelled while a prompt is
+// up, the coroutine is abandoned without seeing the dead answer and the
+// Outcome comes back empty with cancelled set.
+template <class UIT>
+Outcome DriveShrine(ShrineCoroutine& co, UIT& ui) {
+    co.setQuiet(UIDropsText<UIT>::value);
+    bool finished = co.step();
+    for (;;) {
+        for (const std::string& line : co.drainOutput()) ui.print(line);
+        if (finished) return co.outcome();
+
+        const ShrinePrompt& p = co.prompt();
+        ShrineReply reply;
+        switch (p.kind) {
+            case ShrinePrompt::Kind::Choose:
+                if constexpr (UIDropsText<UIT>::value) reply.choice = ui.choose(p.count);
+                else reply.choice = ui.choose(p.text, p.options);
+                break;
+            case ShrinePrompt::Kind::Ask: {
+                const auto asked = std::chrono::steady_clock::now();
+                reply.text = ui.ask(p.text);
+                reply.elapsed = std::chrono::steady_clock::now() - asked;
+                break;
+            }
+            case ShrinePrompt::Kind::WaitKey: ui.waitForKey(); break;
+            case ShrinePrompt::Kind::Flash:   ui.flash(p.text, p.ms); break;
+        }
+        if constexpr (InputCanCancel<UIT>::value) {
+            if (ui.cancelled()) { Outcome gone; gone.cancelled = true; return gone; }
+        }
+        finished = co.resume(reply);
+    }
+}
@@ -0,0 +1,99 @@
+// ShrineModel.hpp
+#ifndef SHRINEMODEL_HPP
+#define SHRINEMODEL_HPP
+
+#include "BalanceParams.hpp"
+#include "EndingAnalyzer.hpp"   // Ending
+#include "Mechanics.hpp"        // WorldView
+#include "Theme.hpp"            // Deity
+#include <cstdint>
+#include <vector>
+
+// The numeric side of one shrine visit (stats, corruption, the flags Eris
+// scores) as a small probability tree, no dice rolled. Mirrors the
+// mechanics in ShrineBehavior.cpp and the numbers baked into StartShrine.
+// The ending analyzer and the auto-player both walk this model.
+namespace model {
+
+constexpr int kApolloRiddles  = 5;
+constexpr int kApolloOptions  = 4;
+constexpr int kPanRounds      = 5;
+constexpr int kPanNoteRange   = 5;
+constexpr int kFragments      = 8;
+constexpr double kFragmentOrders = 40320.0;   // 8!
+
+// Flags RunErisFinal scores.
+enum : std::uint8_t {
+    F_Demeter = 1 << 0,
+    F_Apollo  = 1 << 1,
+    F_Pan     = 1 << 2,
+    F_Nyx     = 1 << 3,
+};
+
+struct State {
+    int health, will, insight, nerve;
+    int corruption;
+    std::uint8_t flags;
+
+    // 4 bits per stat (0..10), 7 for corruption, 4 for flags
+    std::uint32_t key() const {
+        return  static_cast<std::uint32_t>(health)
+             | (static_cast<std::uint32_t>(will)       << 4)
+             | (static_cast<std::uint32_t>(insight)    << 8)
+             | (static_cast<std::uint32_t>(nerve)      << 12)
+             | (static_cast<std::uint32_t>(corruption) << 16)
+             | (static_cast<std::uint32_t>(flags)      << 23);
+    }
+    static constexpr int kKeyBits = 27;
+    static State fromKey(std::uint32_t k) {
+        return { static_cast<int>(k & 0xF), static_cast<int>((k >> 4) & 0xF),
+                 static_cast<int>((k >> 8) & 0xF), static_cast<int>((k >> 12) & 0xF),
+                 static_cast<int>((k >> 16) & 0x7F), static_cast<std::uint8_t>((k >> 23) & 0xF) };
+    }
+    bool has(std::uint8_t f) const { return (flags & f) != 0; }
+    void set(std::uint8_t f, bool on) { flags = on ? (flags | f) : (flags & ~f); }
+};
+
+// Same as PlayerState::applyOutcome for the numeric part.
+struct Delta { int health = 0, will = 0, insight = 0, nerve = 0, corruption = 0; };
+State apply(State s, const Delta& d);
+
+// How the player handles the shrine. Everything here is the player's call;
+// the dice are the model's.
+struct ShrinePlay {
+    WorldView view = WorldView::Corrupted;
+
+    enum class Order : std::uint8_t { Known, Random, Wrong };
+    int   demeterFragments = kFragments;   // held when arriving at the altar
+    Order demeterOrder     = Order::Known;
+    bool  nyxHasPages      = false;
+    int   apolloKnown      = kApolloRiddles;  // answered right for sure
+    bool  apolloGuessRest  = true;            // false: the rest answered wrong on purpose
+    int   hecateDoor       = 1;
+    int   panRecall        = kPanRounds;      // longest run repeated perfectly
+    bool  panGuessRest     = true;
+    int   thanatosChoice   = 2;
+    int   erisChoice       = 1;
+};
+
+// One way a visit can go. `over` ends the run, with `ending` (which is None
+// when Eris' plea fails: the story stops without one).
+struct Branch {
+    State state;
+    double p;
+    bool over;
+    Ending ending;
+};
+
+// Appends every branch of visiting `shrine` from `s` to `out` (probabilities
+// sum to 1), with the shrines tuned by `b`. Shrines without a mechanic
+// (Persephone) leave s as it is.
+void ExpandShrine(Deity shrine, const State& s, const ShrinePlay& play, std::vector<Branch>& out,
+                  const BalanceParams& b = Balance());
+
+// P(at least k successes) over independent trials with the given chances.
+double AtLeast(const std::vector<double>& chances, int k);
+
+} // namespace model
+
+#endif // SHRINEMODEL_HPP
@@ -0,0 +1,95 @@
+/* ShrineModule.h
+ * The C ABI for shrine modules: shared libraries (bin/modules/NAME.so) that add
+ * shrines without rebuilding the game. Plain C so a module can be built by
+ * any compiler against this one header; nothing C++ crosses the boundary.
+ *
+ * A module exports shrine_module(), which returns a table of handlers. A
+ * handler is a step function over a block of state the game allocates
+ * (zeroed, state_size bytes) for each visit: step runs until it needs an
+ * answer, asks for it through the host (choose/ask/wait_key/flash) and
+ * returns 0; the game gets the answer and calls step again, where
+ * reply_choice/reply_text have it. Returning 1 ends the visit. It is the
+ * same shape as ShrineCoroutine, with the module keeping its own place in
+ * `state`.
+ *
+ * Bump SHRINE_MODULE_ABI whenever anything below changes layout or meaning;
+ * the game refuses modules built against another version.
+ */
+#ifndef SHRINE_MODULE_H
+#define SHRINE_MODULE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define SHRINE_MODULE_ABI 1
+
+#if defined(_WIN32)
+#  define SHRINE_MODULE_EXPORT __declspec(dllexport)
+#else
+#  define SHRINE_MODULE_EXPORT __attribute__((visibility("default")))
+#endif
+
+enum { SHRINE_VIEW_LYSAIA = 0, SHRINE_VIEW_MELAS = 1 };
+enum { SHRINE_STAT_HEALTH = 0, SHRINE_STAT_WILL, SHRINE_STAT_INSIGHT, SHRINE_STAT_NERVE,
+       SHRINE_STAT_CORRUPTION };
+
+typedef struct ShrineHost ShrineHost;   /* opaque; hand it back on every call */
+
+/* What the game offers a running handler. Strings passed in are copied
+ * before the call returns; strings handed out live until the next step. */
+typedef struct ShrineHostApi {
+    uint32_t abi;
+
+    /* the player and the shrine */
+    int  (*stat)(ShrineHost*, int which);          /* SHRINE_STAT_* */
+    int  (*view)(ShrineHost*);                     /* SHRINE_VIEW_* */
+    int  (*corrupted)(ShrineHost*);                /* this shrine's state */
+    int  (*roll)(ShrineHost*, int lo, int hi);     /* the session's dice, inclusive */
+    int  (*flag)(ShrineHost*, const char* name);
+    void (*set_flag)(ShrineHost*, const char* name, int value);
+    int  (*has_item)(ShrineHost*, const char* key); /* ItemCatalog keys */
+
+    /* what the visit does: lines shown in order, then the outcome */
+    void (*print)(ShrineHost*, const char* line);
+    void (*add)(ShrineHost*, int which, int delta);   /* SHRINE_STAT_* delta */
+    void (*give_item)(ShrineHost*, const char* key);
+    void (*journal)(ShrineHost*, const char* entry);
+
+    /* prompts: call one, then return 0 from step */
+    void (*choose)(ShrineHost*, const char* text, const char* const* options, int count);
+    void (*ask)(ShrineHost*, const char* text);
+    void (*wait_key)(ShrineHost*);
+    void (*flash)(ShrineHost*, const char* text, int ms);
+
+    /* the answer to the last prompt */
+    int         (*reply_choice)(ShrineHost*);
+    const char* (*reply_text)(ShrineHost*);
+    int         (*reply_ms)(ShrineHost*);          /* ask: how long the answer took */
+} ShrineHostApi;
+
+typedef struct ShrineModuleHandler {
+    const char* key;      /* stable id, lower_snake_case ("tyche"); what Shrine names resolve to */
+    const char* label;    /* display name ("Tyche") */
+    size_t state_size;    /* bytes of zeroed state per visit */
+    int (*step)(void* state, const ShrineHostApi* api, ShrineHost* host);
+} ShrineModuleHandler;
+
+typedef struct ShrineModuleInfo {
+    uint32_t abi;                          /* SHRINE_MODULE_ABI as the module saw it */
+    uint32_t count;
+    const ShrineModuleHandler* handlers;   /* must outlive the process; the game never unloads */
+} ShrineModuleInfo;
+
+/* Every module exports this (extern "C", no decoration). */
+#define SHRINE_MODULE_ENTRY "shrine_module"
+typedef const ShrineModuleInfo* (*ShrineModuleEntryFn)(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SHRINE_MODULE_H */
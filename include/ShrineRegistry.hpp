@@ -0,0 +1,85 @@
+// ShrineRegistry.hpp
+// Every shrine mechanic the game can run, in one table. A handler has a
+// stable key ("demeter", "false_hermes", "tyche") and a dense id that is its
+// slot in the table; a Shrine resolves its deity name to the id once, when
+// it's built, and starting it is an index from then on.
+//
+// The built-ins fill the first slots in Deity order, so their ids never
+// change (id == static_cast<int>(Deity)). Handlers from shrine modules
+// (ShrineModule.h) come after, in the order they load; keys are what stays
+// stable across builds for those.
+#pragma once
+#include "ShrineModule.h"
+#include "Theme.hpp"   // Deity
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+struct InteractionContext;
+struct ShrineServices;
+class ShrineCoroutine;
+
+using ShrineHandlerId = std::uint16_t;
+// The altar with nothing behind it (Deity::Default): unknown names land here.
+constexpr ShrineHandlerId kQuietShrine = static_cast<ShrineHandlerId>(Deity::Default);
+
+// A compiled-in mechanic; ctx.shrineState is already the shrine's.
+using ShrineStartFn = std::unique_ptr<ShrineCoroutine> (*)(InteractionContext& ctx, const ShrineServices& svc);
+
+struct ShrineHandler {
+    std::string key;
+    std::string label;
+    Deity theme = Deity::Default;                  // colours (module shrines use the hub's)
+    ShrineStartFn start = nullptr;                 // built-in, or
+    const ShrineModuleHandler* module = nullptr;   // from a loaded module
+};
+
+class ShrineRegistry {
+public:
+    // Adds a handler; false (and nothing added) if the key is taken.
+    bool add(ShrineHandler handler);
+    // Another name that finds `key` ("fake hermes" -> false_hermes).
+    void alias(const std::string& name, const std::string& key);
+
+    // By key, label or alias, any case, spaces or underscores. kQuietShrine if unknown.
+    ShrineHandlerId find(std::string_view name) const;
+    const ShrineHandler& get(ShrineHandlerId id) const {
+        return handlers_[id < handlers_.size() ? id : kQuietShrine];
+    }
+    std::size_t size() const { return handlers_.size(); }
+
+    // The handler's mechanic parked before its first line (see StartShrine).
+    std::unique_ptr<ShrineCoroutine> start(ShrineHandlerId id, InteractionContext& ctx,
+                                           const ShrineServices& svc) const;
+
+    // One module file; adds its handlers. False with a reason (and nothing
+    // added, the library unloaded) if it won't load, was built against
+    // another ABI, has no shrines, or any of its keys is already taken.
+    bool loadModule(const std::string& path, std::string& error);
+    // Every module in `dir` (by file name order, so ids repeat run to run).
+    // Errors go to stderr. Returns how many handlers were added.
+    int loadModules(const std::string& dir);
+
+private:
+    static std::string normalize(std::string_view name);
+    int lookup(const std::string& normalized) const;   // -1 if unknown
+
+    std::vector<ShrineHandler> handlers_;
+    std::vector<std::pair<std::string, ShrineHandlerId>> names_;   // normalized -> id
+};
+
+// The game's registry: the built-ins, then any modules in the module dir,
+// loaded on first use. Not thread-safe while modules are loading; after that
+// it's read-only.
+ShrineRegistry& Shrines();
+// Where modules come from; "" turns them off. Default "bin/modules". Only
+// matters before the first Shrines() call.
+void SetShrineModuleDir(const std::string& dir);
+
+// The compiled-in mechanics (ShrineRunner.cpp), in Deity order.
+void AddBuiltinShrines(ShrineRegistry& registry);
+
+// A module handler's visit as a ShrineCoroutine.
+std::unique_ptr<ShrineCoroutine> StartModuleShrine(const ShrineModuleHandler& handler, InteractionContext& ctx);
@@ -4,16 +4,38 @@
 #include "Mechanics.hpp"          // InteractionContext, Outcome, Theme, Deity
 #include "ShrineBehavior.hpp"    // RunDemeterLetter_FromInventory, RunNyxTrade, etc.
 
+class RiddleBag;
+
 // Services for shrines that touch the journal (Nyx/Hecate: Future entry)
 struct ShrineServices {
     TakeMelasEntryFn takeMelasEntry = nullptr; // remove+return one Melas entry
     GiveMelasEntryFn giveMelasEntry = nullptr; // append a Melas entry
+    RiddleBag*       riddles = nullptr;        // the session's bag (RiddleBank.hpp); null = ApolloRiddleSet()
 };
 
-// Dispatch the correct mechanic for a given shrine.
+// The right mechanic for a given shrine, as a coroutine parked before its first
+// line (see ShrineCoroutine.hpp). Sets ctx.shrineState to the shrine's state;
+// ctx must outlive the coroutine. Like RunShrine, applies no side effects.
+// The shrine's handler in Shrines() (ShrineRegistry.hpp): for a built-in, the
+// deity's script (ShrineScript.hpp) if one loaded, else the C++; a module's
+// shrine runs the module.
+std::unique_ptr<ShrineCoroutine> StartShrine(const Shrine& shrine, InteractionContext& ctx,
+                                             const ShrineServices& svc = {});
+// Always the compiled mechanic, never the script (reference for the scripts).
+std::unique_ptr<ShrineCoroutine> StartBuiltinShrine(const Shrine& shrine, InteractionContext& ctx,
+                                                    const ShrineServices& svc = {});
+
+// Dispatch the correct mechanic for a given shrine and run it to the end.
 // Applies NO side effects; just returns the Outcome.
 // (You can then apply it and write journal in your loop/manager.)
-Outcome RunShrine(const Shrine& shrine, InteractionContext& ctx, UI& ui, const ShrineServices& svc = {});
+// Templated on the UI backend like the Run* mechanics; UI and ScriptedUI are
+// built in ShrineRunner.cpp, other backends include ShrineRunnerImpl.hpp.
+template <class UIT>
+Outcome RunShrine(const Shrine& shrine, InteractionContext& ctx, UIT& ui, const ShrineServices& svc = {});
+
+extern template Outcome RunShrine<UI>(const Shrine&, InteractionContext&, UI&, const ShrineServices&);
+extern template Outcome RunShrine<ScriptedUI>(const Shrine&, InteractionContext&, ScriptedUI&, const ShrineServices&);
 
 // Helpers if you need them elsewhere
-Deity DeityFromName(const std::string& deityName);
+Deity DeityFromName(const std::string& deityName);   // via Shrines(); Default if unknown or a module's
+const RiddleSet& ApolloRiddleSet();   // the five Apollo asks without a riddle bag, with answers
@@ -0,0 +1,20 @@
+// ShrineRunnerImpl.hpp
+// Template definition of RunShrine (see ShrineRunner.hpp).
+// Only include this to instantiate it for a new UI backend.
+#pragma once
+#include "ShrineRunner.hpp"
+#include "ShrineBehaviorImpl.hpp"
+
+// --- blocking dispatcher ----------------------------------------------------
+template <class UIT>
+Outcome RunShrine(const Shrine& shrine,
+                  InteractionContext& ctx,
+                  UIT& ui,
+                  const ShrineServices& svc)
+{
+    // Preserve caller's state; StartShrine switches ctx to the shrine's for the run
+    const ShrineState prevState = ctx.shrineState;
+    Outcome out = DriveShrine(*StartShrine(shrine, ctx, svc), ui);
+    ctx.shrineState = prevState;
+    return out;
+}
@@ -0,0 +1,117 @@
+// ShrineScript.hpp
+// Shrines as data. A .shrine file is a small line-based script (prompts,
+// menus, skill checks, stat deltas, flags, journal lines) compiled once at
+// load time to bytecode; ShrineVM runs it as an ordinary ShrineCoroutine, so
+// drivers can't tell it from the hand-written mechanics.
+//
+// The language, in brief (one statement per line, `#` comments, a trailing
+// `\` joins the next line):
+//
+//   let x = expr          x = expr   x += expr   x -= expr
+//   arr xs                push xs expr   clear xs   xs[i] = expr   (1-based)
+//   if expr / elif expr / else / end        while expr / end
+//   for i = a to b / end                    break   continue   stop
+//   say "text"            journal "text"        blank n       (n empty lines)
+//   outcome will += 2     player will -= 1      (Outcome delta / right now)
+//   flag name = expr      odds "what", dc, stat, flat, mode
+//   choose x "prompt" : "opt", "opt"   (no options: open-ended pick)
+//   riddle x i            ask xs "prompt"       flash "text", ms     wait
+//   give "a" | "b" | "c"  (one at random, written to the journal if hooked)
+//
+// Text is "..." (adjacent literals join) with {expr}, {array}, {secs(ms)},
+// {fragment(i)} and {letter(i)} spliced in; \n \" \\ \{ \} escape.
+// Expressions: ints, + - * / %, comparisons, && || !, stats (health will
+// insight nerve corruption), and roll(a,b), check(dc,stat,flat,mode)
+// (mode 1 = advantage, 2 = disadvantage), len(xs), same(xs,ys), flag(name),
+// balance(key) (a BalanceParams number, e.g. balance(eris_plead_dc)),
+// fragments(), has_all_fragments(), fragment_index(i), eris_score(),
+// can_take(), take_page(), can_give(), melas(), pan_flash_ms(),
+// pan_rounds(), pan_notes(), pan_answer_ms(), pan_note_ms() (PanRules),
+// elapsed_ms(), riddles(), riddle_answer(i), letter_lines().
+#pragma once
+#include "Mechanics.hpp"
+#include "ShrineRegistry.hpp"   // ShrineHandlerId
+#include "ShrineRunner.hpp"   // ShrineServices, RiddleSet
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Bytecode: a flat int32 stream, each op followed by its operands. Values
+// live on an int stack; text ops first pop whatever their {...} pieces need.
+enum class ShrineOp : std::int32_t {
+    Push,                   // k
+    Load, Store,            // local
+    ALoad, AStore,          // array      (i) / (i, v)
+    APush, AClear, ALen,    // array      (v) / () / ()
+    ASame,                  // array array
+    Add, Sub, Mul, Div, Mod, Neg, Not, Bool,
+    Eq, Ne, Lt, Le, Gt, Ge,
+    Dup, Pop,
+    Jmp, Jz, Jnz,           // target
+    Stat,                   // stat       -> value
+    Player, Outcome,        // stat       (delta)
+    Flag, SetFlag,          // flag id    -> value / (v)
+    Param,                  // param      -> value (BalanceParamDefs() index)
+    Roll,                   // (lo, hi)
+    Check,                  // (dc, stat, flat, mode)
+    Odds,                   // text       (dc, stat, flat, mode)
+    Call,                   // builtin    (arg, if it takes one)
+    Say, Journal,           // text
+    Blank,                  // (n)
+    Choose,                 // text menu  -> choice (menu -1: open-ended)
+    Riddle,                 // (i)        -> choice
+    Ask,                    // array text
+    Flash,                  // text       (ms)
+    Wait,
+    Give,                   // pool
+    Stop,
+};
+
+enum class ShrineStat : std::int32_t { Health, Will, Insight, Nerve, Corruption };
+
+enum class ShrineBuiltin : std::int32_t {
+    Fragments, HasAllFragments, FragmentIndex, ErisScore, CanTake, TakePage, CanGive,
+    Melas, PanFlashMs, PanRounds, PanNotes, PanAnswerMs, PanNoteMs, ElapsedMs,
+    Riddles, RiddleAnswer, LetterLines,
+};
+
+struct ShrineText {
+    enum class Part : std::uint8_t { Literal, Int, Array, Seconds, Fragment, Letter };
+    struct Piece { Part part; std::string literal; int array = -1; };
+    std::vector<Piece> pieces;
+    int values = 0;   // how many pieces take a value off the stack
+};
+
+struct ShrineProgram {
+    std::string name;                              // "apollo"
+    std::vector<std::int32_t> code;
+    std::vector<ShrineText> texts;
+    std::vector<std::vector<std::string>> menus;
+    std::vector<std::vector<std::string>> pools;   // give "a" | "b"
+    int locals = 0;
+    int arrays = 0;
+};
+
+// Compile `source`; on failure returns false with "name:line: what" in error.
+bool CompileShrineScript(const std::string& source, const std::string& name,
+                         ShrineProgram& out, std::string& error);
+
+// The script for a built-in shrine: <dir>/<name>.shrine (demeter, nyx, apollo,
+// hecate, pan, false_hermes, thanatos, eris, persephone), all compiled on the
+// first call and kept in a table by handler id, so a lookup is an index.
+// nullptr if there isn't one or it didn't compile (the error goes to stderr
+// once); callers fall back to the built-in mechanic.
+const ShrineProgram* ShrineScriptFor(ShrineHandlerId id);
+inline const ShrineProgram* ShrineScriptFor(Deity deity) {
+    return ShrineScriptFor(static_cast<ShrineHandlerId>(deity));   // built-in ids are the enum
+}
+// Where scripts come from; "" turns scripts off. Default "assets/shrines".
+// Clears anything already loaded.
+void SetShrineScriptDir(const std::string& dir);
+std::string ShrineScriptName(Deity deity);
+
+// A coroutine parked at the script's first line, like the Start* factories.
+std::unique_ptr<ShrineCoroutine> StartShrineScript(const ShrineProgram& program, InteractionContext& ctx,
+                                                   const ShrineServices& svc,
+                                                   const RiddleSet& riddles);
@@ -0,0 +1,33 @@
+// TempleGenerator.hpp
+#ifndef TEMPLEGENERATOR_HPP
+#define TEMPLEGENERATOR_HPP
+
+#include "Map.hpp"
+#include "Room.hpp"
+#include "Shrine.hpp"
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+// Seeded procedural temples for stress-testing the world/graph code.
+// Same shape as the hand-built temple, just bigger: a hub with one wing per
+// deity on the same spokes Game uses, each wing a grid of rooms with exits in
+// both directions, a shrine at the far end and smaller shrines along the way.
+struct TempleGenOptions {
+    std::uint32_t seed = 1;
+    int roomCount      = 1000;   // total, including the hub
+    int shrineEvery    = 256;    // extra shrine room every N rooms in a wing (0 = far end only)
+    int loopPercent    = 10;     // chance of a diagonal shortcut between grid cells
+};
+
+// The same structures Game keeps for a world.
+struct GeneratedTemple {
+    std::vector<Room> rooms;                 // index == TempleMap node id
+    TempleMap map;
+    std::unordered_map<int, Shrine> shrines; // shrineId -> Shrine (one per wing)
+    int hub = 0;
+};
+
+void GenerateTemple(const TempleGenOptions& opts, GeneratedTemple& out);
+
+#endif // TEMPLEGENERATOR_HPP
@@ -19,6 +19,9 @@ enum class Deity {
     Default
 };
 
+// Display name for a deity ("False Hermes", "Hub" for Deity::Default).
+const char* deityLabel(Deity d);
+
 // Visual state of a shrine/scene.
 enum class ShrineState {
     UNCORRUPTED,
@@ -1,4 +1,5 @@
 #pragma once
+#include "CancelToken.hpp"
 #include <string>
 #include <vector>
 #include <functional>
@@ -8,6 +9,10 @@ struct UI {
     std::function<int(const std::string&, const std::vector<std::string>&)> choose;
     std::function<std::string(const std::string&)> ask;
     std::function<void()> wait;
+    std::function<void(const std::string&, int)> flashLine;   // show for ms, then wipe
+    // Set once this UI's input has gone away (EOF, idle timeout, cancel):
+    // choose() then returns 0 and ask() "", and the drivers stop asking.
+    CancelToken* cancel = nullptr;
 
     // conveniences / aliases
     void say(const std::string& s) const { if (print) print(s); }
@@ -15,4 +20,6 @@ struct UI {
     std::string input(const std::string& p) const { return ask ? ask(p) : std::string(); }
     void pause() const { if (wait) wait(); }
     void waitForKey() const { if (wait) wait(); }  // <-- used by ShrineBehavior.cpp
+    void flash(const std::string& s, int ms) const { if (flashLine) flashLine(s, ms); else say(s); }
+    bool cancelled() const { return cancel && cancel->cancelled(); }
 };
@@ -0,0 +1,95 @@
+// Wanderers.hpp
+#ifndef WANDERERS_HPP
+#define WANDERERS_HPP
+
+#include "Map.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Things that move through the room graph on their own, one step per tick.
+//   Shadow   flees light: leaves a lit room (or one next to it) for darker
+//            ones, and won't wander into the light.
+//   Stalker  hunts: walks down the distance field toward the player once it's
+//            within kHuntRadius, but stops a room short while the candle
+//            burns. In the dark it comes in, then backs off for a few ticks.
+enum class WandererKind : std::uint8_t { Shadow, Stalker, Count };
+const char* wandererName(WandererKind k);   // "shadow", "stalker"
+
+// A wanderer moving into or out of the player's room this tick.
+struct WandererSighting {
+    std::uint32_t who;
+    WandererKind kind;
+    bool entered;   // came in (else went out)
+    Dir dir;        // the player's exit it came through / left by; Dir::Count if there's none
+};
+
+// Every wanderer of a world, one array per field (PlayerBatch style). A tick
+// builds the two distance fields it needs (to the player, from the light) by
+// BFS bounded to their radius, then moves every lane in one pass, staging the
+// moves so lanes don't see each other's half-done tick. The fields are kept
+// while the player and the light stay put, so a quiet tick is just the pass.
+class Wanderers {
+public:
+    static constexpr int kHuntRadius = 8;    // how far a stalker smells you
+    static constexpr int kLightRadius = 1;   // the candle reaches the next room
+    static constexpr int kStalkerRest = 6;   // ticks spent backing off after a touch
+
+    std::vector<std::int32_t> room;          // where each one is
+    std::vector<WandererKind> kind;
+    std::vector<std::uint8_t> rest;          // stalker: ticks left backing off
+
+    // Take the room graph (exits as they are now) and a seed for the dice.
+    // Forgets every wanderer and lit room.
+    void attach(const TempleMap& map, std::uint32_t seed);
+    void clear();                            // no wanderers; same graph and lights
+
+    std::uint32_t spawn(WandererKind k, int at);   // at must be a room of the attached map
+    void setLit(int at, bool lit);                 // rooms lit whatever the candle does
+    std::size_t size() const { return room.size(); }
+    int countIn(int at, WandererKind k) const;
+
+    // One tick, the player in `playerRoom` (lit while `candle`). Appends to
+    // `seen` whoever comes into or goes out of that room.
+    void step(int playerRoom, bool candle, std::vector<WandererSighting>& seen);
+    std::uint64_t ticks() const { return tick_; }
+
+private:
+    static constexpr std::uint8_t kFar = 255;   // beyond a field's radius
+
+    // Distances within a radius of some sources, one word a room: the search
+    // that wrote it above the low 8 bits, the distance in them. A room the
+    // last search didn't reach has an old stamp, so a search touches only
+    // what it finds and a lookup is one load.
+    struct Field {
+        std::vector<std::uint32_t> cell;
+        std::vector<std::int32_t> queue;
+        std::uint32_t gen = 0;               // 24 bits
+        std::uint64_t key = ~0ull;           // what it was built for
+        int at(int r) const { return cell[r] >> 8 == gen ? static_cast<int>(cell[r] & 0xFF) : kFar; }
+    };
+    void search(Field& f, const std::vector<std::int32_t>& sources, int radius, bool towardSources);
+
+    // This tick's dice for a lane: one hash, spent 16 bits a roll.
+    std::uint64_t dice(std::uint32_t lane) const;
+    static int roll(std::uint64_t& dice, int count) {   // 0..count-1
+        const int r = static_cast<int>(((dice & 0xFFFF) * static_cast<std::uint64_t>(count)) >> 16);
+        dice >>= 16;
+        return r;
+    }
+    Dir exitTo(int from, int to) const;
+
+    const TempleMap* map_ = nullptr;
+    // the graph, compressed: exits out of each room, and the rooms leading in
+    std::vector<std::int32_t> outStart_, out_, inStart_, in_;
+    std::vector<std::uint8_t> lit_;
+    std::vector<std::int32_t> litRooms_;
+    std::uint32_t litVersion_ = 0;
+
+    Field hunt_, light_;
+    std::vector<std::int32_t> sources_, next_;
+    std::uint32_t seed_ = 0;
+    std::uint64_t tick_ = 0;
+};
+
+#endif // WANDERERS_HPP
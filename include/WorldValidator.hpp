@@ -0,0 +1,41 @@
+// WorldValidator.hpp
+#ifndef WORLDVALIDATOR_HPP
+#define WORLDVALIDATOR_HPP
+
+#include "Map.hpp"
+#include <ostream>
+#include <string>
+#include <vector>
+
+// Sanity checks for a wired TempleMap, run once per world load.
+// One pass over rooms and exits (O(V+E)) catches the mistakes hand wiring
+// makes: rooms you can't reach, exits with no way back, titles that don't
+// exist, an exit wired twice, rooms missing a journal location or deity.
+struct WorldIssue {
+    enum class Kind {
+        Unreachable,        // not reachable from the start room
+        MissingReverse,     // a -> b with no exit back the opposite way
+        DanglingTitle,      // wiring named a room that doesn't exist
+        DuplicateDirection, // same exit wired to two different rooms
+        NoLocationId,       // no journal location id
+        NoDeity             // no deity mapping (hub exempt)
+    };
+    Kind kind;
+    std::string detail;
+};
+
+struct WorldReport {
+    int rooms = 0;
+    int exits = 0;
+    std::vector<WorldIssue> issues;
+    bool ok() const { return issues.empty(); }
+};
+
+WorldReport ValidateWorld(const TempleMap& map, int start);
+void PrintWorldReport(const WorldReport& report, std::ostream& os);
+
+// Validate and complain: debug builds print the report and abort on any
+// issue, release builds (NDEBUG) print it and carry on. Returns report.ok().
+bool CheckWorld(const TempleMap& map, int start, const char* worldName);
+
+#endif // WORLDVALIDATOR_HPP
@@ -1,8 +1,15 @@
 // prologueController.hpp
 #pragma once
+#include "CancelToken.hpp"
+#include "EventScheduler.hpp"
+#include <chrono>
 #include <functional>
+#include <iostream>
 #include <string>
 
+// Lysaia's seven days as a state machine: start() opens Day 1, then feed() one
+// input line at a time until it returns false. Nothing blocks inside, so the
+// owner decides where lines come from; run() is the stdin loop the game uses.
 struct PrologueController {
     struct Hooks {
         std::function<void()> describe;
@@ -15,9 +22,32 @@ struct PrologueController {
         std::function<void()> showHelp;
     };
 
-    explicit PrologueController(Hooks h) : hooks_(std::move(h)) {}
-    void run();
+    static constexpr int kMaxDays = 7;
+
+    explicit PrologueController(Hooks h, std::ostream& out = std::cout)
+        : hooks_(std::move(h)), out_(&out) {}
+
+    void start();                       // header, help banner, Day 1
+    bool feed(const std::string& line); // one command; false once the prologue is over
+    bool done() const { return day_ > kMaxDays; }
+    std::string prompt() const;
+
+    // Blocking: start() + feed(line) until done. Stops early, returning false,
+    // on end of input, `idle` with nothing typed (0 = no limit) or a cancel
+    // from elsewhere; the token says which.
+    bool run(CancelToken& cancel, std::chrono::milliseconds idle = {});
 
 private:
+    void beginDay();
+    void endDay();
+
+    void describe();
+    void listExits();
+    bool moveTo(const std::string& dir);
+
     Hooks hooks_;
+    std::ostream* out_;
+    int  day_ = 0;
+    bool wrote_ = false;
+    TimerWheel nights_;   // one tick per night; start() books the omens
 };
@@ -1,6 +1,8 @@
 #ifndef UTILS_HPP
 #define UTILS_HPP
 
+#include "CancelToken.hpp"
+#include <chrono>
 #include <string>
 #include <string_view>
 #include <vector>
@@ -31,6 +33,16 @@ void sleepMillis(int ms);
 void writeRaw(std::string_view s);
 void flush();
 inline void cr() { writeRaw("\r"); }
+// Drop anything typed but not yet read (so keys hit early don't answer later).
+void discardPendingInput();
+// Block until stdin has something to read. Gives up, returning false, once
+// the token is cancelled or `idle` passes with nothing typed (0 = wait
+// forever); a timeout cancels the token itself. The token is polled every
+// 100 ms, so a cancel from elsewhere unwinds within that.
+bool waitForInput(CancelToken& token, std::chrono::milliseconds idle = {});
+// getline on top of waitForInput. False on cancel, timeout or end of input,
+// with the token cancelled and saying which.
+bool readLineOrCancel(std::string& out, CancelToken& token, std::chrono::milliseconds idle = {});
 
 // ANSI helpers
 std::string ansi(std::string_view seq);
@@ -45,6 +57,9 @@ void shakeLine(std::string_view text,
                int durationMs = 200,
                int baseIndent = 0,
                bool commitLine = true);
+// Show text on the current line for ms, then wipe the line and drop any
+// input typed meanwhile. Without ANSI the line is blanked with spaces.
+void flashLine(std::string_view text, int ms);
                
 std::string to_short_dir(const std::string& longDir);  // "north" -> "n"
 std::string expand_dir(const std::string& shortDir);   // "n" -> "north"
@@ -0,0 +1,78 @@
+// tyche.cpp — a shrine shipped as a module (see include/ShrineModule.h).
+// Build: make modules  -> bin/modules/tyche.so, picked up at startup.
+// Tyche, Fortune: three casts of the knucklebones against her. Win two and
+// she favours you; in Melas the bones are hers and ties go her way.
+#include "ShrineModule.h"
+
+namespace {
+
+struct Visit {
+    int pc;       // where step() left off
+    int cast;     // casts thrown so far
+    int won;
+    int lost;
+};
+
+const char* const kCastOrLeave[] = {"Cast the bones", "Walk away"};
+
+int step(void* state, const ShrineHostApi* api, ShrineHost* host) {
+    Visit& v = *static_cast<Visit*>(state);
+    const bool melas = api->view(host) == SHRINE_VIEW_MELAS;
+
+    switch (v.pc) {
+    case 0:
+        api->print(host, melas ? "A blindfolded statue holds out a cupped hand. The bones in it are stained."
+                               : "A blindfolded statue holds out a cupped hand. Five white bones rest in it.");
+        api->print(host, "\"Three casts,\" says a voice that isn't there. \"Best of three.\"");
+        break;
+    case 1:
+        if (api->reply_choice(host) != 1) {
+            api->print(host, "You leave the bones where they lie.");
+            api->journal(host, "I did not play with Fortune today.");
+            return 1;
+        }
+        {
+            const int mine = api->roll(host, 1, 6) + api->roll(host, 1, 6);
+            const int hers = api->roll(host, 1, 6) + api->roll(host, 1, 6);
+            const bool tieIsMine = !melas && !api->corrupted(host);
+            const bool win = mine > hers || (mine == hers && tieIsMine);
+            if (win) { ++v.won;  api->print(host, "The bones fall your way."); }
+            else     { ++v.lost; api->print(host, "The bones fall hers."); }
+            ++v.cast;
+        }
+        break;
+    default:
+        return 1;
+    }
+
+    if (v.won < 2 && v.lost < 2) {
+        v.pc = 1;
+        api->choose(host, v.cast == 0 ? "Tyche waits." : "Again?", kCastOrLeave, 2);
+        return 0;
+    }
+
+    v.pc = 2;
+    if (v.won == 2) {
+        api->print(host, "The statue's hand closes, gently, around nothing.");
+        api->add(host, SHRINE_STAT_INSIGHT, 1);
+        api->set_flag(host, "tyche_favoured", 1);
+        api->journal(host, "Fortune smiled. I don't trust it.");
+    } else {
+        api->print(host, melas ? "Something laughs behind the blindfold." : "The statue is still. Luck is luck.");
+        api->add(host, SHRINE_STAT_WILL, -1);
+        if (melas) api->add(host, SHRINE_STAT_CORRUPTION, 1);
+        api->set_flag(host, "tyche_favoured", 0);
+        api->journal(host, "I lost to Fortune. Of course I did.");
+    }
+    return 1;
+}
+
+const ShrineModuleHandler kHandlers[] = {
+    {"tyche", "Tyche", sizeof(Visit), step},
+};
+
+const ShrineModuleInfo kInfo = {SHRINE_MODULE_ABI, sizeof(kHandlers) / sizeof(kHandlers[0]), kHandlers};
+
+} // namespace
+
+extern "C" SHRINE_MODULE_EXPORT const ShrineModuleInfo* shrine_module(void) { return &kInfo; }
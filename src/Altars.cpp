@@ -0,0 +1,81 @@
+// Altars.cpp
+#include "Altars.hpp"
+#include <fstream>
+#include <sstream>
+#include <string_view>
+
+namespace {
+
+std::string_view trim(std::string_view s) {
+    while (!s.empty() && (s.front() == ' ' || s.front() == '\t')) s.remove_prefix(1);
+    while (!s.empty() && (s.back() == ' ' || s.back() == '\t' || s.back() == '\r')) s.remove_suffix(1);
+    return s;
+}
+
+} // namespace
+
+bool ParseAltars(const std::string& text, const std::string& name,
+                 std::vector<AltarSpec>& out, std::string& error) {
+    std::vector<AltarSpec> altars;
+    int startedAt = 0;   // line of the current altar's `altar =`
+    auto finish = [&]() -> bool {
+        if (altars.empty()) return true;
+        const AltarSpec& a = altars.back();
+        const char* missing = a.room.empty() ? "room" : a.from.empty() ? "from" : a.description.empty() ? "text" : nullptr;
+        if (!missing) return true;
+        error = name + ":" + std::to_string(startedAt) + ": altar '" + a.shrine + "' has no " + missing;
+        return false;
+    };
+
+    std::string_view rest(text);
+    for (int lineNo = 1; !rest.empty(); ++lineNo) {
+        const std::size_t eol = rest.find('\n');
+        std::string_view line = rest.substr(0, eol);
+        rest.remove_prefix(eol == std::string_view::npos ? rest.size() : eol + 1);
+        line = trim(line.substr(0, line.find('#')));
+        if (line.empty()) continue;
+
+        auto fail = [&](const std::string& what) {
+            error = name + ":" + std::to_string(lineNo) + ": " + what;
+            return false;
+        };
+        const std::size_t eq = line.find('=');
+        if (eq == std::string_view::npos) return fail("expected 'key = value'");
+        const std::string_view key = trim(line.substr(0, eq));
+        const std::string value(trim(line.substr(eq + 1)));
+        if (value.empty()) return fail("'" + std::string(key) + "' is empty");
+
+        if (key == "altar") {
+            if (!finish()) return false;
+            altars.emplace_back().shrine = value;
+            startedAt = lineNo;
+            continue;
+        }
+        if (altars.empty()) return fail("'" + std::string(key) + "' before any 'altar ='");
+        AltarSpec& a = altars.back();
+        if (key == "room") {
+            a.room = value;
+        } else if (key == "text") {
+            a.description = value;
+        } else if (key == "from") {
+            const std::size_t comma = value.rfind(',');
+            if (comma == std::string::npos) return fail("expected 'from = <room>, <direction>'");
+            a.from = std::string(trim(std::string_view(value).substr(0, comma)));
+            a.dir = dirFromName(std::string(trim(std::string_view(value).substr(comma + 1))));
+            if (a.from.empty() || a.dir == Dir::Count) return fail("expected 'from = <room>, <direction>'");
+        } else {
+            return fail("unknown key '" + std::string(key) + "'");
+        }
+    }
+    if (!finish()) return false;
+    out = std::move(altars);
+    return true;
+}
+
+bool LoadAltars(const std::string& path, std::vector<AltarSpec>& out, std::string& error) {
+    std::ifstream in(path);
+    if (!in) { out.clear(); return true; }
+    std::stringstream src;
+    src << in.rdbuf();
+    return ParseAltars(src.str(), path, out, error);
+}
@@ -0,0 +1,193 @@
+// AutoPlayer.cpp
+#include "AutoPlayer.hpp"
+#include <algorithm>
+
+namespace {
+
+const Deity kWings[] = { Deity::Demeter, Deity::Nyx, Deity::Apollo, Deity::Hecate, Deity::Persephone,
+                         Deity::Pan, Deity::FalseHermes, Deity::Thanatos, Deity::Eris };
+constexpr std::size_t kWingCount = sizeof(kWings) / sizeof(kWings[0]);
+
+constexpr int kPersephoneWingFragments = 6;   // Hall of Petals, Orchard Walk, Frozen Spring
+constexpr int kDemeterWingFragments    = 2;   // Threadbare Womb, Hall of Hunger
+
+int wingIndex(Deity d) {
+    for (std::size_t i = 0; i < kWingCount; ++i) if (kWings[i] == d) return static_cast<int>(i);
+    return -1;
+}
+
+std::uint16_t wingBit(Deity d) { return static_cast<std::uint16_t>(1u << wingIndex(d)); }
+
+std::uint64_t mix(std::uint64_t k) {   // splitmix64 finalizer
+    k ^= k >> 30; k *= 0xbf58476d1ce4e5b9ULL;
+    k ^= k >> 27; k *= 0x94d049bb133111ebULL;
+    return k ^ (k >> 31);
+}
+
+} // namespace
+
+std::size_t BotWingCount() { return kWingCount; }
+Deity BotWing(std::size_t i) { return kWings[i]; }
+
+bool BotState::seen(Deity wing) const { return (visited & wingBit(wing)) != 0; }
+
+std::string BotMove::describe() const {
+    switch (shrine) {
+        case Deity::Default:     return "stop";
+        case Deity::Persephone:  return "Persephone wing (fragments)";
+        case Deity::Demeter:
+            if (play.demeterFragments < model::kFragments) return "Demeter (letter incomplete)";
+            return play.demeterOrder == model::ShrinePlay::Order::Known ? "Demeter, letter in order"
+                                                                        : "Demeter, letter out of order";
+        case Deity::Nyx:         return "Nyx";
+        case Deity::Apollo:      return play.apolloKnown > 0 ? "Apollo, answer right" : "Apollo, answer wrong";
+        case Deity::Hecate:      return "Hecate, door " + std::to_string(play.hecateDoor);
+        case Deity::Pan:         return play.panRecall > 0 ? "Pan, repeat the notes" : "Pan, miss the notes";
+        case Deity::FalseHermes: return "False Hermes";
+        case Deity::Thanatos:    return play.thanatosChoice == 1 ? "Thanatos, rest" : "Thanatos, keep moving";
+        case Deity::Eris:
+            return play.erisChoice == 1 ? "Eris, resist" : play.erisChoice == 2 ? "Eris, plead" : "Eris, join";
+        default:                 return "?";
+    }
+}
+
+AutoPlayer::AutoPlayer(const Stats& startStats, int startCorruption, BotOptions opt) : opt_(opt) {
+    Stats s = startStats;
+    s.clamp();
+    start_.stats = { s.health, s.will, s.insight, s.nerve, std::clamp(startCorruption, 0, 100), 0 };
+    keys_.assign(std::size_t{1} << 16, 0);
+    values_.assign(keys_.size(), 0.0);
+}
+
+// --- transposition table -------------------------------------------------------
+
+double* AutoPlayer::lookup(std::uint64_t key) {
+    const std::size_t mask = keys_.size() - 1;
+    for (std::size_t i = mix(key) & mask;; i = (i + 1) & mask) {
+        if (keys_[i] == key + 1) return &values_[i];
+        if (keys_[i] == 0) return nullptr;
+    }
+}
+
+void AutoPlayer::store(std::uint64_t key, double v) {
+    if ((used_ + 1) * 2 > keys_.size()) {   // keep it at most half full
+        std::vector<std::uint64_t> oldKeys(keys_.size() * 2, 0);
+        std::vector<double> oldValues(values_.size() * 2, 0.0);
+        oldKeys.swap(keys_);
+        oldValues.swap(values_);
+        used_ = 0;
+        for (std::size_t i = 0; i < oldKeys.size(); ++i)
+            if (oldKeys[i]) store(oldKeys[i] - 1, oldValues[i]);
+    }
+    const std::size_t mask = keys_.size() - 1;
+    std::size_t i = mix(key) & mask;
+    while (keys_[i] != 0 && keys_[i] != key + 1) i = (i + 1) & mask;
+    if (keys_[i] == 0) ++used_;
+    keys_[i] = key + 1;
+    values_[i] = v;
+}
+
+// --- search ---------------------------------------------------------------------
+
+void AutoPlayer::moves(const BotState& s, std::vector<BotMove>& out) const {
+    using Order = model::ShrinePlay::Order;
+    out.clear();
+    for (Deity wing : kWings) {
+        if (s.seen(wing)) continue;
+        BotMove m;
+        m.shrine = wing;
+        m.play.nyxHasPages = opt_.nyxHasPages;
+        switch (wing) {
+            case Deity::Demeter:
+                m.play.demeterFragments = s.seen(Deity::Persephone) ? model::kFragments : kDemeterWingFragments;
+                out.push_back(m);
+                if (m.play.demeterFragments == model::kFragments) {   // a random order never beats picking
+                    m.play.demeterOrder = Order::Wrong;
+                    out.push_back(m);
+                }
+                break;
+            case Deity::Apollo:
+            case Deity::Pan:
+                out.push_back(m);                          // all right
+                m.play.apolloKnown = 0; m.play.apolloGuessRest = false;
+                m.play.panRecall = 0;   m.play.panGuessRest = false;
+                out.push_back(m);                          // all wrong
+                break;
+            case Deity::Hecate:
+                for (int door = 1; door <= 3; ++door) { m.play.hecateDoor = door; out.push_back(m); }
+                break;
+            case Deity::Thanatos:
+                for (int c = 1; c <= 2; ++c) { m.play.thanatosChoice = c; out.push_back(m); }
+                break;
+            case Deity::Eris:
+                for (int c = 1; c <= 3; ++c) { m.play.erisChoice = c; out.push_back(m); }
+                break;
+            default:
+                out.push_back(m);
+                break;
+        }
+    }
+}
+
+void AutoPlayer::expand(const BotState& s, const BotMove& m, std::vector<model::Branch>& out,
+                        std::vector<BotState>& next) const {
+    out.clear();
+    next.clear();
+
+    model::State at = s.stats;
+    if (m.shrine == Deity::Persephone) at = model::apply(at, {0, kPersephoneWingFragments, 0, 0, 0});
+    if (m.shrine == Deity::Demeter)    at = model::apply(at, {0, kDemeterWingFragments, 0, 0, 0});
+
+    model::ExpandShrine(m.shrine, at, m.play, out);
+    for (const model::Branch& b : out) {
+        BotState n{b.state, static_cast<std::uint16_t>(s.visited | wingBit(m.shrine))};
+        // Eris is the last word either way.
+        if (m.shrine == Deity::Eris) n.visited = static_cast<std::uint16_t>((1u << kWingCount) - 1);
+        next.push_back(n);
+    }
+}
+
+double AutoPlayer::moveValue(Ending target, const BotState& s, const BotMove& m) {
+    if (m.shrine == Deity::Default) return target == Ending::None ? 1.0 : 0.0;
+
+    std::vector<model::Branch> branches;
+    std::vector<BotState> next;
+    expand(s, m, branches, next);
+
+    double v = 0;
+    for (std::size_t i = 0; i < branches.size(); ++i) {
+        const model::Branch& b = branches[i];
+        if (b.over) v += b.p * (b.ending == target ? 1.0 : 0.0);
+        else        v += b.p * value(target, next[i]);
+    }
+    return v;
+}
+
+double AutoPlayer::value(Ending target, const BotState& s) {
+    const std::uint64_t key = s.key() | (static_cast<std::uint64_t>(target) << (model::State::kKeyBits + kWingCount));
+    if (const double* hit = lookup(key)) return *hit;
+    ++expanded_;
+
+    std::vector<BotMove> options;
+    moves(s, options);
+
+    // Out of wings, or choosing to walk away: the run ends with nothing.
+    double best = (options.empty() || opt_.allowStop) ? moveValue(target, s, BotMove{}) : 0.0;
+    for (const BotMove& m : options) best = std::max(best, moveValue(target, s, m));
+
+    store(key, best);
+    return best;
+}
+
+BotMove AutoPlayer::bestMove(Ending target, const BotState& s) {
+    std::vector<BotMove> options;
+    moves(s, options);
+
+    BotMove best;   // stop
+    double bestV = (options.empty() || opt_.allowStop) ? moveValue(target, s, best) : -1.0;
+    for (const BotMove& m : options) {
+        const double v = moveValue(target, s, m);
+        if (v > bestV + 1e-12) { bestV = v; best = m; }
+    }
+    return best;
+}
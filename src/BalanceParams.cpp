@@ -0,0 +1,116 @@
+// BalanceParams.cpp
+#include "BalanceParams.hpp"
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string_view>
+
+namespace {
+
+const BalanceParamDef kDefs[] = {
+    {"hermes_base_dc",          &BalanceParams::hermesBaseDc,          4, 10},
+    {"hermes_corruption_step",  &BalanceParams::hermesCorruptionStep,  10, 50},
+    {"hermes_escape_nerve",     &BalanceParams::hermesEscapeNerve,     0, 4},
+    {"hermes_trap_corruption",  &BalanceParams::hermesTrapCorruption,  0, 20},
+    {"thanatos_refuse_will",    &BalanceParams::thanatosRefuseWill,    0, 3},
+    {"hecate_past_will",        &BalanceParams::hecatePastWill,        0, 4},
+    {"hecate_present_will",     &BalanceParams::hecatePresentWill,     0, 4},
+    {"pan_mastered_nerve",      &BalanceParams::panMasteredNerve,      0, 4},
+    {"eris_plead_dc",           &BalanceParams::erisPleadDc,           4, 14},
+    {"eris_resist_dc",          &BalanceParams::erisResistDc,          4, 14},
+    {"eris_plead_score",        &BalanceParams::erisPleadScore,        0, 7},
+    {"eris_plead_bonus",        &BalanceParams::erisPleadBonus,        0, 4},
+    {"eris_resist_score",       &BalanceParams::erisResistScore,       0, 8},
+    {"eris_plead_will",         &BalanceParams::erisPleadWill,         0, 4},
+    {"eris_resist_nerve",       &BalanceParams::erisResistNerve,       0, 4},
+    {"eris_claimed_corruption", &BalanceParams::erisClaimedCorruption, 0, 15},
+};
+
+std::string_view trim(std::string_view s) {
+    while (!s.empty() && (s.front() == ' ' || s.front() == '\t')) s.remove_prefix(1);
+    while (!s.empty() && (s.back() == ' ' || s.back() == '\t' || s.back() == '\r')) s.remove_suffix(1);
+    return s;
+}
+
+BalanceParams& session() {
+    static BalanceParams params = [] {
+        BalanceParams p;
+        std::string error;
+        if (!LoadBalanceParams("assets/balance.txt", p, error))
+            std::cerr << "balance " << error << " (using the built-in numbers)\n";
+        return p;
+    }();
+    return params;
+}
+
+} // namespace
+
+const BalanceParamDef* BalanceParamDefs() { return kDefs; }
+std::size_t BalanceParamCount() { return sizeof(kDefs) / sizeof(kDefs[0]); }
+
+int BalanceParamIndex(const std::string& key) {
+    for (std::size_t i = 0; i < BalanceParamCount(); ++i)
+        if (key == kDefs[i].key) return static_cast<int>(i);
+    return -1;
+}
+
+bool ParseBalanceParams(const std::string& text, const std::string& name,
+                        BalanceParams& out, std::string& error) {
+    BalanceParams p;
+    std::string_view rest(text);
+    for (int lineNo = 1; !rest.empty(); ++lineNo) {
+        const std::size_t eol = rest.find('\n');
+        std::string_view line = rest.substr(0, eol);
+        rest.remove_prefix(eol == std::string_view::npos ? rest.size() : eol + 1);
+        line = trim(line.substr(0, line.find('#')));
+        if (line.empty()) continue;
+
+        auto fail = [&](const std::string& what) {
+            error = name + ":" + std::to_string(lineNo) + ": " + what;
+            return false;
+        };
+        const std::size_t eq = line.find('=');
+        if (eq == std::string_view::npos) return fail("expected 'key = value'");
+        const std::string key(trim(line.substr(0, eq)));
+        const std::string value(trim(line.substr(eq + 1)));
+        const int i = BalanceParamIndex(key);
+        if (i < 0) return fail("unknown key '" + key + "'");
+        char* end = nullptr;
+        const long v = std::strtol(value.c_str(), &end, 10);
+        if (value.empty() || *end) return fail("'" + key + "' wants a whole number");
+        const BalanceParamDef& d = kDefs[i];
+        if (v < d.lo || v > d.hi)
+            return fail("'" + key + "' must be " + std::to_string(d.lo) + ".." + std::to_string(d.hi));
+        p.*d.field = static_cast<int>(v);
+    }
+    out = p;
+    return true;
+}
+
+bool LoadBalanceParams(const std::string& path, BalanceParams& out, std::string& error) {
+    std::ifstream in(path);
+    if (!in) { error = path + ": can't open"; return false; }
+    std::stringstream src;
+    src << in.rdbuf();
+    return ParseBalanceParams(src.str(), path, out, error);
+}
+
+std::string FormatBalanceParams(const BalanceParams& p, const std::string& header) {
+    std::ostringstream out;
+    std::istringstream lines(header);
+    for (std::string l; std::getline(lines, l);) out << "# " << l << "\n";
+    if (!header.empty()) out << "\n";
+    for (std::size_t i = 0; i < BalanceParamCount(); ++i)
+        out << kDefs[i].key << " = " << p.*kDefs[i].field << "\n";
+    return out.str();
+}
+
+const BalanceParams& Balance() { return session(); }
+
+bool UseBalanceFile(const std::string& path, std::string& error) {
+    BalanceParams p;
+    if (!LoadBalanceParams(path, p, error)) return false;
+    session() = p;
+    return true;
+}
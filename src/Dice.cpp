@@ -0,0 +1,127 @@
+// Dice.cpp
+#include "Dice.hpp"
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace {
+
+constexpr std::uint32_t kFaces = 10;
+constexpr std::uint32_t kReject = (0u - kFaces) % kFaces;   // 2^32 mod 10 = 6
+
+std::uint32_t rotl(std::uint32_t x, int k) { return (x << k) | (x >> (32 - k)); }
+
+std::uint64_t splitmix(std::uint64_t& x) {
+    std::uint64_t z = (x += 0x9e3779b97f4a7c15ULL);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return z ^ (z >> 31);
+}
+
+} // namespace
+
+D10Stream::D10Stream(std::uint64_t seed) {
+    for (std::size_t l = 0; l < kLanes; ++l) {
+        const std::uint64_t a = splitmix(seed), b = splitmix(seed);
+        s_[0][l] = static_cast<std::uint32_t>(a);
+        s_[1][l] = static_cast<std::uint32_t>(a >> 32);
+        s_[2][l] = static_cast<std::uint32_t>(b);
+        s_[3][l] = static_cast<std::uint32_t>(b >> 32);
+        if ((a | b) == 0) s_[0][l] = 1;   // all-zero state never leaves zero
+    }
+}
+
+std::uint32_t D10Stream::stepLane(std::size_t l) {
+    const std::uint32_t result = rotl(s_[0][l] + s_[3][l], 7) + s_[0][l];
+    const std::uint32_t t = s_[1][l] << 9;
+    s_[2][l] ^= s_[0][l];
+    s_[3][l] ^= s_[1][l];
+    s_[1][l] ^= s_[2][l];
+    s_[0][l] ^= s_[3][l];
+    s_[2][l] ^= t;
+    s_[3][l] = rotl(s_[3][l], 11);
+    return result;
+}
+
+void D10Stream::draw(std::uint8_t* out, std::size_t blocks) {
+    std::size_t b = 0;
+#if defined(__SSE2__)
+    __m128i s0 = _mm_load_si128(reinterpret_cast<const __m128i*>(s_[0]));
+    __m128i s1 = _mm_load_si128(reinterpret_cast<const __m128i*>(s_[1]));
+    __m128i s2 = _mm_load_si128(reinterpret_cast<const __m128i*>(s_[2]));
+    __m128i s3 = _mm_load_si128(reinterpret_cast<const __m128i*>(s_[3]));
+    const __m128i ten    = _mm_set1_epi32(static_cast<int>(kFaces));
+    const __m128i one    = _mm_set1_epi32(1);
+    const __m128i oddHi  = _mm_set_epi32(-1, 0, -1, 0);
+    const __m128i sign   = _mm_set1_epi32(static_cast<int>(0x80000000u));
+    const __m128i reject = _mm_set1_epi32(static_cast<int>(kReject ^ 0x80000000u));
+    auto rotl4 = [](__m128i x, int k) { return _mm_or_si128(_mm_slli_epi32(x, k), _mm_srli_epi32(x, 32 - k)); };
+
+    for (; b < blocks; ++b) {
+        const __m128i sum = _mm_add_epi32(s0, s3);
+        const __m128i x = _mm_add_epi32(rotl4(sum, 7), s0);
+        const __m128i t = _mm_slli_epi32(s1, 9);
+        s2 = _mm_xor_si128(s2, s0);
+        s3 = _mm_xor_si128(s3, s1);
+        s1 = _mm_xor_si128(s1, s2);
+        s0 = _mm_xor_si128(s0, s3);
+        s2 = _mm_xor_si128(s2, t);
+        s3 = rotl4(s3, 11);
+
+        // x * 10 as 64-bit products: lanes 0/2 from the even multiply, 1/3 from the odd one
+        const __m128i pe = _mm_mul_epu32(x, ten);
+        const __m128i po = _mm_mul_epu32(_mm_srli_epi64(x, 32), ten);
+        const __m128i hi = _mm_or_si128(_mm_srli_epi64(pe, 32), _mm_and_si128(po, oddHi));
+        const __m128i lo = _mm_or_si128(_mm_andnot_si128(oddHi, pe), _mm_slli_epi64(po, 32));
+
+        alignas(16) std::uint32_t roll[kLanes];
+        _mm_store_si128(reinterpret_cast<__m128i*>(roll), _mm_add_epi32(hi, one));
+        // unsigned lo < kReject, via the sign-flip trick (SSE2 only compares signed)
+        const int bad = _mm_movemask_ps(_mm_castsi128_ps(_mm_cmplt_epi32(_mm_xor_si128(lo, sign), reject)));
+        if (bad) {
+            // rare: finish the redraw per lane, with the state spilled
+            _mm_store_si128(reinterpret_cast<__m128i*>(s_[0]), s0);
+            _mm_store_si128(reinterpret_cast<__m128i*>(s_[1]), s1);
+            _mm_store_si128(reinterpret_cast<__m128i*>(s_[2]), s2);
+            _mm_store_si128(reinterpret_cast<__m128i*>(s_[3]), s3);
+            for (std::size_t l = 0; l < kLanes; ++l) {
+                if (!((bad >> l) & 1)) continue;
+                std::uint64_t m;
+                do m = static_cast<std::uint64_t>(stepLane(l)) * kFaces;
+                while (static_cast<std::uint32_t>(m) < kReject);
+                roll[l] = static_cast<std::uint32_t>(m >> 32) + 1;
+            }
+            s0 = _mm_load_si128(reinterpret_cast<const __m128i*>(s_[0]));
+            s1 = _mm_load_si128(reinterpret_cast<const __m128i*>(s_[1]));
+            s2 = _mm_load_si128(reinterpret_cast<const __m128i*>(s_[2]));
+            s3 = _mm_load_si128(reinterpret_cast<const __m128i*>(s_[3]));
+        }
+        for (std::size_t l = 0; l < kLanes; ++l) out[b * kLanes + l] = static_cast<std::uint8_t>(roll[l]);
+    }
+    _mm_store_si128(reinterpret_cast<__m128i*>(s_[0]), s0);
+    _mm_store_si128(reinterpret_cast<__m128i*>(s_[1]), s1);
+    _mm_store_si128(reinterpret_cast<__m128i*>(s_[2]), s2);
+    _mm_store_si128(reinterpret_cast<__m128i*>(s_[3]), s3);
+#endif
+    for (; b < blocks; ++b) {
+        for (std::size_t l = 0; l < kLanes; ++l) {
+            std::uint64_t m = static_cast<std::uint64_t>(stepLane(l)) * kFaces;
+            while (static_cast<std::uint32_t>(m) < kReject) m = static_cast<std::uint64_t>(stepLane(l)) * kFaces;
+            out[b * kLanes + l] = static_cast<std::uint8_t>((m >> 32) + 1);
+        }
+    }
+}
+
+void D10Stream::fill(std::uint8_t* out, std::size_t n) {
+    std::size_t i = 0;
+    while (i < n && pos_ < kBuffer) out[i++] = buf_[pos_++];   // leftovers first
+    const std::size_t blocks = (n - i) / kLanes;
+    draw(out + i, blocks);
+    i += blocks * kLanes;
+    while (i < n) out[i++] = static_cast<std::uint8_t>(next());
+}
+
+int D10Stream::next() {
+    if (pos_ == kBuffer) { draw(buf_, kBuffer / kLanes); pos_ = 0; }
+    return buf_[pos_++];
+}
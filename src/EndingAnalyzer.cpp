@@ -0,0 +1,103 @@
+// EndingAnalyzer.cpp
+#include "EndingAnalyzer.hpp"
+#include "ShrineModel.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <unordered_map>
+
+namespace {
+
+using model::State;
+using Dist = std::unordered_map<std::uint32_t, double>;
+
+// Where a branch goes: back into the distribution, or out as an ending.
+struct Sink {
+    Dist& next;
+    EndingReport& report;
+    const State& start;
+
+    void cont(const State& s, double p) { if (p > 0) next[s.key()] += p; }
+    void end(const State& s, double p, Ending e) {
+        if (p <= 0) return;
+        report.probability[static_cast<int>(e)] += p;
+        report.health     += p * (s.health  - start.health);
+        report.will       += p * (s.will    - start.will);
+        report.insight    += p * (s.insight - start.insight);
+        report.nerve      += p * (s.nerve   - start.nerve);
+        report.corruption += p * (s.corruption - start.corruption);
+        if (s.health <= 0 || s.will <= 0) report.pBroken += p;
+    }
+};
+
+model::ShrinePlay PlayFor(const AnalyzerPolicy& pol) {
+    model::ShrinePlay play;
+    play.view             = pol.view;
+    play.demeterFragments = pol.demeterFragments;
+    play.demeterOrder     = pol.demeterKnowsOrder ? model::ShrinePlay::Order::Known
+                                                  : model::ShrinePlay::Order::Random;
+    play.nyxHasPages      = pol.nyxHasPages;
+    play.apolloKnown      = pol.apolloKnown;
+    play.hecateDoor       = pol.hecateDoor;
+    play.panRecall        = pol.panRecall;
+    play.thanatosChoice   = pol.thanatosChoice;
+    play.erisChoice       = pol.erisChoice;
+    return play;
+}
+
+} // namespace
+
+const char* endingName(Ending e) {
+    switch (e) {
+        case Ending::None:          return "No ending";
+        case Ending::EndlessHall:   return "Endless Hall";
+        case Ending::ThanatosSleep: return "Passive (Thanatos)";
+        case Ending::JoinedChoir:   return "Joined the Bone Choir";
+        case Ending::LysaiaTurns:   return "Lysaia Turns";
+        case Ending::Overcame:      return "Overcame the Offer";
+        case Ending::Claimed:       return "Claimed by Discord";
+        default:                    return "?";
+    }
+}
+
+std::vector<Deity> DefaultShrineRoute() {
+    return { Deity::Demeter, Deity::Nyx, Deity::Apollo, Deity::Hecate, Deity::Persephone,
+             Deity::Pan, Deity::FalseHermes, Deity::Thanatos, Deity::Eris };
+}
+
+EndingReport AnalyzeEndings(const Stats& startStats, int startCorruption, const AnalyzerPolicy& policy) {
+    EndingReport report;
+
+    Stats clamped = startStats;
+    clamped.clamp();
+    const State start{ clamped.health, clamped.will, clamped.insight, clamped.nerve,
+                       std::clamp(startCorruption, 0, 100), 0 };
+
+    Dist live{{start.key(), 1.0}};
+    report.peakStates = 1;
+
+    const model::ShrinePlay play = PlayFor(policy);
+    const BalanceParams& balance = policy.balance ? *policy.balance : Balance();
+    std::vector<model::Branch> branches;
+
+    for (Deity d : policy.route) {
+        Dist next;
+        next.reserve(live.size() * 2);
+        Sink out{next, report, start};
+        for (const auto& [key, p] : live) {
+            branches.clear();
+            model::ExpandShrine(d, State::fromKey(key), play, branches, balance);
+            for (const model::Branch& b : branches) {
+                if (b.over) out.end(b.state, p * b.p, b.ending);
+                else        out.cont(b.state, p * b.p);
+            }
+        }
+        live.swap(next);
+        report.peakStates = std::max(report.peakStates, live.size());
+    }
+
+    // Whatever survives the whole route finished without an ending.
+    Dist unused;
+    Sink out{unused, report, start};
+    for (const auto& [key, p] : live) out.end(State::fromKey(key), p, Ending::None);
+    return report;
+}
@@ -0,0 +1,127 @@
+// EndingRules.cpp
+#include "EndingRules.hpp"
+#include <algorithm>
+
+// ===== Tables =====
+
+const std::vector<RuleDef>& EndingRuleDefs() {
+    static const std::vector<RuleDef> defs = {
+        {"endless_hall",  {"false_hermes_endless_hall"}, {}, {}, 0, "Endless Hall"},
+        {"thanatos_sleep",{"thanatos_sleep_end"},        {}, {}, 0, "The Long Sleep"},
+        {"joined_choir",  {"ending_join_eris"},          {}, {}, 0, "Joined the Bone Choir"},
+        {"lysaia_turns",  {"ending_save_lysaia"},        {}, {}, 0, "Lysaia Turns"},
+        {"overcame",      {"ending_overcome"},           {}, {}, 0, "Overcame the Offer"},
+        {"claimed",       {"ending_claimed"},            {}, {}, 0, "Claimed by Discord"},
+    };
+    return defs;
+}
+
+const std::vector<RuleDef>& ErisScoreDefs() {
+    static const std::vector<RuleDef> defs = {
+        {"demeter_letter", {"demeter_letter_solved"},     {}, {}, 2},
+        {"apollo_majority",{"apollo_majority_right"},     {}, {}, 2},
+        {"pan_memory",     {"pan_memory_mastered"},       {}, {}, 2},
+        {"nyx_trade",      {"nyx_helpful_trade"},         {}, {}, 1},
+        {"trapped",        {"false_hermes_endless_hall"}, {}, {}, -999}, // shouldn't be here if trapped
+    };
+    return defs;
+}
+
+// ===== Compiler =====
+
+RuleSet::RuleSet(const std::vector<RuleDef>& defs) {
+    rules_.reserve(defs.size());
+    for (const RuleDef& d : defs) {
+        const auto index = static_cast<std::uint16_t>(rules_.size());
+        Rule r{&d, static_cast<std::uint32_t>(terms_.size()), 0,
+                   static_cast<std::uint32_t>(stats_.size()), 0};
+
+        // One term per 64-flag word the rule touches; usually just the one.
+        auto addFlag = [&](const char* name, bool set) {
+            const FlagId id = FlagStore::intern(name);
+            const std::uint32_t w = id >> 6;
+            const std::uint64_t bit = std::uint64_t{1} << (id & 63);
+
+            auto first = terms_.begin() + r.firstTerm;
+            auto it = std::find_if(first, terms_.end(), [w](const MaskTerm& t) { return t.word == w; });
+            if (it == terms_.end()) {
+                terms_.push_back({w, 0, 0});
+                it = terms_.end() - 1;
+            }
+            (set ? it->require : it->forbid) |= bit;
+
+            if (id >= watchers_.size()) watchers_.resize(id + 1u);
+            auto& list = watchers_[id];
+            if (list.empty() || list.back() != index) list.push_back(index);
+        };
+        for (const char* f : d.allOf)  addFlag(f, true);
+        for (const char* f : d.noneOf) addFlag(f, false);
+        r.termCount = static_cast<std::uint32_t>(terms_.size()) - r.firstTerm;
+
+        stats_.insert(stats_.end(), d.stats.begin(), d.stats.end());
+        r.statCount = static_cast<std::uint32_t>(d.stats.size());
+        if (r.statCount) hasStatRules_ = true;
+
+        rules_.push_back(r);
+    }
+}
+
+// ===== Evaluation =====
+
+static int StatValue(const PlayerState& ps, StatField f) {
+    switch (f) {
+        case StatField::Health:     return ps.stats.health;
+        case StatField::Will:       return ps.stats.will;
+        case StatField::Insight:    return ps.stats.insight;
+        case StatField::Nerve:      return ps.stats.nerve;
+        case StatField::Corruption: return ps.corruption;
+    }
+    return 0;
+}
+
+bool RuleSet::holds(std::size_t i, const FlagStore& flags, const PlayerState& ps) const {
+    const Rule& r = rules_[i];
+    for (std::uint32_t k = 0; k < r.termCount; ++k) {
+        const MaskTerm& t = terms_[r.firstTerm + k];
+        const std::uint64_t w = flags.word(t.word);
+        if ((w & t.require) != t.require || (w & t.forbid) != 0) return false;
+    }
+    for (std::uint32_t k = 0; k < r.statCount; ++k) {
+        const StatCond& c = stats_[r.firstStat + k];
+        const int v = StatValue(ps, c.stat);
+        if (c.cmp == Cmp::AtLeast ? v < c.value : v > c.value) return false;
+    }
+    return true;
+}
+
+int RuleSet::firstHolding(const FlagStore& flags, const PlayerState& ps) const {
+    for (std::size_t i = 0; i < rules_.size(); ++i)
+        if (holds(i, flags, ps)) return static_cast<int>(i);
+    return -1;
+}
+
+int RuleSet::score(const FlagStore& flags, const PlayerState& ps) const {
+    int total = 0;
+    for (std::size_t i = 0; i < rules_.size(); ++i)
+        if (holds(i, flags, ps)) total += rules_[i].def->weight;
+    return total;
+}
+
+bool RuleSet::watches(FlagId flag) const {
+    return flag < watchers_.size() && !watchers_[flag].empty();
+}
+
+const std::vector<std::uint16_t>& RuleSet::rulesWatching(FlagId flag) const {
+    static const std::vector<std::uint16_t> kNone;
+    return watches(flag) ? watchers_[flag] : kNone;
+}
+
+const RuleSet& EndingRules() {
+    static const RuleSet rules(EndingRuleDefs());
+    return rules;
+}
+
+const RuleSet& ErisScoreRules() {
+    static const RuleSet rules(ErisScoreDefs());
+    return rules;
+}
@@ -0,0 +1,39 @@
+// EventBus.cpp
+#include "EventBus.hpp"
+
+EventBus::EventBus(std::size_t capacity) : ring_(capacity ? capacity : 1) {}
+
+void EventBus::push(const Event& e) {
+    if (count_ == ring_.size()) {
+        // Full. Outside a flush, make room by delivering what's queued;
+        // inside one (a subscriber posting in a loop) there's nothing to do but drop.
+        if (flushing_) { ++dropped_; return; }
+        flush();
+    }
+    ring_[(head_ + count_) % ring_.size()] = e;
+    ++count_;
+}
+
+std::size_t EventBus::flush() {
+    if (flushing_) return 0;   // a subscriber asked; the outer flush will get there
+    flushing_ = true;
+    std::size_t delivered = 0;
+    while (count_ > 0) {
+        const Event e = ring_[head_];
+        head_ = (head_ + 1) % ring_.size();
+        --count_;
+        deliver(e);
+        ++delivered;
+    }
+    flushing_ = false;
+    return delivered;
+}
+
+void EventBus::deliver(const Event& e) const {
+    switch (e.type) {
+        case Type::RoomEntered:    for (const auto& fn : roomEntered_)    fn(e.roomEntered);    break;
+        case Type::ShrineResolved: for (const auto& fn : shrineResolved_) fn(e.shrineResolved); break;
+        case Type::ItemGained:     for (const auto& fn : itemGained_)     fn(e.itemGained);     break;
+        case Type::FlagChanged:    for (const auto& fn : flagChanged_)    fn(e.flagChanged);    break;
+    }
+}
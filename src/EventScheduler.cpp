@@ -0,0 +1,170 @@
+// EventScheduler.cpp
+#include "EventScheduler.hpp"
+
+namespace {
+
+int lowestBit(std::uint64_t v) {   // v != 0
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctzll(v);
+#else
+    int n = 0;
+    while (!(v & 1)) { v >>= 1; ++n; }
+    return n;
+#endif
+}
+
+int highestBit(std::uint64_t v) {  // v != 0
+#if defined(__GNUC__) || defined(__clang__)
+    return 63 - __builtin_clzll(v);
+#else
+    int n = 0;
+    while (v >>= 1) ++n;
+    return n;
+#endif
+}
+
+} // namespace
+
+// --- pool and lists ----------------------------------------------------------
+
+void TimerWheel::append(std::uint16_t list, std::uint32_t i) {
+    Node& n = nodes_[i];
+    List& l = lists_[list];
+    n.list = list;
+    n.prev = l.tail;
+    n.next = kNil;
+    if (l.tail != kNil) nodes_[l.tail].next = i; else l.head = i;
+    l.tail = i;
+    if (list < kOverflow) occupied_[list / kSlots] |= 1ull << (list % kSlots);
+}
+
+void TimerWheel::unlink(std::uint32_t i) {
+    Node& n = nodes_[i];
+    List& l = lists_[n.list];
+    if (n.prev != kNil) nodes_[n.prev].next = n.next; else l.head = n.next;
+    if (n.next != kNil) nodes_[n.next].prev = n.prev; else l.tail = n.prev;
+    if (l.head == kNil && n.list < kOverflow) occupied_[n.list / kSlots] &= ~(1ull << (n.list % kSlots));
+    n.prev = n.next = kNil;
+}
+
+void TimerWheel::release(std::uint32_t i) {
+    Node& n = nodes_[i];
+    n.list = kFree;
+    ++n.gen;   // outstanding handles go stale
+    n.next = free_;
+    free_ = i;
+}
+
+// The level is the highest 6-bit group where due and now differ: that slot
+// comes round exactly when everything above it matches.
+void TimerWheel::place(std::uint32_t i) {
+    const std::uint64_t due = nodes_[i].due;
+    if (due <= now_) { append(kReady, i); ++ready_; return; }
+    const int level = highestBit(due ^ now_) / kBits;
+    if (level >= kLevels) { append(kOverflow, i); ++pending_; return; }
+    const int slot = static_cast<int>((due >> (level * kBits)) & (kSlots - 1));
+    append(static_cast<std::uint16_t>(level * kSlots + slot), i);
+    ++pending_;
+}
+
+void TimerWheel::replaceAll(std::uint16_t list) {
+    std::uint32_t i = lists_[list].head;
+    lists_[list] = List{};
+    if (list < kOverflow) occupied_[list / kSlots] &= ~(1ull << (list % kSlots));
+    while (i != kNil) {
+        const std::uint32_t next = nodes_[i].next;
+        --pending_;
+        place(i);
+        i = next;
+    }
+}
+
+// --- scheduling --------------------------------------------------------------
+
+TimerHandle TimerWheel::schedule(std::uint64_t delay, const TimedEvent& e) {
+    std::uint32_t i = free_;
+    if (i != kNil) free_ = nodes_[i].next;
+    else { i = static_cast<std::uint32_t>(nodes_.size()); nodes_.emplace_back(); }
+
+    Node& n = nodes_[i];
+    n.due = now_ + delay;
+    n.event = e;
+    place(i);
+    return TimerHandle{i, n.gen, id_};
+}
+
+bool TimerWheel::cancel(TimerHandle h) {
+    if (h.wheel != id_ || h.index >= nodes_.size()) return false;
+    Node& n = nodes_[h.index];
+    if (n.gen != h.gen || n.list == kFree) return false;
+    if (n.list == kReady) --ready_; else --pending_;
+    unlink(h.index);
+    release(h.index);
+    return true;
+}
+
+// Keeps the pool: every node goes back on the free list a generation on, so a
+// handle from before the clear can't cancel whatever reuses its slot.
+void TimerWheel::clear() {
+    free_ = kNil;
+    for (std::uint32_t i = static_cast<std::uint32_t>(nodes_.size()); i-- > 0;) release(i);
+    lists_.fill(List{});
+    occupied_.fill(0);
+    now_ = 0;
+    pending_ = ready_ = 0;
+}
+
+// --- time --------------------------------------------------------------------
+
+void TimerWheel::step(std::uint64_t to) {
+    now_ = to;
+    if ((now_ & (kSlots - 1)) == 0) {
+        // a block edge: bring down the slots above that just came round
+        int level = 1;
+        for (; level < kLevels; ++level) {
+            const int slot = static_cast<int>((now_ >> (level * kBits)) & (kSlots - 1));
+            replaceAll(static_cast<std::uint16_t>(level * kSlots + slot));
+            if (slot != 0) break;
+        }
+        if (level == kLevels) replaceAll(kOverflow);
+    }
+    replaceAll(static_cast<std::uint16_t>(now_ & (kSlots - 1)));   // due now -> ready
+}
+
+void TimerWheel::advance(std::uint64_t ticks) {
+    const std::uint64_t target = now_ + ticks;
+    while (now_ < target) {
+        if (pending_ == 0) { now_ = target; return; }
+        // next occupied slot in this block, else the block edge
+        const int pos = static_cast<int>(now_ & (kSlots - 1));
+        const std::uint64_t ahead = pos == kSlots - 1 ? 0 : occupied_[0] & (~0ull << (pos + 1));
+        const std::uint64_t to = ahead ? (now_ & ~std::uint64_t(kSlots - 1)) + lowestBit(ahead)
+                                       : (now_ | (kSlots - 1)) + 1;
+        if (to > target) { now_ = target; return; }
+        step(to);
+    }
+}
+
+bool TimerWheel::next(TimedEvent& out) {
+    if (ready_ == 0) return false;
+    const std::uint32_t i = lists_[kReady].head;
+    out = nodes_[i].event;
+    unlink(i);
+    release(i);
+    --ready_;
+    return true;
+}
+
+// --- session -----------------------------------------------------------------
+
+TimerHandle SessionScheduler::in(std::chrono::milliseconds delay, const TimedEvent& e) {
+    const auto ticks = (delay.count() + kClockTick.count() - 1) / kClockTick.count();
+    return clock_.schedule(ticks > 0 ? static_cast<std::uint64_t>(ticks) : 0, e);
+}
+
+void SessionScheduler::tick(Clock::time_point now) {
+    if (now <= origin_) return;
+    const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(now - origin_);
+    const auto ticks = static_cast<std::uint64_t>(elapsed / kClockTick);
+    if (ticks > clock_.now()) clock_.advance(ticks - clock_.now());
+}
@@ -0,0 +1,119 @@
+// FalseHermesSolver.cpp
+#include "FalseHermesSolver.hpp"
+#include "Mechanics.hpp"   // SkillCheck, CheckMods
+#include <algorithm>
+#include <array>
+#include <map>
+#include <memory>
+#include <mutex>
+
+namespace {
+
+// Mirrors RunFalseHermesEndlessHall.
+constexpr int kWinAt  = 5;    // successes to escape
+constexpr int kLoseAt = 6;    // failures > 5 seals the hall
+constexpr int kWills  = FalseHermesTable::kMaxWill + 1;
+
+} // namespace
+
+const FalseHermesTable& FalseHermesTable::instance() {
+    return forBalance(Balance());
+}
+
+const FalseHermesTable& FalseHermesTable::forBalance(const BalanceParams& b) {
+    static std::mutex lock;
+    static std::map<std::array<int, 4>, std::unique_ptr<FalseHermesTable>> solved;
+    const std::array<int, 4> key{b.hermesBaseDc, b.hermesCorruptionStep, b.hermesEscapeNerve, b.hermesTrapCorruption};
+    std::lock_guard<std::mutex> hold(lock);
+    std::unique_ptr<FalseHermesTable>& t = solved[key];
+    if (!t) t.reset(new FalseHermesTable(b));
+    return *t;
+}
+
+int FalseHermesTable::index(int will, int corruption) {
+    will = std::clamp(will, 0, kMaxWill);
+    corruption = std::clamp(corruption, 0, kMaxCorruption);
+    return will * (kMaxCorruption + 1) + corruption;
+}
+
+const HermesOdds& FalseHermesTable::odds(int will, int corruption) const {
+    return odds_[index(will, corruption)];
+}
+
+const HermesFinal* FalseHermesTable::finalsBegin(int will, int corruption) const {
+    return finals_.data() + finalsAt_[index(will, corruption)];
+}
+
+const HermesFinal* FalseHermesTable::finalsEnd(int will, int corruption) const {
+    return finals_.data() + finalsAt_[index(will, corruption) + 1];
+}
+
+FalseHermesTable::FalseHermesTable(const BalanceParams& b) {
+    auto dcFor = [&b](int corruption) { return b.hermesBaseDc + corruption / b.hermesCorruptionStep; };
+    const int starts = kWills * (kMaxCorruption + 1);
+    odds_.resize(starts);
+    finalsAt_.reserve(starts + 1);
+
+    // Corruption only moves on a failure (+2, capped), so within one start it is
+    // a function of the failure count and the live state is (successes, failures, will).
+    double prob[kWinAt + 1][kLoseAt + 1][kWills];
+
+    for (int w0 = 0; w0 <= kMaxWill; ++w0) {
+        for (int c0 = 0; c0 <= kMaxCorruption; ++c0) {
+            finalsAt_.push_back(finals_.size());
+            auto corruptionAfter = [c0](int fails) { return std::min(kMaxCorruption, c0 + 2 * fails); };
+
+            std::fill(&prob[0][0][0], &prob[0][0][0] + sizeof(prob) / sizeof(double), 0.0);
+            prob[0][0][w0] = 1.0;
+
+            HermesOdds& o = odds_[index(w0, c0)];
+
+            // Every roll adds one success or one failure, so sweep by rolls taken.
+            for (int rolls = 0; rolls <= kWinAt + kLoseAt - 1; ++rolls) {
+                for (int s = 0; s <= std::min(rolls, kWinAt); ++s) {
+                    const int f = rolls - s;
+                    if (f > kLoseAt) continue;
+                    for (int w = 0; w <= kMaxWill; ++w) {
+                        const double p = prob[s][f][w];
+                        if (p == 0) continue;
+
+                        if (s == kWinAt || f == kLoseAt) {            // loop exit; stays put
+                            o.checks += p * rolls;
+                            continue;
+                        }
+                        const double hit = SkillCheck::successProbability(dcFor(corruptionAfter(f)), w, CheckMods{});
+                        const int passWill = std::min(kMaxWill, w + 1);
+                        const int failWill = ((f + 1) % 2 == 0) ? std::max(0, w - 1) : w;
+                        prob[s + 1][f][passWill] += p * hit;
+                        prob[s][f + 1][failWill] += p * (1 - hit);
+                    }
+                }
+            }
+
+            // Escapes keep the corruption of however many failures they took;
+            // traps always took six. Merge traps that differ only in successes.
+            for (int f = 0; f < kLoseAt; ++f)
+                for (int w = 0; w <= kMaxWill; ++w)
+                    if (prob[kWinAt][f][w] > 0)
+                        finals_.push_back({w, corruptionAfter(f), false, prob[kWinAt][f][w]});
+            for (int w = 0; w <= kMaxWill; ++w) {
+                double trapped = 0;
+                for (int s = 0; s < kWinAt; ++s) trapped += prob[s][kLoseAt][w];
+                if (trapped > 0) finals_.push_back({w, corruptionAfter(kLoseAt), true, trapped});
+            }
+
+            // Expected values with the Outcome applied.
+            for (auto it = finals_.begin() + static_cast<long>(finalsAt_.back()); it != finals_.end(); ++it) {
+                o.will += it->p * it->will;
+                if (it->trapped) {
+                    o.trap       += it->p;
+                    o.corruption += it->p * std::min(kMaxCorruption, it->corruption + b.hermesTrapCorruption);
+                } else {
+                    o.corruption += it->p * it->corruption;
+                    o.nerveDelta += it->p * b.hermesEscapeNerve;
+                }
+            }
+        }
+    }
+    finalsAt_.push_back(finals_.size());
+}
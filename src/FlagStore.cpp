@@ -0,0 +1,48 @@
+// FlagStore.cpp
+#include "FlagStore.hpp"
+#include <algorithm>
+#include <deque>
+#include <mutex>
+#include <unordered_map>
+
+namespace {
+struct FlagNames {
+    std::mutex lock;   // simulations intern from several threads
+    std::unordered_map<std::string, FlagId> ids;
+    std::deque<std::string> names;   // name() hands out references; they must not move
+};
+
+FlagNames& Names() {
+    static FlagNames n;
+    return n;
+}
+} // namespace
+
+FlagId FlagStore::intern(const std::string& name) {
+    FlagNames& n = Names();
+    std::lock_guard<std::mutex> hold(n.lock);
+    auto it = n.ids.find(name);
+    if (it != n.ids.end()) return it->second;
+    const auto id = static_cast<FlagId>(n.names.size());
+    n.ids.emplace(name, id);
+    n.names.push_back(name);
+    return id;
+}
+
+const std::string& FlagStore::name(FlagId id) {
+    FlagNames& n = Names();
+    std::lock_guard<std::mutex> hold(n.lock);
+    return n.names[id];
+}
+
+void FlagStore::set(FlagId id, bool value) {
+    if (get(id) == value) return;
+    const std::size_t w = id >> 6;
+    if (w >= bits_.size()) bits_.resize(w + 1, 0);
+    bits_[w] ^= std::uint64_t{1} << (id & 63);
+    if (bus_) bus_->post(FlagChanged{id, value});
+}
+
+void FlagStore::clear() {
+    std::fill(bits_.begin(), bits_.end(), 0);
+}
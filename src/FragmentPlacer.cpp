@@ -1,12 +1,17 @@
 #include "FragmentPlacer.hpp"
-#include <unordered_map>
-#include <algorithm>
-#include <cctype>
 
-static std::string toLowerCopy(std::string s) {
-    std::transform(s.begin(), s.end(), s.begin(),
-                   [](unsigned char c){ return std::tolower(c); });
-    return s;
+const std::vector<SpawnEntry>& PersephoneFragmentSpawns() {
+    static const std::vector<SpawnEntry> table = {
+        {"Hall of Petals",      PersephoneFragmentItem(3)},
+        {"Hall of Petals",      PersephoneFragmentItem(2)},
+        {"Orchard Walk",        PersephoneFragmentItem(6)},
+        {"Orchard Walk",        PersephoneFragmentItem(4)},
+        {"The Frozen Spring",   PersephoneFragmentItem(5)},
+        {"The Frozen Spring",   PersephoneFragmentItem(8)},
+        {"The Threadbare Womb", PersephoneFragmentItem(7)},
+        {"The Hall of Hunger",  PersephoneFragmentItem(1)},
+    };
+    return table;
 }
 
 // silent one-time pickup
@@ -20,22 +25,22 @@ static bool PickupPersephoneFragment_Silent(InteractionContext& ctx, int index)
     return true;
 }
 
-void CheckPersephoneLetterPickupsForRoom(InteractionContext& ctx, const std::string& roomTitle) {
-     if (ctx.view != WorldView::Corrupted) return;
-
-    static const std::unordered_map<std::string, std::vector<int>> PLACEMENT = {
-        {"hall of petals",                {3,2}},
-        {"orchard walk",                  {6,4}},
-        {"the frozen spring",             {5,8}},
-        {"the threadbare womb",    {7}},
-        {"the hall of hunger",            {1}},
-    };
+bool PickUpItem(InteractionContext& ctx, ItemId item) {
+    if (IsPersephoneFragment(item))
+        return PickupPersephoneFragment_Silent(ctx, static_cast<int>(item) - static_cast<int>(ItemId::PerseFrag1) + 1);
+    ctx.player.addItem(item);
+    return true;
+}
 
-    const std::string key = toLowerCopy(roomTitle);
-    auto it = PLACEMENT.find(key);
-    if (it == PLACEMENT.end()) return;
+int PickUpItemsInRoom(InteractionContext& ctx, ItemPlacement& placement, int room) {
+    std::uint64_t here = placement.spawnsIn(room);
+    if (!here) return 0;   // nearly every room: one load, one test
 
-    for (int idx : it->second) {
-        PickupPersephoneFragment_Silent(ctx, idx);
+    int picked = 0;
+    for (int spawn = 0; here; ++spawn, here >>= 1) {
+        if (!(here & 1)) continue;
+        if (PickUpItem(ctx, placement.item(spawn))) ++picked;
+        placement.take(spawn);
     }
+    return picked;
 }
@@ -1,4 +1,5 @@
 #include "Game.hpp"
+#include "Altars.hpp"
 #include "SceneManager.hpp"
 #include "UI.hpp"
 #include "Shrine.hpp"
@@ -8,9 +9,18 @@
 #include "ShrineBehavior.hpp"
 #include "PersephoneFragments.hpp"
 #include "FragmentPlacer.hpp"
+#include "ItemPlacement.hpp"
 #include "ShrineRunner.hpp"
+#include "ShrineRegistry.hpp"
+#include "RiddleBank.hpp"
 #include "JournalManager.hpp"
 #include "prologueController.hpp" 
+#include "WorldValidator.hpp"
+#include "EventBus.hpp"
+#include "FlagStore.hpp"
+#include "EndingRules.hpp"
+#include "EventScheduler.hpp"
+#include "Wanderers.hpp"
 #include <unordered_map>
 #include <iostream>
 #include <limits>
@@ -18,22 +28,14 @@
 #include <ctime>
 #include <cctype>
 #include <cstdlib>
+#include <random>
 #include <sstream>
 
 // --- deity inference helpers -------------------------------------------------
 
+// Shrine names resolve through the shrine registry (module shrines theme as the hub).
 Deity Game::deityFromShrineName(const std::string& name) const {
-    const std::string n = toLower(name);
-    if      (n == "nyx")          return Deity::Nyx;
-    else if (n == "eris")         return Deity::Eris;
-    else if (n == "pan")          return Deity::Pan;
-    else if (n == "demeter")      return Deity::Demeter;
-    else if (n == "persephone")   return Deity::Persephone;
-    else if (n == "false hermes") return Deity::FalseHermes;
-    else if (n == "thanatos")     return Deity::Thanatos;
-    else if (n == "apollo")       return Deity::Apollo;
-    else if (n == "hecate")       return Deity::Hecate;
-    return Deity::Default;
+    return DeityFromName(name);
 }
 
 // Map a room name to a deity by known titles you already use.
@@ -113,7 +115,16 @@ static std::string toLocationId(const std::string& roomName);
 // =================== Mechanics Integration Bridge ============================
 static RNG                     g_rng;
 static PlayerState             g_pstate;
-static std::unordered_map<std::string, bool> g_flags;
+static EventBus                g_events;            // flushed once per command
+static FlagStore               g_flags{&g_events};  // posts FlagChanged
+static ItemPlacement           g_items;             // what lies where in this world
+static bool                    g_stopTravel = false;
+static int                     g_ending = -1;       // EndingRules() index once reached
+static CancelToken             g_cancel;            // the player's input went away
+static std::chrono::milliseconds g_idle{0};         // give up after this long with no input (0 = never)
+static SessionScheduler        g_timers;            // ambience, by turn and by the clock
+static Wanderers               g_wanderers;         // shadows and stalkers, a step per turn
+static bool                    g_candleLit = false; // until the candle timer runs out
 
 // ---- Journal bridge (to your JournalManager) --------------------------------
 struct JournalBridge : IJournalSink {
@@ -127,19 +138,32 @@ struct JournalBridge : IJournalSink {
 };
 static JournalBridge g_journal;
 
+// Apollo deals from the riddle bank; nothing repeats until the session has heard them all.
+static RiddleBag& SessionRiddles() {
+    static RiddleBag bag(DefaultRiddleBank());
+    return bag;
+}
+
 // ---- Minimal UI lambdas for prompts ----------------------------------------
 static UI g_ui {
     /*print*/ [](const std::string& s){ std::cout << s << "\n"; },
     /*choose*/[](const std::string& prompt, const std::vector<std::string>& opts){
         std::cout << prompt << "\n";
         for (size_t i=0;i<opts.size();++i) std::cout << "  " << (i+1) << ") " << opts[i] << "\n";
-        int pick=0; std::cout << "> "; std::cin >> pick; return pick;
+        std::cout << "> " << std::flush;
+        std::string line;   // 0 (never a valid pick) if it isn't a number or input is gone
+        return readLineOrCancel(line, g_cancel, g_idle) ? std::atoi(line.c_str()) : 0;
     },
     /*ask*/   [](const std::string& prompt){
-        std::cout << prompt << "\n> ";
-        std::string s; std::getline(std::cin >> std::ws, s); return s;
+        std::cout << prompt << "\n> " << std::flush;   // timed answers start the clock here
+        std::string s;
+        while (readLineOrCancel(s, g_cancel, g_idle))   // blank lines don't answer
+            if (!trim_copy(s).empty()) return s;
+        return std::string();
     },
-    /*wait*/  [](){ std::cout << "[Press Enter]"; std::cin.get(); }
+    /*wait*/  [](){ std::cout << "[Press Enter]" << std::flush; std::string _; readLineOrCancel(_, g_cancel, g_idle); },
+    /*flash*/ [](const std::string& s, int ms){ flashLine(s, ms); },
+    /*cancel*/ &g_cancel
 };
 
 // ---- Context factory --------------------------------------------------------
@@ -166,35 +190,213 @@ static void InitMechanics(JournalManager* jm, bool isMelasPlaythrough) {
     // Example starting stats; adjust as needed
     g_pstate.stats = {/*health*/5, /*will*/7, /*insight*/2, /*nerve*/2};
     g_pstate.corruption = isMelasPlaythrough ? 10 : 0;
+    g_pstate.inventory.clear();   // a replay from the menu starts empty-handed
+}
+
+// ---- Event subscribers (hooked up in Game::wireEvents) ------------------------
+
+// MELAS: auto-write a location entry once per room visit
+static void WriteLocationEntry(const std::string& roomTitle) {
+    if (g_pstate.view != WorldView::Corrupted || !g_journal.jm) return;
+    if (const std::string loc = toLocationId(roomTitle); !loc.empty()) {
+        const std::string flag = "melas_visited:" + loc;
+        if (!g_flags[flag]) {
+            g_journal.jm->writeMelasAt(loc); // add location entry
+            g_flags[flag] = true;            // de-dupe for future revisits
+        }
+    }
 }
 
-static void OnRoomEntered(const std::string& roomTitle) {
+// Auto-pickups from the world's placement (only Melas' temple has any);
+// every fragment found goes out as an ItemGained.
+static void PickUpFragments(int room) {
+    if (!g_items.anythingIn(room)) return;
     auto ctx = MakeCtx();
+    const std::uint8_t before = g_pstate.inventory.fragmentMask();
+    if (PickUpItemsInRoom(ctx, g_items, room) == 0) return;
+
+    const std::uint8_t found = g_pstate.inventory.fragmentMask() & static_cast<std::uint8_t>(~before);
+    for (int i = 1; i <= kPersephoneFragmentCount; ++i)
+        if (found & (1u << (i - 1))) g_events.post(ItemGained{PersephoneFragmentItem(i), 1});
+}
+
+// Endings: the shrines only set flags; this is where we notice. Only rules
+// that mention the changed flag are re-checked.
+static void WatchForEndings(const FlagChanged& e) {
+    const RuleSet& endings = EndingRules();
+    if (g_ending >= 0 || !endings.watches(e.flag)) return;
+    for (std::uint16_t i : endings.rulesWatching(e.flag)) {
+        if (endings.holds(i, g_flags, g_pstate)) { g_ending = i; return; }
+    }
+}
+
+// Stat-gated endings can only change when something moves the stats: a
+// shrine, or the temple itself (below).
+static void CheckStatEndings() {
+    const RuleSet& endings = EndingRules();
+    if (g_ending >= 0 || !endings.hasStatRules()) return;
+    g_ending = endings.firstHolding(g_flags, g_pstate);
+}
+
+static void WatchStatEndings(const ShrineResolved&) { CheckStatEndings(); }
+
+// ---- Timed ambience (Melas) ---------------------------------------------------
+// The temple acts between commands: whispers every few turns, corruption
+// seeping in and the candle burning down on the clock, and a false journal
+// entry a few turns after a shrine corrupts you.
+namespace {
+const char* const kWhispers[] = {
+    "Something breathes your name from behind the walls.",
+    "A choir hums three notes, then forgets the fourth.",
+    "Footsteps match yours, half a beat late.",
+    "Someone laughs in the next room. There is no next room.",
+    "The dust on the floor spells a word, then doesn't.",
+};
+constexpr int kWhisperCount = static_cast<int>(sizeof(kWhispers) / sizeof(kWhispers[0]));
+constexpr std::chrono::minutes kCreepEvery{4};
+constexpr std::chrono::minutes kCandleLowAt{20};
+constexpr std::chrono::minutes kCandleOutAt{25};
+} // namespace
+
+static TimedEvent NextWhisper() { return {TimedKind::Whisper, g_rng.roll(0, kWhisperCount - 1)}; }
+
+static void ScheduleAmbience() {
+    g_timers.start(SessionScheduler::Clock::now());
+    g_candleLit = g_pstate.view == WorldView::Corrupted;
+    if (g_pstate.view != WorldView::Corrupted) return;
+    g_timers.inTurns(g_rng.roll(4, 8), NextWhisper());
+    g_timers.in(kCreepEvery, {TimedKind::CorruptionCreep});
+    g_timers.in(kCandleLowAt, {TimedKind::CandleLow});
+    g_timers.in(kCandleOutAt, {TimedKind::CandleOut});
+}
+
+static void ScheduleHallucination(const ShrineResolved& e) {
+    if (g_pstate.view == WorldView::Corrupted && e.corruptionDelta > 0)
+        g_timers.inTurns(g_rng.roll(2, 4), {TimedKind::Hallucination});
+}
 
-    // --- MELAS: auto-write a location entry once per room visit ---
-    if (ctx.view == WorldView::Corrupted && g_journal.jm) {
-        if (const std::string loc = toLocationId(roomTitle); !loc.empty()) {
-            const std::string flag = "melas_visited:" + loc;
-            if (!g_flags[flag]) {
-                g_journal.jm->writeMelasAt(loc); // add location entry
-                g_flags[flag] = true;            // de-dupe for future revisits
-            }
+static void OnTimedEvent(const TimedEvent& e) {
+    Outcome out;
+    switch (e.kind) {
+        case TimedKind::Whisper:
+            std::cout << "\n" << kWhispers[e.arg] << "\n";
+            g_timers.inTurns(g_rng.roll(6, 12), NextWhisper());
+            return;
+        case TimedKind::CorruptionCreep:
+            std::cout << "\nThe cold in the stones seeps a little deeper. (+1 Corruption)\n";
+            out.corruptionDelta = 1;
+            g_timers.in(kCreepEvery, {TimedKind::CorruptionCreep});
+            break;
+        case TimedKind::Hallucination:
+            if (!g_journal.jm) return;
+            g_journal.jm->writeCorrupted();
+            std::cout << "\nYour journal feels heavier. Someone has written in it.\n";
+            return;
+        case TimedKind::CandleLow:
+            std::cout << "\nYour candle has burned low. The dark leans closer.\n";
+            return;
+        case TimedKind::CandleOut:
+            std::cout << "\nThe candle gutters out. You go on by touch. (-1 Nerve)\n";
+            out.nerveDelta = -1;
+            g_candleLit = false;
+            break;
+        case TimedKind::Omen:   // the prologue's
+            return;
+    }
+    g_pstate.applyOutcome(out);
+    CheckStatEndings();
+}
+
+// After every command: the clock catches up, whatever is due happens.
+static void RunTimers() {
+    g_timers.tick(SessionScheduler::Clock::now());
+    for (TimedEvent e; g_timers.next(e);) OnTimedEvent(e);
+}
+
+// ---- Wanderers (Melas) --------------------------------------------------------
+// What the descriptions promise: the Den of Antlers' stalker, the Unlit Path's
+// extra shadow and a few more shadows loose in the wings. The hub is lit.
+static void SpawnWanderers(const TempleMap& map) {
+    g_wanderers.attach(map, static_cast<std::uint32_t>(g_rng.roll(1, 1 << 30)));
+    const int hub = map.indexByTitle("Main Hall of the Temple");
+    g_wanderers.setLit(hub, true);
+    if (const int den = map.indexByTitle("Den of Antlers"); den >= 0)
+        g_wanderers.spawn(WandererKind::Stalker, den);
+    if (const int path = map.indexByTitle("The Unlit Path"); path >= 0)
+        g_wanderers.spawn(WandererKind::Shadow, path);
+    for (int i = 0; i < 4 && map.size() > 1; ++i) {
+        int at = g_rng.roll(0, map.size() - 1);
+        if (at == hub) at = (at + 1) % map.size();
+        g_wanderers.spawn(WandererKind::Shadow, at);
+    }
+}
+
+static std::string fromDir(Dir d) {
+    if (d == Dir::Up)   return "from above";
+    if (d == Dir::Down) return "from below";
+    return d == Dir::Count ? "from somewhere" : std::string("from the ") + dirName(d);
+}
+
+static std::string towardDir(Dir d) {
+    if (d == Dir::Up)   return "upward";
+    if (d == Dir::Down) return "downward";
+    return d == Dir::Count ? "into the dark" : std::string("to the ") + dirName(d);
+}
+
+// Who's already here, printed with the room.
+static void DescribeWanderers(int room) {
+    const int shadows = g_wanderers.countIn(room, WandererKind::Shadow);
+    if (shadows == 1) std::cout << "A shadow that isn't yours clings to the wall.\n";
+    if (shadows > 1)  std::cout << shadows << " shadows that aren't yours cling to the walls.\n";
+    if (g_wanderers.countIn(room, WandererKind::Stalker) > 0)
+        std::cout << "Something crouches here, too still to be a statue.\n";
+}
+
+// Once per turn, after the timers: everything takes its step, and the
+// player sees what comes into or leaves the room. A stalker that reaches you
+// in the dark costs Nerve; anything coming in stops a travel.
+static void MoveWanderers(int playerRoom) {
+    if (g_wanderers.size() == 0) return;
+    std::vector<WandererSighting> seen;
+    g_wanderers.step(playerRoom, g_candleLit, seen);
+    Outcome out;
+    for (const WandererSighting& s : seen) {
+        if (s.entered) g_stopTravel = true;
+        if (s.kind == WandererKind::Shadow) {
+            std::cout << (s.entered ? "A shadow slides in " + fromDir(s.dir) + "."
+                                    : "A shadow slips away " + towardDir(s.dir) + ".") << "\n";
+        } else if (s.entered) {
+            std::cout << "Something comes in " << fromDir(s.dir)
+                      << ", low and quick, and brushes past you in the dark. (-1 Nerve)\n";
+            out.nerveDelta -= 1;
+        } else {
+            std::cout << "Whatever was crouching here is gone " << towardDir(s.dir) << ".\n";
         }
     }
+    if (out.nerveDelta == 0) return;
+    g_pstate.applyOutcome(out);
+    CheckStatEndings();
+}
 
-    // Persephone letter fragment auto-pickups (already Melas-only inside)
-    CheckPersephoneLetterPickupsForRoom(ctx, roomTitle);
+// A command that took game time: the turn-counted timers move on a turn and
+// the wanderers take their step.
+static void PassTurn(int playerRoom) {
+    g_timers.turn();
+    RunTimers();
+    MoveWanderers(playerRoom);
 }
 
-static void OnShrineInteract(const Shrine& shrine, JournalManager* /* jm */) {
+static void OnShrineInteract(const Shrine& shrine, int shrineId, JournalManager* /* jm */) {
     auto ctx = MakeCtx();
 
     ShrineServices svc;
+    svc.riddles = &SessionRiddles();
     // If your JournalManager exposes these, wire them; else leave nullptr
     // svc.takeMelasEntry = [jm]() -> std::optional<std::string> { return jm->takeLastMelasEntry(); };
     // svc.giveMelasEntry = [jm](const std::string& s) { jm->writeMelas(s); };
 
     Outcome out = RunShrine(shrine, ctx, g_ui, svc);
+    if (out.cancelled) return;   // the player is gone; the session is closing
 
     // Apply result and log
     g_pstate.applyOutcome(out);
@@ -203,13 +405,11 @@ static void OnShrineInteract(const Shrine& shrine, JournalManager* /* jm */) {
         else                               g_journal.writeLysaia(out.journalEntry);
     }
 
-    // Endings check (optional)
-    if (g_flags["false_hermes_endless_hall"] || g_flags["thanatos_sleep_end"] ||
-        g_flags["ending_join_eris"] || g_flags["ending_save_lysaia"] ||
-        g_flags["ending_overcome"] || g_flags["ending_claimed"]) {
-        // TODO: return to menu / credits
-        // e.g., SceneManager::instance().goToMainMenu();
-    }
+    g_events.post(ShrineResolved{Shrines().get(shrine.handler()).theme, shrineId,
+                                 out.healthDelta, out.willDelta, out.insightDelta,
+                                 out.nerveDelta, out.corruptionDelta});
+    for (ItemId id : out.itemsGained) g_events.post(ItemGained{id, 1});
+    // (ending flags set by the shrine reach WatchForEndings as FlagChanged)
 }
 // ================= End Mechanics Integration Bridge ==========================
 
@@ -232,24 +432,47 @@ void Game::printShrineText(const Shrine& shrine,
 }
 
 // --- lookup & wiring helpers ---
+int Game::addRoom(const Room& room) {
+    rooms.push_back(room);
+    return templeMap.addNode(room.getName(), room.isShrine(),
+                             deityFromRoomName(room.getName()), toLocationId(room.getName()));
+}
+
 int Game::indexByTitle(const std::string& title) const {
-    for (int i = 0; i < static_cast<int>(rooms.size()); ++i)
-        if (rooms[i].getName() == title) return i;
-    return -1;
+    return templeMap.indexByTitle(title);
+}
+
+void Game::indexWorld(const char* worldName) {
+    const int hub = indexByTitle("Main Hall of the Temple");
+    CheckWorld(templeMap, hub, worldName);   // aborts on bad wiring in debug builds
+    paths_.build(templeMap);
+    mapView_.reset(templeMap, hub);
+}
+
+void Game::visitRoom(int id) {
+    if (id < 0 || id >= static_cast<int>(rooms.size()) || rooms[id].isVisited()) return;
+    rooms[id].markVisited();
+    mapView_.markVisited(id);
 }
 
 void Game::addEdge(int from, const std::string& dirLong, int to) {
-    const std::string longKey = normalize_dir(dirLong); // "n" -> "north"
-    roomConnections[from][longKey] = to;                // store only long key
+    templeMap.addEdge(from, dirFromName(dirLong), to);  // "n" and "north" both accepted
+}
+
+void Game::addReturn(int from, const std::string& dirLong, int to) {
+    templeMap.addOneWay(from, dirFromName(dirLong), to);
 }
 
 
 void Game::addEdgeByTitle(const std::string& fromTitle, const std::string& dirLong,
                           const std::string& toTitle) {
-    const int from = indexByTitle(fromTitle);
-    const int to   = indexByTitle(toTitle);
-    if (from < 0 || to < 0) return; // or assert/log
-    addEdge(from, dirLong, to);
+    // unknown titles are skipped here and reported by the world check
+    templeMap.addEdgeByTitle(fromTitle, dirFromName(dirLong), toTitle);
+}
+
+void Game::addReturnByTitle(const std::string& fromTitle, const std::string& dirLong,
+                            const std::string& toTitle) {
+    templeMap.addEdgeByTitle(fromTitle, dirFromName(dirLong), toTitle, /*oneWay*/true);
 }
 
 void Game::addEdgeBothByTitle(const std::string& fromTitle, const std::string& dirLong,
@@ -259,8 +482,6 @@ void Game::addEdgeBothByTitle(const std::string& fromTitle, const std::string& d
 }
 
 void Game::setupPrologueConnectionsByTitle() {
-    roomConnections.clear();
-
     const std::string MH = "Main Hall of the Temple";
 
     // Main Hall spokes
@@ -270,47 +491,46 @@ void Game::setupPrologueConnectionsByTitle() {
     addEdgeByTitle(MH, "southeast", "Loom of Names");              // Hecate entry
     addEdgeByTitle(MH, "south",     "Hall of Petals");             // Persephone entry
     addEdgeByTitle(MH, "southwest", "Hall of Living Wood");        // Pan entry
-    addEdgeByTitle(MH, "west",      "Room of Borrowed Things");    // False Hermes entry
+    addReturnByTitle(MH, "west",    "Room of Borrowed Things");    // False Hermes entry (back is north, on purpose)
     addEdgeByTitle(MH, "northwest", "Room of Waiting Lights");     // Thanatos entry
     addEdgeByTitle(MH, "up",        "Throat of the Temple");       // Eris entry
 
-    // Quick return to Main Hall from each room in a wing (matches your index layout)
-    addEdgeByTitle("Garden of Blooming Faces", "south", MH);
-    addEdgeByTitle("Threaded Womb",            "south", MH);
-    addEdgeByTitle("Hall of Plenty",           "south", MH);
+    // Quick return to Main Hall from each room in a wing (one-way shortcuts; matches your index layout)
+    addReturnByTitle("Garden of Blooming Faces", "south", MH);
+    addReturnByTitle("Threaded Womb",            "south", MH);
+    addReturnByTitle("Hall of Plenty",           "south", MH);
 
-    addEdgeByTitle("Room of Gentle Horizons",  "southwest", MH);
-    addEdgeByTitle("Nest of Wings",            "southwest", MH);
-    addEdgeByTitle("The Star-Bound Well",      "southwest", MH);
+    addReturnByTitle("Room of Gentle Horizons",  "southwest", MH);
+    addReturnByTitle("Nest of Wings",            "southwest", MH);
+    addReturnByTitle("The Star-Bound Well",      "southwest", MH);
 
-    addEdgeByTitle("Hall of Echoes",           "west", MH);
-    addEdgeByTitle("Room That Remembers",      "west", MH);
-    addEdgeByTitle("Echoing Gallery",          "west", MH);
+    addReturnByTitle("Hall of Echoes",           "west", MH);
+    // (Apollo's corridor runs west back to the entry, so no shortcut from deeper in)
 
-    addEdgeByTitle("Loom of Names",            "northwest", MH);
-    addEdgeByTitle("Listening Chamber",        "northwest", MH);
-    addEdgeByTitle("The Luminous Path",        "northwest", MH);
+    addReturnByTitle("Loom of Names",            "northwest", MH);
+    addReturnByTitle("Listening Chamber",        "northwest", MH);
+    addReturnByTitle("The Luminous Path",        "northwest", MH);
 
-    addEdgeByTitle("Hall of Petals",           "north", MH);
-    addEdgeByTitle("Orchard Walk",             "north", MH);
-    addEdgeByTitle("The Blooming Spring",      "north", MH);
+    addReturnByTitle("Hall of Petals",           "north", MH);
+    addReturnByTitle("Orchard Walk",             "north", MH);
+    addReturnByTitle("The Blooming Spring",      "north", MH);
 
-    addEdgeByTitle("Hall of Living Wood",      "northeast", MH);
-    addEdgeByTitle("Den of Antlers",           "northeast", MH);
-    addEdgeByTitle("Verdant Rotunda",          "northeast", MH);
+    addReturnByTitle("Hall of Living Wood",      "northeast", MH);
+    addReturnByTitle("Den of Antlers",           "northeast", MH);
+    addReturnByTitle("Verdant Rotunda",          "northeast", MH);
 
-    addEdgeByTitle("Room of Borrowed Things",  "north", MH);
-    addEdgeByTitle("Whispering Hall",          "north", MH);
-    addEdgeByTitle("Gilded Hallway",           "north", MH);
+    addReturnByTitle("Room of Borrowed Things",  "north", MH);
+    addReturnByTitle("Whispering Hall",          "north", MH);
+    addReturnByTitle("Gilded Hallway",           "north", MH);
 
-    addEdgeByTitle("Room of Waiting Lights",   "southeast", MH);
-    addEdgeByTitle("Waiting Room",             "southeast", MH);
-    addEdgeByTitle("Hall of Quiet Rest",       "southeast", MH);
+    addReturnByTitle("Room of Waiting Lights",   "southeast", MH);
+    addReturnByTitle("Waiting Room",             "southeast", MH);
+    addReturnByTitle("Hall of Quiet Rest",       "southeast", MH);
 
-    addEdgeByTitle("Throat of the Temple",     "down", MH);
-    addEdgeByTitle("Oracle’s Wake",            "down", MH);
-    addEdgeByTitle("Archivist’s Cell",         "down", MH);
-    addEdgeByTitle("Hall of Harmony",          "down", MH);
+    addReturnByTitle("Throat of the Temple",     "down", MH);
+    addReturnByTitle("Oracle’s Wake",            "down", MH);
+    addReturnByTitle("Archivist’s Cell",         "down", MH);
+    addReturnByTitle("Hall of Harmony",          "down", MH);
 
     // Linear paths inside each wing (bidirectional)
     addEdgeBothByTitle("Garden of Blooming Faces", "east", "Threaded Womb", "west");
@@ -455,22 +675,23 @@ void Game::describeCurrentRoom() {
     if (id < 0 || id >= static_cast<int>(rooms.size())) return;
 
     const Room& current = rooms[id];
+    visitRoom(id);
 
     // Only fire Melas mechanics/journal when actually in the main run.
     if (!inPrologue_ && id != lastEnteredRoom_) {
-        OnRoomEntered(current.getName());   // or OnRoomEntered(id);
+        g_events.post(RoomEntered{id, false});   // delivered after this command
         lastEnteredRoom_ = id;
     }
 
     // Print the room description once
     printRoomDescriptionColored(current, current.getDescription());
+    if (!inPrologue_) DescribeWanderers(id);
 
     // Exits
-    auto it = roomConnections.find(id);
-    if (it != roomConnections.end() && !it->second.empty()) {
-        std::vector<std::string> exits;
-        exits.reserve(it->second.size());
-        for (const auto& kv : it->second) exits.push_back(kv.first);
+    std::vector<std::string> exits;
+    for (int d = 0; d < kDirCount; ++d)
+        if (templeMap.exit(id, static_cast<Dir>(d)) >= 0) exits.push_back(dirName(static_cast<Dir>(d)));
+    if (!exits.empty()) {
         std::sort(exits.begin(), exits.end());
         std::cout << "Exits: " << join(exits, ", ") << "\n";
     }
@@ -489,49 +710,27 @@ void Game::runLysaiaPrologue() {
 
    hooks.listExits = [this]() {
     const int cur = player.getCurrentRoom();
-    auto it = roomConnections.find(cur);
-    if (it == roomConnections.end() || it->second.empty()) { std::cout << "No obvious exits.\n"; return; }
-
     std::vector<std::string> longs;
-    longs.reserve(it->second.size());
-    for (const auto& kv : it->second) longs.push_back(kv.first);
+    for (int d = 0; d < kDirCount; ++d)
+        if (templeMap.exit(cur, static_cast<Dir>(d)) >= 0) longs.push_back(dirName(static_cast<Dir>(d)));
+    if (longs.empty()) { std::cout << "No obvious exits.\n"; return; }
+
     std::sort(longs.begin(), longs.end());
-    longs.erase(std::unique(longs.begin(), longs.end()), longs.end());
     std::cout << "Exits: " << join(longs, ", ") << "\n";
 };
 
    hooks.moveTo = [this](const std::string& target) -> bool {
     if (auto dir = normalize_dir(target); !dir.empty()) {
-        const int cur = player.getCurrentRoom();
-        auto it = roomConnections.find(cur);
-        if (it == roomConnections.end()) { std::cout << "You can't move from here.\n"; return false; }
-
-        // resolve direction to a stored key (long or short)
-        auto jt = it->second.find(dir);
-        if (jt == it->second.end()) {
-            // try normalized alias
-            for (const auto& kv : it->second) {
-                if (normalize_dir(kv.first) == dir) { jt = it->second.find(kv.first); break; }
-            }
-        }
-        if (jt == it->second.end()) { std::cout << "No exit that way.\n"; return false; }
-
-        // perform move (Player::move prints its own “No exit” if needed)
-        player.move(jt->first, roomConnections);
-
+        // Player::move prints its own “No exit” if needed.
         // DO NOT describe here; controller will call hooks.describe() after success
-        return true;
+        return player.move(dir, templeMap);
     }
 
     // room-name teleport among neighbors
     const int cur = player.getCurrentRoom();
-    auto it = roomConnections.find(cur);
-    if (it == roomConnections.end()) { std::cout << "You can't move from here.\n"; return false; }
-
-    const std::string t = toLower(target);
-    for (const auto& kv : it->second) {
-        const int idx = kv.second;
-        if (toLower(rooms[idx].getName()) == t) {
+    const int idx = templeMap.indexByTitle(target);
+    for (int d = 0; idx >= 0 && d < kDirCount; ++d) {
+        if (templeMap.exit(cur, static_cast<Dir>(d)) == idx) {
             player.setCurrentRoom(idx);
             return true;
         }
@@ -607,13 +806,29 @@ void Game::runLysaiaPrologue() {
 
     // IMPORTANT: one controller, one run. No pre-describe, no second run.
     PrologueController prologue(hooks);
-    prologue.run();
+    prologue.run(g_cancel, g_idle);
 }
 
 
 
 
 Game::Game() : isRunning(true) {
+    wireEvents();
+}
+
+// Who reacts to what. New systems (telemetry, achievements, autosave) subscribe here.
+void Game::wireEvents() {
+    auto known = [this](int id) { return id >= 0 && id < static_cast<int>(rooms.size()); };
+    g_events.subscribe([this, known](const RoomEntered& e) {
+        if (known(e.room)) WriteLocationEntry(rooms[e.room].getName());
+    });
+    g_events.subscribe([this, known](const RoomEntered& e) {
+        if (known(e.room)) PickUpFragments(e.room);
+    });
+    g_events.subscribe([](const ItemGained&) { g_stopTravel = true; });
+    g_events.subscribe(WatchForEndings);
+    g_events.subscribe(WatchStatEndings);
+    g_events.subscribe(ScheduleHallucination);
 }
 
 
@@ -626,12 +841,13 @@ void Game::startLysaiaPrologue() {
     journalManager.unlockLysaiaJournal();
 
     rooms.clear();
+    g_items.clear();
     shrineRegistry.clear();
-    roomConnections.clear();
+    templeMap.clear();
     lastEnteredRoom_ = -1; 
 
     // ===== Main Hall =====
-    rooms.push_back(Room(
+    addRoom(Room(
         "Main Hall of the Temple",
         "Sunlight streams through high windows, casting bright patterns across polished marble. The air is warm, "
         "and the faint sound of lyres drifts from unseen corridors."
@@ -642,39 +858,39 @@ void Game::startLysaiaPrologue() {
     Shrine demeter("Demeter", "Hall of Plenty");
     demeter.setState(ShrineState::UNCORRUPTED);
     shrineRegistry[0] = demeter;
-    rooms.push_back(Room("Garden of Blooming Faces",
+    addRoom(Room("Garden of Blooming Faces",
         "A peaceful garden of carved masks, each smiling serenely. Ivy and flowers weave gently between them, "
         "and the air is heavy with the scent of ripe fruit."));
-    rooms.push_back(Room("Threaded Womb",
+    addRoom(Room("Threaded Womb",
         "Soft woven cloth drapes the walls, dyed in warm golds and greens. In the center rests a cradle, "
         "adorned with fresh flowers and resting quietly."));
-    rooms.push_back(Room("Hall of Plenty",
+    addRoom(Room("Hall of Plenty",
         "Rows of tables are laden with bread, grain, and ripe fruit. The distant hum of bees echoes softly.", true, 0));
 
     // ===== Nyx =====
     Shrine nyx("Nyx", "The Star-Bound Well");
     nyx.setState(ShrineState::UNCORRUPTED);
     shrineRegistry[1] = nyx;
-    rooms.push_back(Room("Room of Gentle Horizons",
+    addRoom(Room("Room of Gentle Horizons",
         "The walls curve seamlessly into floor and ceiling. A faint, soft starlight fills the air, "
         "as though the sky itself has come inside."));
-    rooms.push_back(Room("Nest of Wings",
+    addRoom(Room("Nest of Wings",
         "Feathers drift lazily from above, white and clean. In the center, a nest woven of pale reeds rests, "
         "warm from the touch of something unseen."));
-    rooms.push_back(Room("The Star-Bound Well",
+    addRoom(Room("The Star-Bound Well",
         "A perfectly round well reflects the stars, even in daylight. The water is still, yet seems impossibly deep.", true, 1));
 
     // ===== Apollo =====
     Shrine apollo("Apollo", "Echoing Gallery");
     apollo.setState(ShrineState::UNCORRUPTED);
     shrineRegistry[2] = apollo;
-    rooms.push_back(Room("Hall of Echoes",
+    addRoom(Room("Hall of Echoes",
         "Marble columns sing softly when touched by the wind. Every sound here returns as music, "
         "layered and harmonious."));
-    rooms.push_back(Room("Room That Remembers",
+    addRoom(Room("Room That Remembers",
         "Polished stone reflects your image clearly. When you move, your reflection follows perfectly, "
         "and the air smells faintly of cedar and sunlight."));
-    rooms.push_back(Room("Echoing Gallery",
+    addRoom(Room("Echoing Gallery",
         "A long hallway of golden mosaics, each panel telling a story in vibrant color. "
         "A warm breeze stirs the air.", true, 2));
 
@@ -682,73 +898,74 @@ void Game::startLysaiaPrologue() {
     Shrine hecate("Hecate", "The Luminous Path");
     hecate.setState(ShrineState::UNCORRUPTED);
     shrineRegistry[3] = hecate;
-    rooms.push_back(Room("Loom of Names",
+    addRoom(Room("Loom of Names",
         "Threads of silk stretch across a great frame, each glowing faintly. The sound of weaving is calm and steady."));
-    rooms.push_back(Room("Listening Chamber",
+    addRoom(Room("Listening Chamber",
         "Shells line the walls, carrying the sound of the sea. When you speak, the shells sing your words back in harmony."));
-    rooms.push_back(Room("The Luminous Path",
+    addRoom(Room("The Luminous Path",
         "Lanterns guide the way forward, their flames steady. The path is straight, and the air feels safe.", true, 3));
 
     // ===== Persephone =====
     Shrine persephone("Persephone", "The Blooming Spring");
     persephone.setState(ShrineState::UNCORRUPTED);
     shrineRegistry[4] = persephone;
-    rooms.push_back(Room("Hall of Petals",
+    addRoom(Room("Hall of Petals",
         "Petals drift down from unseen branches, gathering softly on the floor. Their fragrance is sweet and light."));
-    rooms.push_back(Room("Orchard Walk",
+    addRoom(Room("Orchard Walk",
         "Rows of fruit trees stand heavy with blossoms, their branches gently swaying in a warm breeze."));
-    rooms.push_back(Room("The Blooming Spring",
+    addRoom(Room("The Blooming Spring",
         "A clear spring flows gently, surrounded by flowers in full bloom. The air hums with bees and distant laughter.", true, 4));
 
     // ===== Pan =====
     Shrine pan("Pan", "Verdant Rotunda");
     pan.setState(ShrineState::UNCORRUPTED);
     shrineRegistry[5] = pan;
-    rooms.push_back(Room("Hall of Living Wood",
+    addRoom(Room("Hall of Living Wood",
         "The walls are carved from living trees, their leaves whispering overhead. The smell of earth and moss is fresh and clean."));
-    rooms.push_back(Room("Den of Antlers",
+    addRoom(Room("Den of Antlers",
         "Antlers adorn the walls, polished and unbroken. The floor is covered in soft ferns, and somewhere, a flute plays."));
-    rooms.push_back(Room("Verdant Rotunda",
+    addRoom(Room("Verdant Rotunda",
         "A round chamber open to the sky, where ivy climbs the stone walls and birds nest in the beams.", true, 5));
 
     // ===== False Hermes =====
     Shrine falseHermes("False Hermes", "Gilded Hallway");
     falseHermes.setState(ShrineState::UNCORRUPTED);
     shrineRegistry[6] = falseHermes;
-    rooms.push_back(Room("Room of Borrowed Things",
+    addRoom(Room("Room of Borrowed Things",
         "Neatly arranged items rest on shelves, each labeled with care. A faint smell of parchment fills the air."));
-    rooms.push_back(Room("Whispering Hall",
+    addRoom(Room("Whispering Hall",
         "Words are etched in flowing script across the walls, each telling a gentle tale. The sound of quills scratching is faintly heard."));
-    rooms.push_back(Room("Gilded Hallway",
+    addRoom(Room("Gilded Hallway",
         "Golden panels reflect your image in warm light. The floor is swept clean, and the air smells of incense.", true, 6));
 
     // ===== Thanatos =====
     Shrine thanatos("Thanatos", "Hall of Quiet Rest");
     thanatos.setState(ShrineState::UNCORRUPTED);
     shrineRegistry[7] = thanatos;
-    rooms.push_back(Room("Room of Waiting Lights",
+    addRoom(Room("Room of Waiting Lights",
         "Lanterns hang in still air, each burning steadily. The silence here is peaceful and complete."));
-    rooms.push_back(Room("Waiting Room",
+    addRoom(Room("Waiting Room",
         "Cushioned benches face a great window where clouds drift by slowly. A pot of tea sits untouched on a table."));
-    rooms.push_back(Room("Hall of Quiet Rest",
+    addRoom(Room("Hall of Quiet Rest",
         "Tall doors open onto a calm garden where no wind stirs. The only sound is the quiet hum of the earth.", true, 7));
 
     // ===== Eris =====
     Shrine eris("Eris", "Hall of Harmony");
     eris.setState(ShrineState::UNCORRUPTED);
     shrineRegistry[8] = eris;
-    rooms.push_back(Room("Throat of the Temple",
+    addRoom(Room("Throat of the Temple",
         "A wide, bright corridor where banners sway gently. Sunlight spills in through high arches."));
-    rooms.push_back(Room("Oracle’s Wake",
+    addRoom(Room("Oracle’s Wake",
         "A polished altar draped in white cloth. Candles burn steadily, their wax dripping slowly onto silver trays."));
-    rooms.push_back(Room("Archivist’s Cell",
+    addRoom(Room("Archivist’s Cell",
         "A tidy desk stacked with neatly bound books. The air smells of ink and lavender, and a quill rests in an open journal."));
-    rooms.push_back(Room("Hall of Harmony",
+    addRoom(Room("Hall of Harmony",
         "A vaulted chamber filled with soft music and the glow of stained glass. Dust motes drift in the warm light.", true, 8));
 
     player.setCurrentRoom(indexByTitle("Main Hall of the Temple"));
     setupPrologueConnectionsByTitle();
-    lastEnteredRoom_ = -1; // ensure OnRoomEntered won't suppress first render
+    indexWorld("Lysaia's temple");
+    lastEnteredRoom_ = -1; // ensure RoomEntered isn't suppressed on first render
 
     // now run the 7-day loop
     runLysaiaPrologue();
@@ -775,10 +992,12 @@ void Game::syncInputAfterPrologue() {
 }
 
 void Game::beginMelasRun() {
-    SceneManager::introScene();
+    SceneManager::introScene(g_cancel, g_idle);
 
     // Fresh state for a clean run
     g_flags.clear();
+    g_events.discard();
+    g_ending = -1;
     lastEnteredRoom_ = -1;
     firstFramePrinted_ = false;
 
@@ -786,10 +1005,24 @@ void Game::beginMelasRun() {
     ThemeRegistry::setDefaultShrineState(ShrineState::CORRUPTED);
 
     loadRooms();
+    placeItems();
+    SpawnWanderers(templeMap);
 
-    // Do NOT pre-print here; gameLoop will print once and trigger OnRoomEntered
-    gameLoop();
+    // Do NOT pre-print or loop here; the menu runs beginDescent() + gameLoop(),
+    // which prints once and posts RoomEntered
 }
+// Fragments where they were written, or (--scatter) somewhere new each descent.
+void Game::placeItems() {
+    if (!scatter_) {
+        for (const std::string& title : g_items.place(templeMap, PersephoneFragmentSpawns()))
+            std::cerr << "spawn table names an unknown room: " << title << "\n";
+        return;
+    }
+    const std::uint32_t seed = scatterSeed_ ? scatterSeed_ : std::random_device{}();
+    scatterSeed_ = 0;   // a fixed seed is for the first descent only
+    g_items.scatter(templeMap, PersephoneFragmentSpawns(), seed, indexByTitle("Main Hall of the Temple"));
+}
+
 void Game::beginDescent() {
     phase_ = Phase::Intro;
 
@@ -806,6 +1039,7 @@ void Game::beginDescent() {
 
     // After ENTER, we are officially in-game. Print the starting room ONCE.
     phase_ = Phase::InGame;
+    ScheduleAmbience();   // the clock starts now, not at the title
     describeCurrentRoom();
     firstFramePrinted_ = true;
 }
@@ -815,7 +1049,7 @@ void Game::printTitleBlock() {
 
 void Game::waitForEnter() {
     std::string _;
-    std::getline(std::cin, _);
+    readLineOrCancel(_, g_cancel, g_idle);
 }
 
 
@@ -833,14 +1067,7 @@ void Game::displayMainMenu() {
             << "Choice: ";
 
         std::string choice;
-        if (!std::getline(std::cin, choice)) {
-            // Recover from stray EOF/fail and re-prompt
-            if (std::cin.fail() || std::cin.eof()) {
-                std::cin.clear();
-                continue; // redraw menu
-            }
-            return; // truly broken input; exit
-        }
+        if (!readLineOrCancel(choice, g_cancel, g_idle)) return;   // input gone: leave
 
         // normalize to first non-space character
         char c = 0;
@@ -875,28 +1102,83 @@ void Game::displayMainMenu() {
 
 
 
+// Walk the shortest route one room at a time so every room on the way gets its
+// RoomEntered side effects and a turn: timers and wanderers move as if each
+// step were typed. Stops early if a room turns something up, something comes
+// in, or an ending is reached. Only rooms already visited (unfogged on the
+// map) can be named.
+void Game::travelTo(const std::string& title) {
+    const int target = indexByTitle(title);
+    if (target < 0 || !mapView_.isVisited(target)) {
+        std::cout << "You know of no place called '" << title << "'.\n";
+        return;
+    }
+
+    int cur = player.getCurrentRoom();
+    if (cur == target) {
+        std::cout << "You are already there.\n";
+        return;
+    }
+    if (paths_.next(cur, target) < 0) {
+        std::cout << "No corridor you know of leads there.\n";
+        return;
+    }
+
+    while (cur != target) {
+        cur = paths_.next(cur, target);
+        if (cur < 0) break;                 // table out of date; stay where we are
+        player.setCurrentRoom(cur);
+        if (cur == target) break;           // describeCurrentRoom() handles arrival
+        visitRoom(cur);
+
+        std::cout << "You pass through " << rooms[cur].getName() << ".\n";
+        if (inPrologue_) continue;
+        // Deliver this room's events now: a pickup here (ItemGained) stops the walk.
+        g_stopTravel = false;
+        g_events.post(RoomEntered{cur, true});
+        g_events.flush();
+        lastEnteredRoom_ = cur;
+        PassTurn(cur);
+        g_events.flush();
+        if (g_ending >= 0) return;          // gameLoop plays it
+        if (g_stopTravel) {
+            std::cout << "Something here makes you stop.\n";
+            break;
+        }
+    }
+    describeCurrentRoom();
+    if (!inPrologue_) PassTurn(player.getCurrentRoom());
+}
+
 void Game::showMap() {
-    std::cout << "\n";
-    templeMap.printAscii();
-    templeMap.printAdjacency();
+    mapView_.setStyle(accessibility_, ThemeRegistry::getDefaultShrineState());
+    const std::string& text = mapView_.render(player.getCurrentRoom());
+    std::cout.write(text.data(), static_cast<std::streamsize>(text.size()));
+    std::cout.flush();
 }
 
 void Game::start() {
     startLysaiaPrologue();      // plays 7 days and returns
-    syncInputAfterPrologue();   // <-- clear any leftover input/EOF
-    phase_ = Phase::MainMenu;
-    displayMainMenu();          // menu loop
+    if (!g_cancel.cancelled()) {
+        syncInputAfterPrologue();   // <-- clear any leftover input/EOF
+        phase_ = Phase::MainMenu;
+        displayMainMenu();          // menu loop
+    }
+    if (g_cancel.reason() == CancelToken::Reason::Timeout)
+        std::cout << "\nThe candles burn down while you stand there. The temple lets you go.\n";
 }
 
+void Game::setInputTimeout(std::chrono::milliseconds idle) { g_idle = idle; }
+
 
 
 void Game::loadRooms() {
     rooms.clear();
     shrineRegistry.clear();
-    roomConnections.clear();
+    templeMap.clear();
     lastEnteredRoom_ = -1;  
     // ===== Main Hall =====
-    rooms.push_back(Room(
+    addRoom(Room(
         "Main Hall of the Temple",
         "Massive pillars rise toward a shadowed ceiling. Faded mosaics depict gods whose eyes seem to follow you. "
         "Eight arched corridors lead away into darkness, each humming faintly with a presence."
@@ -907,142 +1189,179 @@ void Game::loadRooms() {
     Shrine demeter("Demeter", "The Hall of Hunger");
     demeter.setState(ShrineState::CORRUPTED);
     shrineRegistry[0] = demeter;
-    rooms.push_back(Room("The Garden of Broken Faces", "Masks litter the overgrown path—some smiling, some cracked in despair. A vine-covered mirror stands at the center, reflecting only strangers", false));
-    rooms.push_back(Room("The Threadbare Womb", "The walls are made of fibrous, pulsing material—almost alive. A faint heartbeat hums under your feet. An empty cradle sits in the center, rocking gently though no one is near.", false));
-    rooms.push_back(Room("The Hall of Hunger", "Withered olive trees claw at the cracked marble. Bowls overflow with bloated grain—writhing, weeping, moving. The air stinks of soured milk and blood turned syrup-thick. Vines sprawl across the floor like the intestines of slaughtered offerings, knotted and twitching. You hear chewing—but nothing moves.", true, 0));
+    addRoom(Room("The Garden of Broken Faces", "Masks litter the overgrown path—some smiling, some cracked in despair. A vine-covered mirror stands at the center, reflecting only strangers", false));
+    addRoom(Room("The Threadbare Womb", "The walls are made of fibrous, pulsing material—almost alive. A faint heartbeat hums under your feet. An empty cradle sits in the center, rocking gently though no one is near.", false));
+    addRoom(Room("The Hall of Hunger", "Withered olive trees claw at the cracked marble. Bowls overflow with bloated grain—writhing, weeping, moving. The air stinks of soured milk and blood turned syrup-thick. Vines sprawl across the floor like the intestines of slaughtered offerings, knotted and twitching. You hear chewing—but nothing moves.", true, 0));
 
     // ===== Nyx =====
     Shrine nyx("Nyx", "The Starless Well");
     nyx.setState(ShrineState::CORRUPTED);
     shrineRegistry[1] = nyx;
-    rooms.push_back(Room("Room With No Corners", "The walls curve softly into one another. There are no shadows, no edges. You always feel like you’re at the center—even when walking. Something breathes in rhythm with you.", false));
-    rooms.push_back(Room("Nest of Wings", "The ceiling is unseen. Black feathers drift downward. A nest of glass bones sits abandoned. You’re certain you heard wings—but only once.", false));
-    rooms.push_back(Room("The Starless Well", "A smooth pit swallows light and sound. Glyphs etched into obsidian pulse faintly—recognizable and wrong. When you lean over the edge, your shadow vanishes. Something down there watches, not with eyes, but with intention. You forget why you’re breathing.", true, 1));
+    addRoom(Room("Room With No Corners", "The walls curve softly into one another. There are no shadows, no edges. You always feel like you’re at the center—even when walking. Something breathes in rhythm with you.", false));
+    addRoom(Room("Nest of Wings", "The ceiling is unseen. Black feathers drift downward. A nest of glass bones sits abandoned. You’re certain you heard wings—but only once.", false));
+    addRoom(Room("The Starless Well", "A smooth pit swallows light and sound. Glyphs etched into obsidian pulse faintly—recognizable and wrong. When you lean over the edge, your shadow vanishes. Something down there watches, not with eyes, but with intention. You forget why you’re breathing.", true, 1));
 
     // ===== Apollo =====
     Shrine apollo("Apollo", "Echoing Gallery");
     apollo.setState(ShrineState::CORRUPTED);
     shrineRegistry[2] = apollo;
-    rooms.push_back(Room("Hall of Echoes", "Every step you take repeats a second later—just slightly out of sync. A chorus murmurs words you almost recognize. If you speak, something replies from behind.", false));
-    rooms.push_back(Room("Room That Remembers", "Every surface is mirrored, but you’re never alone. Sometimes your reflection lags. Sometimes it moves first. Sometimes it’s gone entirely—but you still feel watched.", false));
-    rooms.push_back(Room("Echoing Gallery", "Mirrors line the walls, angled just wrong. They show you—but older, injured, smiling. The statues have mouths but no faces. You swear one whispered your name, the one you haven’t heard since childhood. But it didn’t speak. Or did it?", true, 2));
+    addRoom(Room("Hall of Echoes", "Every step you take repeats a second later—just slightly out of sync. A chorus murmurs words you almost recognize. If you speak, something replies from behind.", false));
+    addRoom(Room("Room That Remembers", "Every surface is mirrored, but you’re never alone. Sometimes your reflection lags. Sometimes it moves first. Sometimes it’s gone entirely—but you still feel watched.", false));
+    addRoom(Room("Echoing Gallery", "Mirrors line the walls, angled just wrong. They show you—but older, injured, smiling. The statues have mouths but no faces. You swear one whispered your name, the one you haven’t heard since childhood. But it didn’t speak. Or did it?", true, 2));
 
     // ===== Hecate =====
     Shrine hecate("Hecate", "The Unlit Path");
     hecate.setState(ShrineState::CORRUPTED);
     shrineRegistry[3] = hecate;
-    rooms.push_back(Room("Loom of Names", "Threads hang like veins, each labeled in ink. One bears your name. Another is frayed. The loom creaks but never stops. Something is weaving nearby, just out of sight.", false));
-    rooms.push_back(Room("Listening Chamber", "Shells line the walls, hung like ears. Some whisper forgotten hymns. Others sob. When you breathe, a shell beside you repeats it a beat too late.", false));
-    rooms.push_back(Room("The Unlit Path", "Three stone doors. One burns with blue flame, one drips something thick, one is just absence. Candle stubs mark the walls in patterns that shift when unobserved. The torchlight flickers—but the shadows don’t match your shape. One shadow walks when you don’t.", true, 3));
+    addRoom(Room("Loom of Names", "Threads hang like veins, each labeled in ink. One bears your name. Another is frayed. The loom creaks but never stops. Something is weaving nearby, just out of sight.", false));
+    addRoom(Room("Listening Chamber", "Shells line the walls, hung like ears. Some whisper forgotten hymns. Others sob. When you breathe, a shell beside you repeats it a beat too late.", false));
+    addRoom(Room("The Unlit Path", "Three stone doors. One burns with blue flame, one drips something thick, one is just absence. Candle stubs mark the walls in patterns that shift when unobserved. The torchlight flickers—but the shadows don’t match your shape. One shadow walks when you don’t.", true, 3));
 
     // ===== Persephone =====
     Shrine persephone("Persephone", "The Frozen Spring");
     persephone.setState(ShrineState::CORRUPTED);
     shrineRegistry[4] = persephone;
-    rooms.push_back(Room("Hall of Petals", "Petals fall stiff and brittle, shattering when they hit the floor. Frost rims each fragment, though the air smells of funeral incense.", false));
-    rooms.push_back(Room("Orchard Walk", "Each tree weeps slow rivulets that freeze mid-drip, like tears caught in the act of falling.", false));
-    rooms.push_back(Room("The Frozen Spring", "A fountain of vines now fossilized, curled in agony. Ice creeps up the edges of the walls, though the air is warm. A lone pomegranate seed rests in a cracked bowl. It has not rotted. It will not. The room smells of rotting flowers and ash...You feel mourned.", true, 4));
+    addRoom(Room("Hall of Petals", "Petals fall stiff and brittle, shattering when they hit the floor. Frost rims each fragment, though the air smells of funeral incense.", false));
+    addRoom(Room("Orchard Walk", "Each tree weeps slow rivulets that freeze mid-drip, like tears caught in the act of falling.", false));
+    addRoom(Room("The Frozen Spring", "A fountain of vines now fossilized, curled in agony. Ice creeps up the edges of the walls, though the air is warm. A lone pomegranate seed rests in a cracked bowl. It has not rotted. It will not. The room smells of rotting flowers and ash...You feel mourned.", true, 4));
 
     // ===== Pan =====
     Shrine pan("Pan", "Wild Rotunda");
     pan.setState(ShrineState::CORRUPTED);
     shrineRegistry[5] = pan;
-    rooms.push_back(Room("Hall of Shivering Meat", "Walls pulse with veins beneath translucent skin. Occasionally, a muscle twitches in the stone. A single pan flute lies on the ground—when touched, it plays a bleating cry.", false));
-    rooms.push_back(Room("Den of Antlers", "Bones and antlers are fused into the architecture. The floor is covered in fur—not all of it animal. Something stalks just out of view, its gait rhythmic, almost... joyful.", false));
-    rooms.push_back(Room("Wild Rotunda", "The walls pulse with root-veined moss, soft and warm as skin. Bones protrude from the growth—dancing mid-step, arms locked in joy or agony. Laughter echoes, then sobs, then silence. A damp breath tickles your neck, and no one is there.", true, 5));
+    addRoom(Room("Hall of Shivering Meat", "Walls pulse with veins beneath translucent skin. Occasionally, a muscle twitches in the stone. A single pan flute lies on the ground—when touched, it plays a bleating cry.", false));
+    addRoom(Room("Den of Antlers", "Bones and antlers are fused into the architecture. The floor is covered in fur—not all of it animal. Something stalks just out of view, its gait rhythmic, almost... joyful.", false));
+    addRoom(Room("Wild Rotunda", "The walls pulse with root-veined moss, soft and warm as skin. Bones protrude from the growth—dancing mid-step, arms locked in joy or agony. Laughter echoes, then sobs, then silence. A damp breath tickles your neck, and no one is there.", true, 5));
 
     // ===== False Hermes =====
     Shrine falseHermes("False Hermes", "Gilded Hallway");
     falseHermes.setState(ShrineState::CORRUPTED);
     shrineRegistry[6] = falseHermes;
-    rooms.push_back(Room("Room of Borrowed Things", "Shelves display small, mundane objects—combs, rings, sandals, letters. Each is labeled with a name you don’t recognize. One item is missing, but its tag reads your name. A drawer creaks open behind you.", false));
-    rooms.push_back(Room("Whispering Hall", "Words are etched into every surface. None are repeated. The longer you stare, the more familiar the languages seem—until you find your own handwriting, carved deep and frantic.", false));
-    rooms.push_back(Room("Gilded Hallway", "The marble gleams too clean. The walls shimmer like heatstroke. A friendly shrine waits at the end, grinning with a mouth it doesn’t have. You walk twenty-one steps. You always walk twenty-one steps. You don’t remember starting, but you’re always in motion.", true, 6));
+    addRoom(Room("Room of Borrowed Things", "Shelves display small, mundane objects—combs, rings, sandals, letters. Each is labeled with a name you don’t recognize. One item is missing, but its tag reads your name. A drawer creaks open behind you.", false));
+    addRoom(Room("Whispering Hall", "Words are etched into every surface. None are repeated. The longer you stare, the more familiar the languages seem—until you find your own handwriting, carved deep and frantic.", false));
+    addRoom(Room("Gilded Hallway", "The marble gleams too clean. The walls shimmer like heatstroke. A friendly shrine waits at the end, grinning with a mouth it doesn’t have. You walk twenty-one steps. You always walk twenty-one steps. You don’t remember starting, but you’re always in motion.", true, 6));
 
     // ===== Thanatos =====
     Shrine thanatos("Thanatos", "Sleepwalker’s Alcove");
     thanatos.setState(ShrineState::CORRUPTED);
     shrineRegistry[7] = thanatos;
-    rooms.push_back(Room("Room of Waiting Lights", "Hundreds of unlit candles line the floor. One flickers to life when you step inside, then another. None provide warmth. The air smells like burnt honey and salt.", false));
-    rooms.push_back(Room("The Bloodclock", "A massive pendulum drips red into an unseen basin. It beats steadily—too slowly to match your pulse. On the wall: ■ν α■µατι χρ■νου. ('In the blood of time.')", false));
-    rooms.push_back(Room("Sleepwalker’s Alcove", "A stone bed rests beneath an unlit arch. The room is warm—not comfort, but absence of discomfort. Laurel leaves line the floor, pale and dry. The silence here is full, whole. You think about lying down. Just for a moment. You imagine how easy it would be to stay. You do not remember why that’s a problem.", true, 7));
+    addRoom(Room("Room of Waiting Lights", "Hundreds of unlit candles line the floor. One flickers to life when you step inside, then another. None provide warmth. The air smells like burnt honey and salt.", false));
+    addRoom(Room("The Bloodclock", "A massive pendulum drips red into an unseen basin. It beats steadily—too slowly to match your pulse. On the wall: ■ν α■µατι χρ■νου. ('In the blood of time.')", false));
+    addRoom(Room("Sleepwalker’s Alcove", "A stone bed rests beneath an unlit arch. The room is warm—not comfort, but absence of discomfort. Laurel leaves line the floor, pale and dry. The silence here is full, whole. You think about lying down. Just for a moment. You imagine how easy it would be to stay. You do not remember why that’s a problem.", true, 7));
 
     // ===== Eris =====
     Shrine eris("Eris", "The Bone Choir");
     eris.setState(ShrineState::CORRUPTED);
     shrineRegistry[8] = eris;
-    rooms.push_back(Room("Throat of the Temple", "The corridor narrows slowly behind you. The walls are damp and warm to the touch. You hear a low, slow heartbeat. Every step echoes like a swallowed breath.", false));
-    rooms.push_back(Room("Oracle’s Wake", "Candles flicker in defiance of windless dark. A defaced altar bleeds wax. Someone scratched 'I won’t lie again' into the stone 27 times.", false));
-    rooms.push_back(Room("Archivist’s Cell", "A rusted desk faces the wall. Dozens of inked notes are nailed above it—each crossed out violently. Scratched into the desk: 'It was true. That’s the problem.' The chair is still warm.", false));
-    rooms.push_back(Room("The Bone Choir", "The bones are arranged in reverent poses, facing each other in song. Their mouths hang wide in eternal performance. The acoustics claw at your skull—discordant, divine, unending. Your ears bleed, or maybe your thoughts do. Their hymn harmonizes with your name.", true, 8));
+    addRoom(Room("Throat of the Temple", "The corridor narrows slowly behind you. The walls are damp and warm to the touch. You hear a low, slow heartbeat. Every step echoes like a swallowed breath.", false));
+    addRoom(Room("Oracle’s Wake", "Candles flicker in defiance of windless dark. A defaced altar bleeds wax. Someone scratched 'I won’t lie again' into the stone 27 times.", false));
+    addRoom(Room("Archivist’s Cell", "A rusted desk faces the wall. Dozens of inked notes are nailed above it—each crossed out violently. Scratched into the desk: 'It was true. That’s the problem.' The chair is still warm.", false));
+    addRoom(Room("The Bone Choir", "The bones are arranged in reverent poses, facing each other in song. Their mouths hang wide in eternal performance. The acoustics claw at your skull—discordant, divine, unending. Your ears bleed, or maybe your thoughts do. Their hymn harmonizes with your name.", true, 8));
 
     setupConnections();
+    placeAltars();
+    indexWorld("Melas' temple");
+}
+
+// Shrines bound to rooms by assets/altars.txt rather than above, so a module
+// shrine gets a room and a corridor without touching this file. The room
+// joins the wing it opens off (that deity's colours on the map). Skipped if
+// its shrine isn't loaded or the way in is already a corridor.
+void Game::placeAltars() {
+    std::vector<AltarSpec> altars;
+    std::string error;
+    if (!LoadAltars("assets/altars.txt", altars, error)) {
+        std::cerr << "altars " << error << " (none placed)\n";
+        return;
+    }
+    int shrineId = 0;
+    for (const auto& kv : shrineRegistry) shrineId = std::max(shrineId, kv.first + 1);
+
+    for (const AltarSpec& a : altars) {
+        const ShrineHandlerId handler = Shrines().find(a.shrine);
+        if (handler == kQuietShrine) continue;   // its module isn't here
+        const int from = indexByTitle(a.from);
+        if (from < 0 || templeMap.exit(from, a.dir) >= 0 || indexByTitle(a.room) >= 0) {
+            std::cerr << "altars: no way to place " << a.shrine << " off '" << a.from << "'\n";
+            continue;
+        }
+        Shrine shrine(Shrines().get(handler).label, a.room);
+        shrine.setState(ShrineState::CORRUPTED);
+        shrineRegistry[shrineId] = shrine;
+        rooms.push_back(Room(a.room, a.description, true, shrineId++));
+        const int room = templeMap.addNode(a.room, true, templeMap.nodes()[from].deity,
+                                           Shrines().get(handler).key + "/shrine");
+        templeMap.addEdge(from, a.dir, room);
+        templeMap.addEdge(room, oppositeDir(a.dir), from);
+    }
 }
 
 
 void Game::setupConnections() {
-    // Main Hall spokes
+    // Main Hall spokes (each wing also gets one-way quick returns to 0)
     addEdge(0, "north",     1);
     addEdge(0, "northeast", 4);
     addEdge(0, "east",      7);
     addEdge(0, "southeast", 10);
     addEdge(0, "south",     13);
     addEdge(0, "southwest", 16);
-    addEdge(0, "west",      19);
+    addReturn(0, "west",    19);   // False Hermes: the way back is north, not east
     addEdge(0, "northwest", 22);
     addEdge(0, "up",        25);
 
     // Demeter (1–3)
     addEdge(1, "east", 2); addEdge(2, "west", 1);
     addEdge(2, "east", 3); addEdge(3, "west", 2);
-    addEdge(1, "south", 0); addEdge(2, "south", 0); addEdge(3, "south", 0);
+    addReturn(1, "south", 0); addReturn(2, "south", 0); addReturn(3, "south", 0);
 
     // Nyx (4–6)
     addEdge(4, "east", 5); addEdge(5, "west", 4);
     addEdge(5, "east", 6); addEdge(6, "west", 5);
-    addEdge(4, "southwest", 0); addEdge(5, "southwest", 0); addEdge(6, "southwest", 0);
+    addReturn(4, "southwest", 0); addReturn(5, "southwest", 0); addReturn(6, "southwest", 0);
 
     // Apollo (7–9)
     addEdge(7, "east", 8); addEdge(8, "west", 7);
     addEdge(8, "east", 9); addEdge(9, "west", 8);
-    addEdge(7, "west", 0); addEdge(8, "west", 0); addEdge(9, "west", 0);
+    addReturn(7, "west", 0);   // west is the corridor back from 8 and 9
 
     // Hecate (10–12)
     addEdge(10, "east", 11); addEdge(11, "west", 10);
     addEdge(11, "east", 12); addEdge(12, "west", 11);
-    addEdge(10, "northwest", 0); addEdge(11, "northwest", 0); addEdge(12, "northwest", 0);
+    addReturn(10, "northwest", 0); addReturn(11, "northwest", 0); addReturn(12, "northwest", 0);
 
     // Persephone (13–15)
     addEdge(13, "east", 14); addEdge(14, "west", 13);
     addEdge(14, "east", 15); addEdge(15, "west", 14);
-    addEdge(13, "north", 0); addEdge(14, "north", 0); addEdge(15, "north", 0);
+    addReturn(13, "north", 0); addReturn(14, "north", 0); addReturn(15, "north", 0);
 
     // Pan (16–18)
     addEdge(16, "east", 17); addEdge(17, "west", 16);
     addEdge(17, "east", 18); addEdge(18, "west", 17);
-    addEdge(16, "northeast", 0); addEdge(17, "northeast", 0); addEdge(18, "northeast", 0);
+    addReturn(16, "northeast", 0); addReturn(17, "northeast", 0); addReturn(18, "northeast", 0);
 
     // False Hermes (19–21)
     addEdge(19, "east", 20); addEdge(20, "west", 19);
     addEdge(20, "east", 21); addEdge(21, "west", 20);
-    addEdge(19, "north", 0); addEdge(20, "north", 0); addEdge(21, "north", 0);
+    addReturn(19, "north", 0); addReturn(20, "north", 0); addReturn(21, "north", 0);
 
     // Thanatos (22–24)
     addEdge(22, "east", 23); addEdge(23, "west", 22);
     addEdge(23, "east", 24); addEdge(24, "west", 23);
-    addEdge(22, "southeast", 0); addEdge(23, "southeast", 0); addEdge(24, "southeast", 0);
+    addReturn(22, "southeast", 0); addReturn(23, "southeast", 0); addReturn(24, "southeast", 0);
 
     // Eris (25–28)
     addEdge(25, "east", 26); addEdge(26, "west", 25);
     addEdge(26, "east", 27); addEdge(27, "west", 26);
     addEdge(27, "east", 28); addEdge(28, "west", 27);
-    addEdge(25, "down", 0); addEdge(26, "down", 0); addEdge(27, "down", 0); addEdge(28, "down", 0);
+    addReturn(25, "down", 0); addReturn(26, "down", 0); addReturn(27, "down", 0); addReturn(28, "down", 0);
 }
 
 
-void Game::handleCommand(const std::string& input) {
+// True if the command took game time (a step, a shrine, a journal entry);
+// looking, help, settings and anything not understood don't.
+bool Game::handleCommand(const std::string& input) {
     const std::string raw = trim_copy(input);
-    if (raw.empty()) { std::cout << "...\n"; return; }
+    if (raw.empty()) { std::cout << "...\n"; return false; }
 
     const auto [first, rest] = split_first(raw);
     const std::string cmd = toLower(raw); // full lowercased command for single-word checks
@@ -1058,19 +1377,24 @@ void Game::handleCommand(const std::string& input) {
     if (is_move_verb(first)) {
         const std::string dir = normalize_dir(rest);
         if (!dir.empty()) {
-            player.move(dir, roomConnections);
+            const bool moved = player.move(dir, templeMap);
             describeCurrentRoom();
-            return;
+            return moved;
+        }
+        // "travel <room>" walks the whole route, a turn per room
+        if (first == "travel" && !rest.empty()) {
+            travelTo(rest);
+            return false;
         }
         std::cout << "Go where? (Try: " << join(directions, ", ") << ")\n";
-        return;
+        return false;
     }
 
     // One-word directions and short forms: "n", "sw", "up", etc.
     if (auto dir = normalize_dir(cmd); !dir.empty()) {
-        player.move(dir, roomConnections);
+        const bool moved = player.move(dir, templeMap);
         describeCurrentRoom();
-        return;
+        return moved;
     }
 
    // ===== Shrine interaction =====
@@ -1078,38 +1402,40 @@ if (cmd == "shrine") {
     const int cur = player.getCurrentRoom();
     if (cur < 0 || cur >= static_cast<int>(rooms.size())) {
         std::cout << "You are nowhere near a shrine.\n";
-        return;
+        return false;
     }
 
     Room& current = rooms[cur];
     if (!current.isShrine()) {
         std::cout << "There is no shrine here.\n";
-        return;
+        return false;
     }
 
     const int shrineID = current.getShrineID();
     auto it = shrineRegistry.find(shrineID);
     if (it == shrineRegistry.end()) {
         std::cout << "The shrine seems dormant.\n";
-        return;
+        return false;
     }
 
     // Optional flavor lead-in (styled per deity/state)
     printShrineText(it->second, "You approach the altar.", /*shake=*/false);
 
     // Mechanics dispatcher (runs the real shrine logic + outcomes/journal)
-    OnShrineInteract(it->second, &journalManager);
-    return;
+    OnShrineInteract(it->second, shrineID, &journalManager);
+    return true;
 }
     // ===== Look around =====
     if (first == "look" || cmd == "look around") {
-       describeCurrentRoom();}
+       describeCurrentRoom();
+       return false;
+    }
 
 
     // ===== Journal =====
     if (cmd == "journal") {
         player.printJournal();
-        return;
+        return false;
     }
     else if (first == "note") {
         // keep original after 'note ' for free-form text
@@ -1117,28 +1443,28 @@ if (cmd == "shrine") {
         int entryNumber;
         if (!(iss >> entryNumber)) {
             std::cout << "Usage: note <entry#> <text>\n";
-            return;
+            return false;
         }
         std::string afterNum;
         std::getline(iss, afterNum);
         if (!afterNum.empty() && afterNum[0] == ' ') afterNum.erase(0, 1);
         if (afterNum.empty()) {
             std::cout << "Write something after the entry number.\n";
-            return;
+            return false;
         }
         player.addJournalNote(entryNumber, afterNum);
         std::cout << "Noted.\n";
-        return;
+        return false;
     }
     else if (first == "inspect") {
         std::istringstream iss(rest);
         int entryNumber;
         if (!(iss >> entryNumber)) {
             std::cout << "Usage: inspect <entry#>\n";
-            return;
+            return false;
         }
         player.inspectJournalEntry(entryNumber - 1); // 0-based
-        return;
+        return false;
     }
 
     // ===== Map (only in Main Hall) =====
@@ -1148,7 +1474,7 @@ if (cmd == "shrine") {
         } else {
             std::cout << "You can only consult the map from the Main Hall.\n";
         }
-        return;
+        return false;
     }
 
     // ===== Write (Melas free-write to current location) =====
@@ -1159,17 +1485,30 @@ if (cmd == "shrine") {
         if (!loc.empty()) {
             journalManager.writeMelasAt(loc);
             std::cout << "(Journal updated.)\n";
-        } else {
-            std::cout << "Your hand hesitates. Nothing here wants to be recorded.\n";
+            return true;
         }
+        std::cout << "Your hand hesitates. Nothing here wants to be recorded.\n";
     }
-    return;
+    return false;
 }
     // ===== Help =====
+    if (cmd == "odds") {
+        g_pstate.access.showOdds = !g_pstate.access.showOdds;
+        std::cout << "Skill check odds: " << (g_pstate.access.showOdds ? "SHOWN" : "HIDDEN") << "\n";
+        return false;
+    }
+    if (cmd == "timed") {
+        g_pstate.access.panFlashMs = g_pstate.access.panFlashMs > 0 ? 0 : 1500;
+        std::cout << "Pan's notes: " << (g_pstate.access.panFlashMs > 0 ? "TIMED (1.5 s, answer against the clock)"
+                                                                        : "UNTIMED") << "\n";
+        return false;
+    }
+
     if (cmd == "help") {
         std::cout << "Commands:\n"
                   << "  Movement: " << join(directions, ", ") << " (also: n, s, e, w, ne, nw, se, sw, u, d)\n"
                   << "            go/move/walk/run/head/travel <direction>\n"
+                  << "  travel <room name>\n"
                   << "  look / look around\n"
                   << "  shrine\n"
                   << "  journal\n"
@@ -1177,12 +1516,15 @@ if (cmd == "shrine") {
                   << "  inspect <entry#>\n"
                   << "  map (Main Hall only)\n"
                   << "  write\n"
+                  << "  odds (show/hide skill check chances)\n"
+                  << "  timed (Pan's notes vanish after a moment, answers are timed)\n"
                   << "  help\n";
-        return;
+        return false;
     }
 
     // ===== Unknown =====
     std::cout << "Unknown command. Type 'help' for a list of commands.\n";
+    return false;
 }
 
 // --- Temporary minimal implementations to satisfy linker ---
@@ -1200,9 +1542,16 @@ void Game::gameLoop() {
     while (isRunning) {
         std::cout << "\n> ";
         std::string line;
-        if (!std::getline(std::cin, line)) break;
+        if (!readLineOrCancel(line, g_cancel, g_idle)) { isRunning = false; break; }
         if (line == "exit" || line == "quit") { isRunning = false; break; }
-        handleCommand(line);
+        if (handleCommand(line)) PassTurn(player.getCurrentRoom());
+        else RunTimers();   // the clock runs on while you read the map
+        g_events.flush();   // this command's side effects, in order
+        if (g_ending >= 0) {
+            SceneManager::endingScene(EndingRules().def(g_ending).title, g_cancel, g_idle);
+            isRunning = false;   // back to the menu
+            break;
+        }
         // No automatic room reprint here.
     }
 }
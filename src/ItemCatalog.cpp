@@ -0,0 +1,58 @@
+// ItemCatalog.cpp
+#include "ItemCatalog.hpp"
+#include <unordered_map>
+
+static const ItemDef kItems[kItemCount] = {
+    {"perse_frag_1", "Letter Fragment (1)",
+     "They say I was dragged screaming… screaming… but the dark was already inside me."},
+    {"perse_frag_2", "Letter Fragment (2)",
+     "I walked here. My eyes open. My hands empty."},
+    {"perse_frag_3", "Letter Fragment (3)",
+     "Hades… on his knees… his hands colder than mine."},
+    {"perse_frag_4", "Letter Fragment (4)",
+     "The shadows dance, or they feed — sometimes I forget which."},
+    {"perse_frag_5", "Letter Fragment (5)",
+     "The dead keep their promises. The living… forget."},
+    {"perse_frag_6", "Letter Fragment (6)",
+     "Better his crown in the stillness than your fields in the wind."},
+    {"perse_frag_7", "Letter Fragment (7)",
+     "Blood dried in the lines of my palms. I tried to wash it… it stayed."},
+    {"perse_frag_8", "Letter Fragment (8)",
+     "I am his. He is mine. I am his. He is mine."},
+};
+
+const ItemDef& ItemInfo(ItemId id) {
+    return kItems[static_cast<int>(id)];
+}
+
+ItemId ItemIdFromKey(const std::string& key) {
+    static const std::unordered_map<std::string, ItemId> kByKey = [] {
+        std::unordered_map<std::string, ItemId> m;
+        for (int i = 0; i < kItemCount; ++i) m.emplace(kItems[i].key, static_cast<ItemId>(i));
+        return m;
+    }();
+    auto it = kByKey.find(key);
+    return (it != kByKey.end()) ? it->second : ItemId::Count;
+}
+
+// --- inventory -----------------------------------------------------------------
+
+void Inventory::add(ItemId id, int charges) {
+    if (id >= ItemId::Count) return;
+    charges_[slot(id)] = static_cast<std::int16_t>(charges_[slot(id)] + charges);
+    syncFragment(id);
+}
+
+bool Inventory::consume(ItemId id) {
+    if (id >= ItemId::Count || charges_[slot(id)] <= 0) return false;
+    --charges_[slot(id)];
+    syncFragment(id);
+    return true;
+}
+
+void Inventory::syncFragment(ItemId id) {
+    if (!IsPersephoneFragment(id)) return;
+    const auto bit = static_cast<std::uint8_t>(1u << (slot(id) - slot(ItemId::PerseFrag1)));
+    if (charges_[slot(id)] > 0) fragments_ |= bit;
+    else                        fragments_ &= static_cast<std::uint8_t>(~bit);
+}
@@ -0,0 +1,50 @@
+// ItemPlacement.cpp
+#include "ItemPlacement.hpp"
+#include <algorithm>
+#include <random>
+
+void ItemPlacement::reset(int rooms) {
+    here_.assign(static_cast<std::size_t>(std::max(rooms, 0)), 0);
+    count_ = 0;
+}
+
+void ItemPlacement::add(int room, ItemId item) {
+    if (count_ == kMaxSpawns || room < 0 || room >= static_cast<int>(here_.size())) return;
+    items_[static_cast<std::size_t>(count_)] = item;
+    rooms_[static_cast<std::size_t>(count_)] = static_cast<std::int16_t>(room);
+    here_[static_cast<std::size_t>(room)] |= std::uint64_t{1} << count_;
+    ++count_;
+}
+
+void ItemPlacement::take(int spawn) {
+    if (spawn < 0 || spawn >= count_) return;
+    here_[static_cast<std::size_t>(roomOf(spawn))] &= ~(std::uint64_t{1} << spawn);
+}
+
+std::vector<std::string> ItemPlacement::place(const TempleMap& map, const std::vector<SpawnEntry>& table) {
+    reset(map.size());
+    std::vector<std::string> unknown;
+    for (const SpawnEntry& s : table) {
+        const int room = map.indexByTitle(s.room);
+        if (room < 0) unknown.emplace_back(s.room);
+        else          add(room, s.item);
+    }
+    return unknown;
+}
+
+void ItemPlacement::scatter(const TempleMap& map, const std::vector<SpawnEntry>& table,
+                            std::uint32_t seed, int hub) {
+    reset(map.size());
+    std::vector<int> rooms;
+    for (int id = 0; id < map.size(); ++id)
+        if (id != hub) rooms.push_back(id);
+    if (rooms.empty()) return;
+
+    // deal shuffled rooms out in turn: no room gets a second item until every room has one
+    std::mt19937 rng(seed);
+    for (std::size_t i = 0; i < table.size(); ++i) {
+        const std::size_t k = i % rooms.size();
+        if (k == 0) std::shuffle(rooms.begin(), rooms.end(), rng);
+        add(rooms[k], table[i].item);
+    }
+}
@@ -1,8 +1,17 @@
+#include "BalanceParams.hpp"
 #include "Game.hpp"
 #include <iostream>
+#include <cctype>
+#include <chrono>
+#include <cstdlib>
 #include <ctime>
+#include <string>
 
-int main() {
+// Usage: game [--scatter [SEED]] [--idle SECONDS] [--balance FILE]
+//   --scatter   Persephone's fragments lie somewhere different each descent
+//   --idle      quit after SECONDS at a prompt with no input
+//   --balance   shrine numbers from FILE instead of assets/balance.txt (bin/balance writes these)
+int main(int argc, char** argv) {
     // Fast, predictable console I/O
     std::ios::sync_with_stdio(false);
     std::cin.tie(nullptr);
@@ -11,6 +20,18 @@ int main() {
     std::srand(static_cast<unsigned>(std::time(nullptr)));
 
     Game game;
+    for (int i = 1; i < argc; ++i) {
+        if (std::string(argv[i]) == "--scatter") {
+            const bool seeded = i + 1 < argc && std::isdigit(static_cast<unsigned char>(argv[i + 1][0]));
+            game.setScatter(true, seeded ? static_cast<std::uint32_t>(std::strtoul(argv[++i], nullptr, 10)) : 0);
+        } else if (std::string(argv[i]) == "--idle" && i + 1 < argc) {
+            game.setInputTimeout(std::chrono::seconds(std::strtoul(argv[++i], nullptr, 10)));
+        } else if (std::string(argv[i]) == "--balance" && i + 1 < argc) {
+            std::string error;
+            if (!UseBalanceFile(argv[++i], error))
+                std::cerr << "balance " << error << " (using assets/balance.txt)\n";
+        }
+    }
     game.start();
     return 0;
 }
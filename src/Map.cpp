@@ -1,150 +1,252 @@
 // Map.cpp
 #include "Map.hpp"
-#include <iomanip>
+#include "utils.hpp"
+#include <cstddef>
 
-int TempleMap::addNode(const std::string& name, bool shrine) {
+// --- directions --------------------------------------------------------------
+
+static const char* const kDirNames[kDirCount] = {
+    "north", "northeast", "east", "southeast", "south",
+    "southwest", "west", "northwest", "up", "down"
+};
+
+Dir dirFromName(const std::string& name) {
+    const std::string longDir = normalize_dir(name);   // "n" -> "north", "" if invalid
+    for (int i = 0; i < kDirCount; ++i)
+        if (longDir == kDirNames[i]) return static_cast<Dir>(i);
+    return Dir::Count;
+}
+
+const char* dirName(Dir d) {
+    const int i = static_cast<int>(d);
+    return (i >= 0 && i < kDirCount) ? kDirNames[i] : "";
+}
+
+Dir oppositeDir(Dir d) {
+    switch (d) {
+        case Dir::North:     return Dir::South;
+        case Dir::NorthEast: return Dir::SouthWest;
+        case Dir::East:      return Dir::West;
+        case Dir::SouthEast: return Dir::NorthWest;
+        case Dir::South:     return Dir::North;
+        case Dir::SouthWest: return Dir::NorthEast;
+        case Dir::West:      return Dir::East;
+        case Dir::NorthWest: return Dir::SouthEast;
+        case Dir::Up:        return Dir::Down;
+        case Dir::Down:      return Dir::Up;
+        default:             return Dir::Count;
+    }
+}
+
+// --- graph -------------------------------------------------------------------
+
+void TempleMap::clear() {
+    nodes_.clear(); exits_.clear(); oneWay_.clear(); nameToId_.clear();
+    clashes_.clear(); unresolved_.clear();
+}
+
+int TempleMap::addNode(const std::string& name, bool shrine, Deity deity, const std::string& locId) {
     int id = static_cast<int>(nodes_.size());
-    nodes_.push_back({id, name, shrine});
-    edges_.push_back({});
-    nameToId_[name] = id;
+    nodes_.push_back({id, name, shrine, deity, locId});
+    Exits none; none.fill(-1);
+    exits_.push_back(none);
+    oneWay_.push_back(0);
+    nameToId_.emplace(toLower(name), id);   // first title wins
     return id;
 }
 
-void TempleMap::addEdgeByName(const std::string& a, const std::string& b) {
-    auto ia = nameToId_.find(a), ib = nameToId_.find(b);
-    if (ia == nameToId_.end() || ib == nameToId_.end()) return;
-    int A = ia->second, B = ib->second;
-    edges_[A].push_back(B);
-    edges_[B].push_back(A);
-}
-
-void TempleMap::populateFromDesign() {
-    nodes_.clear(); edges_.clear(); nameToId_.clear();
-
-    // Clusters match Game::loadRooms() names
-    // Demeter (id 0)
-    addNode("The Garden of Broken Faces", false);
-    addNode("The Threadbare Womb", false);
-    addNode("The Hall of Hunger", true);
-
-    // Nyx (id 1)
-    addNode("Room With No Corners", false);
-    addNode("Nest of Wings", false);
-    addNode("The Starless Well", true);
-
-    // Apollo (id 2)
-    addNode("Hall of Echoes", false);
-    addNode("Room That Remembers", false);
-    addNode("Echoing Gallery", true);
-
-    // Hecate (id 3)
-    addNode("Loom of Names", false);
-    addNode("Listening Chamber", false);
-    addNode("The Unlit Path", true);
-
-    // Persephone (id 4)
-    addNode("Hall of Petals", false);
-    addNode("Orchard Walk", false);
-    addNode("The Frozen Spring", true);
-
-    // Pan (id 5)
-    addNode("Hall of Shivering Meat", false);
-    addNode("Den of Antlers", false);
-    addNode("Wild Rotunda", true);
-
-    // False Hermes (id 6)
-    addNode("Room of Borrowed Things", false);
-    addNode("Whispering Hall", false);
-    addNode("Gilded Hallway", true);
-
-    // Thanatos (id 7)
-    addNode("Room of Waiting Lights", false);
-    addNode("The Bloodclock", false);
-    addNode("Sleepwalker’s Alcove", true);
-
-    // Eris (id 8) — 3 non‑shrine + shrine
-    addNode("Oracle’s Wake", false);
-    addNode("Archivist’s Cell", false);
-    addNode("Throat of the Temple", false);
-    addNode("The Bone Choir", true);
-
-    // Intra‑cluster links (room1 <-> room2 <-> shrine)
-    auto linkTriad = [&](const std::string& a, const std::string& b, const std::string& s){
-        addEdgeByName(a,b); addEdgeByName(b,s);
-    };
-    linkTriad("The Garden of Broken Faces","The Threadbare Womb","The Hall of Hunger");
-    linkTriad("Room With No Corners","Nest of Wings","The Starless Well");
-    linkTriad("Hall of Echoes","Room That Remembers","Echoing Gallery");
-    linkTriad("Loom of Names","Listening Chamber","The Unlit Path");
-    linkTriad("Hall of Petals","Orchard Walk","The Frozen Spring");
-    linkTriad("Hall of Shivering Meat","Den of Antlers","Wild Rotunda");
-    linkTriad("Room of Borrowed Things","Whispering Hall","Gilded Hallway");
-    linkTriad("Room of Waiting Lights","The Bloodclock","Sleepwalker’s Alcove");
-    // Eris chain: wake -> cell -> throat -> shrine
-    addEdgeByName("Oracle’s Wake","Archivist’s Cell");
-    addEdgeByName("Archivist’s Cell","Throat of the Temple");
-    addEdgeByName("Throat of the Temple","The Bone Choir");
-
-    // Inter‑cluster spine (you can tweak later)
-    addEdgeByName("The Hall of Hunger", "The Starless Well");
-    addEdgeByName("The Starless Well", "Echoing Gallery");
-    addEdgeByName("Echoing Gallery", "The Unlit Path");
-    addEdgeByName("The Unlit Path", "The Frozen Spring");
-    addEdgeByName("The Frozen Spring", "Wild Rotunda");
-    addEdgeByName("Wild Rotunda", "Gilded Hallway");
-    addEdgeByName("Gilded Hallway", "Sleepwalker’s Alcove");
-    addEdgeByName("Sleepwalker’s Alcove", "Throat of the Temple");
-}
-
-void TempleMap::printAscii() const {
-    // Compact cluster view (not to scale)
-    auto pad = [](const std::string& s, int w){ return s.size()<static_cast<size_t>(w) ? s + std::string(w - s.size(),' ') : s.substr(0,w); };
-
-    std::cout << "\n=== TEMPLE LAYOUT (CLUSTERS) ===\n";
-    std::cout << "[Demeter]      [Nyx]          [Apollo]       [Hecate]\n";
-    std::cout << pad("Garden of Broken Faces",22) << "  "
-              << pad("Room With No Corners",22)   << "  "
-              << pad("Hall of Echoes",22)         << "  "
-              << pad("Loom of Names",22)          << "\n";
-    std::cout << pad("Threadbare Womb",22)        << "  "
-              << pad("Nest of Wings",22)          << "  "
-              << pad("Room That Remembers",22)    << "  "
-              << pad("Listening Chamber",22)      << "\n";
-    std::cout << pad("== Hall of Hunger ==",22)   << "--"
-              << pad("== Starless Well ==",22)    << "--"
-              << pad("== Echoing Gallery ==",22)  << "--"
-              << pad("== The Unlit Path ==",22)   << "\n\n";
-
-    std::cout << "[Persephone]   [Pan]          [False Hermes] [Thanatos]\n";
-    std::cout << pad("Hall of Petals",22)       << "  "
-              << pad("Hall of Shivering Meat",22) << "  "
-              << pad("Room of Borrowed Things",22)<< "  "
-              << pad("Room of Waiting Lights",22) << "\n";
-    std::cout << pad("Orchard Walk",22)     << "  "
-              << pad("Den of Antlers",22)         << "  "
-              << pad("Whispering Hall",22)        << "  "
-              << pad("The Bloodclock",22)         << "\n";
-    std::cout << pad("== The Frozen Spring ==",22)<< "--"
-              << pad("== Wild Rotunda ==",22)     << "--"
-              << pad("== Gilded Hallway ==",22)   << "--"
-              << pad("== Sleepwalker's Alcove ==",22) << "\n\n";
-
-    std::cout << "[Eris]\n";
-    std::cout << "Oracle's Wake -> Archivist's Cell -> Throat of the Temple -> == The Bone Choir ==\n\n";
-
-    std::cout << "Spine (shrines): Hunger -> Well -> Gallery -> Path -> Spring -> Rotunda -> Hallway -> Alcove -> Throat -> Bone Choir\n\n";
+void TempleMap::addEdge(int from, Dir d, int to) {
+    if (from < 0 || from >= size() || to < 0 || to >= size() || d == Dir::Count) return;
+    int& slot = exits_[from][static_cast<int>(d)];
+    if (slot >= 0 && slot != to) clashes_.push_back({from, d, slot, to});
+    slot = to;
+    oneWay_[from] &= static_cast<std::uint16_t>(~(1u << static_cast<int>(d)));
+}
+
+void TempleMap::addOneWay(int from, Dir d, int to) {
+    addEdge(from, d, to);
+    if (exit(from, d) == to) oneWay_[from] |= static_cast<std::uint16_t>(1u << static_cast<int>(d));
+}
+
+void TempleMap::addEdgeByTitle(const std::string& fromTitle, Dir d, const std::string& toTitle,
+                               bool oneWay) {
+    const int from = indexByTitle(fromTitle);
+    const int to   = indexByTitle(toTitle);
+    if (from < 0) unresolved_.push_back(fromTitle);
+    if (to < 0)   unresolved_.push_back(toTitle);
+    if (from < 0 || to < 0) return;
+    if (oneWay) addOneWay(from, d, to);
+    else        addEdge(from, d, to);
+}
+
+int TempleMap::exit(int from, Dir d) const {
+    if (from < 0 || from >= size() || d == Dir::Count) return -1;
+    return exits_[from][static_cast<int>(d)];
+}
+
+bool TempleMap::isOneWay(int from, Dir d) const {
+    if (from < 0 || from >= size() || d == Dir::Count) return false;
+    return (oneWay_[from] >> static_cast<int>(d)) & 1u;
+}
+
+int TempleMap::indexByTitle(const std::string& title) const {
+    auto it = nameToId_.find(toLower(trim_copy(title)));
+    return (it != nameToId_.end()) ? it->second : -1;
 }
 
 void TempleMap::printAdjacency() const {
     std::cout << "=== ROOM GRAPH (Adjacency) ===\n";
     for (const auto& n : nodes_) {
         std::cout << (n.shrine ? "[S] " : "[ ] ") << n.id << " - " << n.name << " : ";
-        const auto& nbrs = edges_[n.id];
-        for (size_t i=0;i<nbrs.size();++i) {
-            std::cout << nbrs[i] << (i+1<nbrs.size() ? ", " : "");
+        bool first = true;
+        for (int d = 0; d < kDirCount; ++d) {
+            const int to = exits_[n.id][d];
+            if (to < 0) continue;
+            std::cout << (first ? "" : ", ") << kDirNames[d] << "->" << to;
+            first = false;
         }
         std::cout << "\n";
     }
     std::cout << "\nLegend: [S] = Shrine\n";
 }
 
+// --- player map (cached, fog of war) ------------------------------------------
+
+void MapView::reset(const TempleMap& map, int hub) {
+    map_ = &map;
+    hub_ = hub;
+    current_ = -1;
+    visited_.assign(static_cast<size_t>(map.size()), false);
+    built_ = false;
+}
+
+void MapView::setStyle(const AccessibilitySettings& as, ShrineState state) {
+    if (as.colorEnabled == access_.colorEnabled && state == state_) {
+        access_ = as;
+        return;
+    }
+    access_ = as;
+    state_ = state;
+    built_ = false;   // every cell's escape codes change
+}
+
+bool MapView::markVisited(int id) {
+    if (id < 0 || id >= static_cast<int>(visited_.size()) || visited_[id]) return false;
+    visited_[id] = true;
+    if (built_) patchCell(id);
+    return true;
+}
+
+bool MapView::isVisited(int id) const {
+    return id >= 0 && id < static_cast<int>(visited_.size()) && visited_[id];
+}
+
+std::string MapView::cellText(int id) const {
+    if (!visited_[id]) return "???";
+
+    const MapNode& n = map_->nodes()[id];
+    std::string label = n.shrine ? "== " + n.name + " ==" : n.name;
+    if (id != current_) return ThemeRegistry::style(n.deity, state_, label, access_);
+
+    // Current room: marker + reverse video on top of the deity colors.
+    const std::string styled = ThemeRegistry::style(n.deity, state_, "@ " + label, access_);
+    return access_.colorEnabled ? ansi("\x1b[7m") + styled + ::reset() : styled;
+}
+
+// Layout: one row per hub exit, following the corridor away from the hub and
+// always taking the first exit (in direction order) into a room not yet drawn.
+void MapView::build() {
+    if (map_ && static_cast<int>(visited_.size()) != map_->size())
+        visited_.assign(static_cast<size_t>(map_->size()), false);   // world changed without reset()
+    text_.clear();
+    cells_.assign(visited_.size(), CellSpan{});
+    built_ = true;
+
+    text_ += "\n=== TEMPLE LAYOUT ===\n";
+    if (!map_ || hub_ < 0 || hub_ >= map_->size()) {
+        text_ += "(The temple has no shape yet.)\n\n";
+        return;
+    }
+
+    const auto& nodes = map_->nodes();
+    auto place = [&](int id) {
+        const std::string cell = cellText(id);
+        cells_[id] = CellSpan{text_.size(), cell.size(), true};
+        text_ += cell;
+    };
+
+    std::vector<bool> drawn(nodes.size(), false);
+    drawn[hub_] = true;
+    text_ += "[";
+    place(hub_);
+    text_ += "]\n";
+
+    for (int d = 0; d < kDirCount; ++d) {
+        int cur = map_->exit(hub_, static_cast<Dir>(d));
+        if (cur < 0 || drawn[cur]) continue;
+
+        std::string prefix = "  " + std::string(dirName(static_cast<Dir>(d)));
+        prefix.resize(12, ' ');
+        prefix += "[" + std::string(deityLabel(nodes[cur].deity)) + "]";
+        if (prefix.size() < 28) prefix.resize(28, ' ');
+        text_ += prefix;
+
+        bool first = true;
+        while (cur >= 0) {
+            drawn[cur] = true;
+            if (!first) text_ += " - ";
+            place(cur);
+            first = false;
+
+            int next = -1;
+            for (int to : map_->exitsFrom(cur)) {
+                if (to >= 0 && !drawn[to]) { next = to; break; }
+            }
+            cur = next;
+        }
+        text_ += "\n";
+    }
+
+    // Anything the corridors above didn't reach (side branches, detached rooms).
+    bool header = false;
+    for (const auto& n : nodes) {
+        if (drawn[n.id]) continue;
+        if (!header) { text_ += "\n  Elsewhere:\n"; header = true; }
+        text_ += "    ";
+        place(n.id);
+        text_ += "\n";
+    }
+    text_ += "\nLegend: @ = you, ??? = unexplored\n\n";
+}
+
+// Rewrite one cell in place and shift the cells that sit after it.
+void MapView::patchCell(int id) {
+    CellSpan& span = cells_[id];
+    if (!span.placed) return;
+
+    const std::string cell = cellText(id);
+    const size_t at = span.offset, oldLen = span.length;
+    text_.replace(at, oldLen, cell);
+    span.length = cell.size();
+
+    if (cell.size() == oldLen) return;
+    const auto delta = static_cast<std::ptrdiff_t>(cell.size()) - static_cast<std::ptrdiff_t>(oldLen);
+    for (auto& c : cells_) {
+        if (c.placed && c.offset > at) c.offset = static_cast<size_t>(static_cast<std::ptrdiff_t>(c.offset) + delta);
+    }
+}
+
+const std::string& MapView::render(int current) {
+    if (!built_) {
+        current_ = current;
+        build();
+        return text_;
+    }
+    if (current != current_) {
+        const int prev = current_;
+        current_ = current;
+        if (prev >= 0 && prev < static_cast<int>(cells_.size())) patchCell(prev);
+        if (current >= 0 && current < static_cast<int>(cells_.size())) patchCell(current);
+    }
+    return text_;
+}
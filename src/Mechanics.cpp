@@ -1,23 +1,10 @@
 #include "Mechanics.hpp"
+#include "Dice.hpp"
 #include <algorithm>
-
-bool PlayerState::hasItem(const std::string& id) const {
-    return std::any_of(bag.begin(), bag.end(), [&](const auto& it){ return it.id == id && it.charges > 0; });
-}
-
-bool PlayerState::consumeItem(const std::string& id) {
-    for (auto& it : bag) {
-        if (it.id == id && it.charges > 0) { --it.charges; return true; }
-    }
-    return false;
-}
-
-void PlayerState::addItem(const InventoryItem& it) {
-    for (auto& x : bag) {
-        if (x.id == it.id) { x.charges += it.charges; return; }
-    }
-    bag.push_back(it);
-}
+#include <cstring>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
 
 void PlayerState::applyOutcome(const Outcome& out) {
     stats.health  += out.healthDelta;
@@ -26,7 +13,7 @@ void PlayerState::applyOutcome(const Outcome& out) {
     stats.nerve   += out.nerveDelta;
     corruption    = std::clamp(corruption + out.corruptionDelta, 0, 100);
     stats.clamp();
-    for (const auto& it : out.itemsGained) addItem(it);
+    for (ItemId id : out.itemsGained) addItem(id);
 }
 
 static int pickRoll(RNG& rng, bool adv, bool dis) {
@@ -42,3 +29,114 @@ bool SkillCheck::resolve(RNG& rng, int dc, int statScore, const CheckMods& mods,
     return total >= dc;
 }
 
+
+// 0 = plain roll, 1 = best of two, 2 = worst of two (what pickRoll does)
+static int rollMode(const CheckMods& mods) {
+    if (mods.advantage && !mods.disadvantage) return 1;
+    if (mods.disadvantage && !mods.advantage) return 2;
+    return 0;
+}
+
+double SkillCheck::successProbability(int dc, int statScore, const CheckMods& mods) {
+    // faces of the d10 that pass: roll >= dc - stat - flat
+    const int faces = std::clamp(11 - (dc - statScore - mods.flat), 0, 10);
+    const double p = faces / 10.0;
+    switch (rollMode(mods)) {
+        case 1:  return p * (2.0 - p);   // 1 - (1-p)^2
+        case 2:  return p * p;
+        default: return p;
+    }
+}
+
+void SkillCheck::successProbability(const int* dc, const int* statScore, const CheckMods* mods,
+                                    float* out, std::size_t n) {
+    std::size_t i = 0;
+#if defined(__SSE2__)
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 ten  = _mm_set1_ps(10.0f);
+    const __m128 two  = _mm_set1_ps(2.0f);
+    const __m128i one = _mm_set1_epi32(1);
+    const __m128i twoI = _mm_set1_epi32(2);
+    for (; i + 4 <= n; i += 4) {
+        const __m128i vdc   = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dc + i));
+        const __m128i vstat = _mm_loadu_si128(reinterpret_cast<const __m128i*>(statScore + i));
+        // CheckMods is a small struct, so gather its lanes by hand
+        const __m128i vflat = _mm_setr_epi32(mods[i].flat, mods[i + 1].flat, mods[i + 2].flat, mods[i + 3].flat);
+        const __m128i vmode = _mm_setr_epi32(rollMode(mods[i]), rollMode(mods[i + 1]),
+                                             rollMode(mods[i + 2]), rollMode(mods[i + 3]));
+
+        // faces = clamp(11 - (dc - stat - flat), 0, 10); p = faces / 10
+        const __m128i need = _mm_sub_epi32(_mm_sub_epi32(vdc, vstat), vflat);
+        __m128 faces = _mm_cvtepi32_ps(_mm_sub_epi32(_mm_set1_epi32(11), need));
+        faces = _mm_min_ps(_mm_max_ps(faces, zero), ten);
+        const __m128 p = _mm_div_ps(faces, ten);
+
+        const __m128 adv = _mm_mul_ps(p, _mm_sub_ps(two, p));
+        const __m128 dis = _mm_mul_ps(p, p);
+        const __m128 isAdv = _mm_castsi128_ps(_mm_cmpeq_epi32(vmode, one));
+        const __m128 isDis = _mm_castsi128_ps(_mm_cmpeq_epi32(vmode, twoI));
+
+        __m128 r = _mm_or_ps(_mm_and_ps(isAdv, adv), _mm_andnot_ps(isAdv, p));
+        r = _mm_or_ps(_mm_and_ps(isDis, dis), _mm_andnot_ps(isDis, r));
+        _mm_storeu_ps(out + i, r);
+    }
+#endif
+    for (; i < n; ++i)
+        out[i] = static_cast<float>(successProbability(dc[i], statScore[i], mods[i]));
+}
+
+void SkillCheck::resolveBatch(D10Stream& dice, const int* dc, const int* statScore, const CheckMods* mods,
+                              std::uint8_t* passed, std::size_t n, int* outRoll) {
+    constexpr std::size_t kChunk = 256;
+    std::uint8_t first[kChunk], second[kChunk];
+
+    for (std::size_t base = 0; base < n; base += kChunk) {
+        const std::size_t m = std::min(kChunk, n - base);
+        dice.fill(first, m);
+        dice.fill(second, m);
+
+        std::size_t i = 0;
+#if defined(__SSE2__)
+        const __m128i zero = _mm_setzero_si128();
+        const __m128i one  = _mm_set1_epi32(1);
+        const __m128i two  = _mm_set1_epi32(2);
+        for (; i + 4 <= m; i += 4) {
+            const std::size_t k = base + i;
+            std::int32_t a4, b4;
+            std::memcpy(&a4, first + i, 4);
+            std::memcpy(&b4, second + i, 4);
+            const __m128i a = _mm_unpacklo_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128(a4), zero), zero);
+            const __m128i b = _mm_unpacklo_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128(b4), zero), zero);
+
+            const __m128i vdc   = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dc + k));
+            const __m128i vstat = _mm_loadu_si128(reinterpret_cast<const __m128i*>(statScore + k));
+            const __m128i vflat = _mm_setr_epi32(mods[k].flat, mods[k + 1].flat, mods[k + 2].flat, mods[k + 3].flat);
+            const __m128i vmode = _mm_setr_epi32(rollMode(mods[k]), rollMode(mods[k + 1]),
+                                                 rollMode(mods[k + 2]), rollMode(mods[k + 3]));
+
+            // best / worst of the pair without SSE4.1 min/max
+            const __m128i aBigger = _mm_cmpgt_epi32(a, b);
+            const __m128i hi = _mm_or_si128(_mm_and_si128(aBigger, a), _mm_andnot_si128(aBigger, b));
+            const __m128i lo = _mm_or_si128(_mm_and_si128(aBigger, b), _mm_andnot_si128(aBigger, a));
+            const __m128i isAdv = _mm_cmpeq_epi32(vmode, one);
+            const __m128i isDis = _mm_cmpeq_epi32(vmode, two);
+            __m128i roll = _mm_or_si128(_mm_and_si128(isAdv, hi), _mm_andnot_si128(isAdv, a));
+            roll = _mm_or_si128(_mm_and_si128(isDis, lo), _mm_andnot_si128(isDis, roll));
+
+            // ties succeed: pass unless dc > total
+            const __m128i total = _mm_add_epi32(_mm_add_epi32(roll, vstat), vflat);
+            const int fail = _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpgt_epi32(vdc, total)));
+            for (int j = 0; j < 4; ++j) passed[k + j] = static_cast<std::uint8_t>(!((fail >> j) & 1));
+            if (outRoll) _mm_storeu_si128(reinterpret_cast<__m128i*>(outRoll + k), roll);
+        }
+#endif
+        for (; i < m; ++i) {
+            const std::size_t k = base + i;
+            const int a = first[i], b = second[i];
+            const int mode = rollMode(mods[k]);
+            const int roll = mode == 1 ? std::max(a, b) : mode == 2 ? std::min(a, b) : a;
+            passed[k] = static_cast<std::uint8_t>(roll + statScore[k] + mods[k].flat >= dc[k]);
+            if (outRoll) outRoll[k] = roll;
+        }
+    }
+}
@@ -0,0 +1,49 @@
+// Pathfinding.cpp
+#include "Pathfinding.hpp"
+
+void NextHopTable::clear() {
+    n_ = 0;
+    next_.clear();
+}
+
+void NextHopTable::build(const TempleMap& map) {
+    n_ = map.size();
+    next_.assign(static_cast<size_t>(n_) * static_cast<size_t>(n_), -1);
+
+    std::vector<int> queue(n_);
+    for (int src = 0; src < n_; ++src) {
+        int* row = &next_[static_cast<size_t>(src) * n_];
+        int head = 0, tail = 0;
+
+        // Seed with the direct neighbours: their first hop is themselves.
+        for (int v : map.exitsFrom(src)) {
+            if (v < 0 || v == src || row[v] != -1) continue;
+            row[v] = v;
+            queue[tail++] = v;
+        }
+        // Everything further away inherits the first hop of the room it was reached from.
+        while (head < tail) {
+            const int u = queue[head++];
+            for (int v : map.exitsFrom(u)) {
+                if (v < 0 || v == src || row[v] != -1) continue;
+                row[v] = row[u];
+                queue[tail++] = v;
+            }
+        }
+    }
+}
+
+int NextHopTable::next(int from, int to) const {
+    if (from < 0 || to < 0 || from >= n_ || to >= n_) return -1;
+    return next_[static_cast<size_t>(from) * n_ + to];
+}
+
+int NextHopTable::distance(int from, int to) const {
+    if (from < 0 || to < 0 || from >= n_ || to >= n_) return -1;
+    int steps = 0;
+    for (int cur = from; cur != to; ++steps) {
+        cur = next(cur, to);
+        if (cur < 0 || steps > n_) return -1;
+    }
+    return steps;
+}
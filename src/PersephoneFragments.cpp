@@ -19,51 +19,21 @@ const std::vector<std::string> kPersephoneLetterClean = {
     "I am his, and he is mine."
 };
 
-static const char* FRAG_TEXT[8] = {
-    "They say I was dragged screaming… screaming… but the dark was already inside me.",
-    "I walked here. My eyes open. My hands empty.",
-    "Hades… on his knees… his hands colder than mine.",
-    "The shadows dance, or they feed — sometimes I forget which.",
-    "The dead keep their promises. The living… forget.",
-    "Better his crown in the stillness than your fields in the wind.",
-    "Blood dried in the lines of my palms. I tried to wash it… it stayed.",
-    "I am his. He is mine. I am his. He is mine."
-};
-
-std::vector<InventoryItem> MakePersephoneFragments() {
-    std::vector<InventoryItem> v; v.reserve(8);
-    for (int i=0;i<8;++i) {
-        InventoryItem it;
-        it.id   = "perse_frag_" + std::to_string(i+1);
-        it.name = "Letter Fragment (" + std::to_string(i+1) + ")";
-        it.desc = FRAG_TEXT[i];
-        it.charges = 1;
-        v.push_back(it);
-    }
-    return v;
-}
-
-static bool hasFrag(const PlayerState& ps, int idx) {
-    const std::string want = "perse_frag_" + std::to_string(idx);
-    for (const auto& it : ps.bag) if (it.id == want && it.charges > 0) return true;
-    return false;
+bool HasAllPersephoneFragments(const PlayerState& ps) {
+    return ps.inventory.hasAllFragments();
 }
 
-bool HasAllPersephoneFragments(const PlayerState& ps) {
-    for (int i=1;i<=8;++i) if (!hasFrag(ps, i)) return false;
-    return true;
+int CountPersephoneFragments(const PlayerState& ps) {
+    int n = 0;
+    for (std::uint8_t m = ps.inventory.fragmentMask(); m; m &= static_cast<std::uint8_t>(m - 1)) ++n;
+    return n;
 }
 
 std::vector<std::pair<int,std::string>> GetOwnedPersephoneFragments(const PlayerState& ps) {
-    std::vector<std::pair<int,std::string>> out; out.reserve(8);
-    for (int i=1;i<=8;++i) {
-        const std::string want = "perse_frag_" + std::to_string(i);
-        for (const auto& it : ps.bag) {
-            if (it.id == want && it.charges > 0) {
-                out.emplace_back(i, it.desc);
-                break;
-            }
-        }
+    std::vector<std::pair<int,std::string>> out; out.reserve(kPersephoneFragmentCount);
+    const std::uint8_t mask = ps.inventory.fragmentMask();
+    for (int i=1;i<=kPersephoneFragmentCount;++i) {
+        if (mask & (1u << (i-1))) out.emplace_back(i, ItemInfo(PersephoneFragmentItem(i)).desc);
     }
     return out;
 }
@@ -80,12 +50,11 @@ Outcome PickupPersephoneFragmentInRoom(InteractionContext& ctx, int index, const
     }
 
     // Give the fragment
-    auto all = MakePersephoneFragments();
-    InventoryItem it = all[index-1];
-    ctx.player.addItem(it);
+    const ItemId id = PersephoneFragmentItem(index);
+    ctx.player.addItem(id);
     ctx.flags[pickedFlagKey] = true;
 
-    o.journalEntry = "You recover a torn piece of Persephone’s letter: \"" + it.desc + "\"";
+    o.journalEntry = std::string("You recover a torn piece of Persephone’s letter: \"") + ItemInfo(id).desc + "\"";
     o.willDelta += 1; // small calm boon
     return o;
 }
@@ -15,22 +15,12 @@ void Player::loseSanity(int amount) {
 }
 
 // --- Movement ---
-void Player::move(const std::string& direction,
-                  const std::unordered_map<int, std::unordered_map<std::string,int>>& roomConnections) {
-    auto rcIt = roomConnections.find(currentRoom);
-    if (rcIt == roomConnections.end()) { std::cout << "You can't move from here.\n"; return; }
-    const auto& exits = rcIt->second;
+bool Player::move(const std::string& direction, const TempleMap& map) {
+    const int to = map.exit(currentRoom, dirFromName(direction)); // "n"/"north" both accepted
+    if (to < 0) { std::cout << "No exit that way.\n"; return false; }
 
-    const std::string longDir  = normalize_dir(direction); // "n"->"north" or "" if invalid
-    const std::string shortDir = to_short_dir(longDir.empty() ? direction : longDir);
-
-    if (longDir.empty() && shortDir.empty()) { std::cout << "No exit that way.\n"; return; }
-
-    auto it = exits.find(longDir);
-    if (it == exits.end()) it = exits.find(shortDir);
-    if (it == exits.end()) { std::cout << "No exit that way.\n"; return; }
-
-    currentRoom = it->second;
+    currentRoom = to;
+    return true;
 }
 
 // --- Journal Integration ---
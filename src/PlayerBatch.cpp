@@ -0,0 +1,144 @@
+// PlayerBatch.cpp
+#include "PlayerBatch.hpp"
+#include <algorithm>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace {
+
+std::size_t padded(std::size_t n) { return (n + kBatchLanes - 1) / kBatchLanes * kBatchLanes; }
+
+std::int16_t narrow(int v) { return static_cast<std::int16_t>(std::clamp(v, -32768, 32767)); }
+
+// dst[i] = clamp(dst[i] + add[i], lo, hi), eight lanes per step.
+// The add saturates, so huge deltas can't wrap past the clamp.
+void addClamp(std::int16_t* dst, const std::int16_t* add, std::size_t n, std::int16_t lo, std::int16_t hi) {
+    std::size_t i = 0;
+#if defined(__SSE2__)
+    const __m128i vlo = _mm_set1_epi16(lo);
+    const __m128i vhi = _mm_set1_epi16(hi);
+    for (; i + 8 <= n; i += 8) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dst + i));
+        v = _mm_adds_epi16(v, _mm_loadu_si128(reinterpret_cast<const __m128i*>(add + i)));
+        v = _mm_min_epi16(_mm_max_epi16(v, vlo), vhi);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), v);
+    }
+#endif
+    for (; i < n; ++i) dst[i] = static_cast<std::int16_t>(std::clamp(dst[i] + add[i], int{lo}, int{hi}));
+}
+
+void clampLanes(std::int16_t* dst, std::size_t n, std::int16_t lo, std::int16_t hi) {
+    std::size_t i = 0;
+#if defined(__SSE2__)
+    const __m128i vlo = _mm_set1_epi16(lo);
+    const __m128i vhi = _mm_set1_epi16(hi);
+    for (; i + 8 <= n; i += 8) {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dst + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_min_epi16(_mm_max_epi16(v, vlo), vhi));
+    }
+#endif
+    for (; i < n; ++i) dst[i] = std::clamp(dst[i], lo, hi);
+}
+
+void orMasks(ItemMask* dst, const ItemMask* add, std::size_t n) {
+    std::size_t i = 0;
+#if defined(__SSE2__)
+    for (; i + 2 <= n; i += 2) {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dst + i));
+        const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(add + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_or_si128(v, a));
+    }
+#endif
+    for (; i < n; ++i) dst[i] |= add[i];
+}
+
+} // namespace
+
+// --- OutcomeBatch ------------------------------------------------------------
+
+void OutcomeBatch::resize(std::size_t n) {
+    size_ = n;
+    const std::size_t p = padded(n);
+    for (auto* f : {&health, &will, &insight, &nerve, &corruption}) f->assign(p, 0);
+    items.assign(p, 0);
+}
+
+void OutcomeBatch::clear() {
+    for (auto* f : {&health, &will, &insight, &nerve, &corruption}) std::fill(f->begin(), f->end(), 0);
+    std::fill(items.begin(), items.end(), 0);
+}
+
+void OutcomeBatch::set(std::size_t i, const Outcome& out) {
+    health[i]     = narrow(out.healthDelta);
+    will[i]       = narrow(out.willDelta);
+    insight[i]    = narrow(out.insightDelta);
+    nerve[i]      = narrow(out.nerveDelta);
+    corruption[i] = narrow(out.corruptionDelta);
+    ItemMask m = 0;
+    for (ItemId id : out.itemsGained) m |= ItemBit(id);
+    items[i] = m;
+}
+
+// --- PlayerBatch -------------------------------------------------------------
+
+PlayerBatch::PlayerBatch(std::size_t n, const Stats& start, int startCorruption) {
+    resize(n, start, startCorruption);
+}
+
+void PlayerBatch::resize(std::size_t n, const Stats& start, int startCorruption) {
+    Stats s = start;
+    s.clamp();
+    size_ = n;
+    const std::size_t p = padded(n);
+    health.assign(p, 0);  will.assign(p, 0);  insight.assign(p, 0);  nerve.assign(p, 0);
+    corruption.assign(p, 0);
+    items.assign(p, 0);
+    std::fill_n(health.begin(),     n, narrow(s.health));
+    std::fill_n(will.begin(),       n, narrow(s.will));
+    std::fill_n(insight.begin(),    n, narrow(s.insight));
+    std::fill_n(nerve.begin(),      n, narrow(s.nerve));
+    std::fill_n(corruption.begin(), n, narrow(std::clamp(startCorruption, 0, 100)));
+}
+
+void PlayerBatch::load(std::size_t i, PlayerState& ps) const {
+    ps.stats.health  = health[i];
+    ps.stats.will    = will[i];
+    ps.stats.insight = insight[i];
+    ps.stats.nerve   = nerve[i];
+    ps.corruption    = corruption[i];
+    ps.inventory.clear();
+    for (int id = 0; id < kItemCount; ++id)
+        if ((items[i] >> id) & 1) ps.addItem(static_cast<ItemId>(id));
+}
+
+void PlayerBatch::store(std::size_t i, const PlayerState& ps) {
+    health[i]     = narrow(ps.stats.health);
+    will[i]       = narrow(ps.stats.will);
+    insight[i]    = narrow(ps.stats.insight);
+    nerve[i]      = narrow(ps.stats.nerve);
+    corruption[i] = narrow(ps.corruption);
+    ItemMask m = 0;
+    for (int id = 0; id < kItemCount; ++id)
+        if (ps.hasItem(static_cast<ItemId>(id))) m |= ItemBit(static_cast<ItemId>(id));
+    items[i] = m;
+}
+
+void PlayerBatch::apply(const OutcomeBatch& d) {
+    const std::size_t n = std::min(health.size(), d.health.size());
+    addClamp(health.data(),     d.health.data(),     n, 0, 10);
+    addClamp(will.data(),       d.will.data(),       n, 0, 10);
+    addClamp(insight.data(),    d.insight.data(),    n, 0, 10);
+    addClamp(nerve.data(),      d.nerve.data(),      n, 0, 10);
+    addClamp(corruption.data(), d.corruption.data(), n, 0, 100);
+    orMasks(items.data(), d.items.data(), n);
+}
+
+void PlayerBatch::clamp() {
+    const std::size_t n = health.size();
+    clampLanes(health.data(),     n, 0, 10);
+    clampLanes(will.data(),       n, 0, 10);
+    clampLanes(insight.data(),    n, 0, 10);
+    clampLanes(nerve.data(),      n, 0, 10);
+    clampLanes(corruption.data(), n, 0, 100);
+}
@@ -0,0 +1,143 @@
+// RiddleBank.cpp
+#include "RiddleBank.hpp"
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string_view>
+
+namespace {
+
+std::string_view trim(std::string_view s) {
+    while (!s.empty() && (s.front() == ' ' || s.front() == '\t')) s.remove_prefix(1);
+    while (!s.empty() && (s.back() == ' ' || s.back() == '\t' || s.back() == '\r')) s.remove_suffix(1);
+    return s;
+}
+
+// Split on '|' into at most `max` trimmed fields; returns how many there were
+// (possibly more than max, to report it).
+int splitFields(std::string_view line, std::string_view* fields, int max) {
+    int n = 0;
+    for (;;) {
+        const std::size_t bar = line.find('|');
+        if (n < max) fields[n] = trim(line.substr(0, bar));
+        ++n;
+        if (bar == std::string_view::npos) return n;
+        line.remove_prefix(bar + 1);
+    }
+}
+
+} // namespace
+
+bool RiddleBank::parse(std::string text, const std::string& name, std::string& error) {
+    riddles_.clear();
+    text_ = std::move(text);
+
+    constexpr int kMaxFields = 2 + kRiddleMaxOptions;
+    std::string_view rest(text_);
+    for (int lineNo = 1; !rest.empty(); ++lineNo) {
+        const std::size_t eol = rest.find('\n');
+        const std::string_view line = trim(rest.substr(0, eol));
+        rest.remove_prefix(eol == std::string_view::npos ? rest.size() : eol + 1);
+        if (line.empty() || line.front() == '#') continue;
+
+        auto fail = [&](const std::string& what) {
+            error = name + ":" + std::to_string(lineNo) + ": " + what;
+            riddles_.clear();
+            return false;
+        };
+
+        std::string_view f[kMaxFields];
+        const int fields = splitFields(line, f, kMaxFields);
+        if (fields > kMaxFields) return fail("more than " + std::to_string(kRiddleMaxOptions) + " options");
+        if (fields < 4) return fail("expected 'difficulty | prompt | option | option ...'");
+        if (f[0].size() != 1 || f[0][0] < '1' || f[0][0] > '3') return fail("difficulty must be 1, 2 or 3");
+        if (f[1].empty()) return fail("empty prompt");
+
+        Riddle r;
+        r.difficulty = f[0][0] - '0';
+        r.prompt = f[1];
+        r.correctIndex1Based = 0;
+        for (int i = 2; i < fields; ++i) {
+            std::string_view opt = f[i];
+            if (!opt.empty() && opt.front() == '*') {
+                if (r.correctIndex1Based) return fail("more than one answer marked '*'");
+                r.correctIndex1Based = i - 1;
+                opt = trim(opt.substr(1));
+            }
+            if (opt.empty()) return fail("empty option");
+            r.options[static_cast<std::size_t>(r.optionCount++)] = opt;
+        }
+        if (!r.correctIndex1Based) return fail("no answer marked '*'");
+        if (riddles_.size() == 0xFFFF) return fail("too many riddles");
+        riddles_.push_back(r);
+    }
+    return true;
+}
+
+bool RiddleBank::load(const std::string& path, std::string& error) {
+    std::ifstream in(path);
+    if (!in) {
+        riddles_.clear();
+        error = path + ": can't open";
+        return false;
+    }
+    std::stringstream src;
+    src << in.rdbuf();
+    return parse(src.str(), path, error);
+}
+
+int RiddleBank::count(int difficulty) const {
+    return static_cast<int>(std::count_if(riddles_.begin(), riddles_.end(),
+                                          [&](const Riddle& r) { return r.difficulty == difficulty; }));
+}
+
+const RiddleBank& DefaultRiddleBank() {
+    static RiddleBank bank;
+    static const bool loaded = [] {
+        std::string error;
+        if (!bank.load("assets/riddles.txt", error))
+            std::cerr << "riddle bank " << error << " (Apollo keeps his usual five)\n";
+        return true;
+    }();
+    (void)loaded;
+    return bank;
+}
+
+// --- shuffle bag ----------------------------------------------------------------
+
+RiddleBag::RiddleBag(const RiddleBank& bank, std::uint32_t seed)
+    : bank_(bank), rng_(seed), order_(bank.size()) {
+    for (std::size_t i = 0; i < order_.size(); ++i) order_[i] = static_cast<std::uint16_t>(i);
+    next_ = order_.size();   // shuffle on the first draw
+}
+
+RiddleSet RiddleBag::draw(int n) {
+    RiddleSet set;
+    n = std::min({n, static_cast<int>(order_.size()), RiddleSet::kMax});
+    auto inSet = [&](std::uint16_t id) {
+        for (const Riddle* r : set)
+            if (r == &bank_[id]) return true;
+        return false;
+    };
+
+    while (set.size() < n) {
+        if (next_ == order_.size()) {
+            std::shuffle(order_.begin(), order_.end(), rng_);
+            next_ = 0;
+        }
+        // Only after a reshuffle mid-draw can the front repeat this set; pull a
+        // fresh one forward instead (there are always enough, n <= bank size).
+        if (inSet(order_[next_])) {
+            std::size_t j = next_ + 1;
+            while (inSet(order_[j])) ++j;
+            std::swap(order_[next_], order_[j]);
+        }
+        set.push(bank_[order_[next_++]]);
+    }
+
+    // easiest first, so the hymn climbs
+    std::sort(set.at.begin(), set.at.begin() + set.count,
+              [](const Riddle* a, const Riddle* b) { return a->difficulty < b->difficulty; });
+    return set;
+}
@@ -1,17 +1,27 @@
 #include "SceneManager.hpp"
+#include "utils.hpp"
 #include <iostream>
+#include <string>
 
 
-void SceneManager::introScene() {
+void SceneManager::introScene(CancelToken& input, std::chrono::milliseconds idle) {
     std::cout << "THE ORACLES ARE BLEEDING\n\n";
     std::cout << "They gave her a name that was not hers: Cassandra.\n";
     std::cout << "You are _____, a former oracle, cast out.\n";
     std::cout << "Now the temple is open again.\n";
-    std::cout << "\n> Press ENTER to descend.\n";
-    std::cin.ignore();
+    std::cout << "\n> Press ENTER to descend.\n" << std::flush;
+    std::string _;
+    readLineOrCancel(_, input, idle);
 }
 
 void SceneManager::erisFinalScene() {
     std::cout << "A mirror reflects someone else. The choir begins to hum.\n";
 }
 
+void SceneManager::endingScene(const char* title, CancelToken& input, std::chrono::milliseconds idle) {
+    std::cout << "\n==== ENDING: " << title << " ====\n";
+    std::cout << "The temple closes around what you chose.\n";
+    std::cout << "\n> Press ENTER to return.\n" << std::flush;
+    std::string _;
+    readLineOrCancel(_, input, idle);
+}
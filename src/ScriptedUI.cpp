@@ -0,0 +1,51 @@
+// ScriptedUI.cpp
+#include "ScriptedUI.hpp"
+#include <cstdlib>
+
+ScriptedUI& ScriptedUI::answer(int choice) {
+    answers_.push_back(std::to_string(choice));
+    return *this;
+}
+
+ScriptedUI& ScriptedUI::answer(const std::string& text) {
+    answers_.push_back(text);
+    return *this;
+}
+
+void ScriptedUI::print(const std::string& s) {
+    transcript_.push_back(s);
+}
+
+int ScriptedUI::choose(const std::string& prompt, const std::vector<std::string>& options) {
+    transcript_.push_back("? " + prompt);
+    for (size_t i = 0; i < options.size(); ++i)
+        transcript_.push_back("  " + std::to_string(i + 1) + ") " + options[i]);
+
+    if (answers_.empty()) return ++misses_;
+    const int pick = std::atoi(answers_.front().c_str());
+    answers_.pop_front();
+    transcript_.push_back("> " + std::to_string(pick));
+    return pick;
+}
+
+std::string ScriptedUI::ask(const std::string& prompt) {
+    transcript_.push_back("? " + prompt);
+
+    if (answers_.empty()) { ++misses_; return {}; }
+    std::string s = std::move(answers_.front());
+    answers_.pop_front();
+    transcript_.push_back("> " + s);
+    return s;
+}
+
+bool ScriptedUI::saw(const std::string& needle) const {
+    for (const auto& line : transcript_)
+        if (line.find(needle) != std::string::npos) return true;
+    return false;
+}
+
+void ScriptedUI::clear() {
+    answers_.clear();
+    transcript_.clear();
+    misses_ = 0;
+}
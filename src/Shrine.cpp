@@ -4,7 +4,7 @@
 
 // Constructor
 Shrine::Shrine(const std::string& deity, const std::string& shrineRoom)
-    : deityName(deity), shrineRoomName(shrineRoom) {}
+    : deityName(deity), shrineRoomName(shrineRoom), handler_(Shrines().find(deity)) {}
 
 // State
 void Shrine::setState(ShrineState newState) { state = newState; }
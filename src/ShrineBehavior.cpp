@@ -1,415 +1,548 @@
-#include "ShrineBehavior.hpp"
+// ShrineBehavior.cpp
+// The shrine mechanics themselves, as ShrineCoroutines. Members hold anything
+// that lives across a SHRINE_CO_AWAIT; plain locals only inside blocks that
+// close before the next one.
+#include "ShrineBehaviorImpl.hpp"
+#include "EndingRules.hpp"
 #include "PersephoneFragments.hpp"
+#include "ScriptedUI.hpp"
 #include "UI.hpp"
 #include <algorithm>
-#include <iomanip>
-// --------------------- DEMETER -----------------------------------------------
-Outcome RunDemeterLetter_FromInventory(InteractionContext& ctx, UI& ui) {  Outcome out;
-
-    if (!HasAllPersephoneFragments(ctx.player)) {
-        auto owned = GetOwnedPersephoneFragments(ctx.player);
-        int have = (int)owned.size();
-        out.journalEntry =
-            "Demeter’s altar waits for the whole letter. You have only " + std::to_string(have) +
-            "/8 fragments. The grain will not answer yet. (-1 Will)";
-        out.willDelta -= 1;
-        return out;
-    }
-
-    auto owned = GetOwnedPersephoneFragments(ctx.player); // vector<(index,text)>
-    // Build a presentation list (we don’t show indices to the player—just the text)
-    std::vector<std::string> texts; texts.reserve(owned.size());
-    for (auto& p : owned) texts.push_back(p.second);
-
-    ui.print("Persephone’s scattered words lie before you. Put them in their true order.");
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <sstream>
+
+void ShrineCoroutine::showOdds(std::string_view what, int dc, int statScore, const CheckMods& mods) {
+    if (quiet_ || !ctx_.player.access.showOdds) return;
+    const long pct = std::lround(SkillCheck::successProbability(dc, statScore, mods) * 100.0);
+    print("(Odds to ", what, ": ", pct, "%)");
+}
 
-    std::vector<int> chosen; chosen.reserve(texts.size());
-    std::vector<bool> used(texts.size(), false);
+namespace {
 
-    while (chosen.size() < texts.size()) {
-        ui.print("Fragments:");
-        for (size_t i=0;i<texts.size();++i) {
-            std::string mark = used[i] ? "[X]" : "[ ]";
-            ui.print(mark + " " + std::to_string(i+1) + ": " + texts[i]);
+// --------------------- DEMETER -----------------------------------------------
+class DemeterLetter final : public ShrineCoroutine {
+public:
+    using ShrineCoroutine::ShrineCoroutine;
+
+private:
+    std::vector<std::pair<int, std::string>> owned_;   // (true index, text)
+    std::vector<int> chosen_;                          // display indices, in pick order
+    std::vector<bool> used_;
+
+    bool run() override {
+        SHRINE_CO_BEGIN;
+
+        if (!HasAllPersephoneFragments(ctx_.player)) {
+            int have = CountPersephoneFragments(ctx_.player);
+            out_.journalEntry =
+                "Demeter’s altar waits for the whole letter. You have only " + std::to_string(have) +
+                "/8 fragments. The grain will not answer yet. (-1 Will)";
+            out_.willDelta -= 1;
+            return true;
         }
-        int pick = ui.choose("Pick the next fragment in sequence:", {});
-        if (pick < 1 || pick > (int)texts.size() || used[pick-1]) {
-            ui.print("That fragment is not available. Try again.");
-            continue;
+
+        // We don’t show indices to the player—just the text
+        owned_ = GetOwnedPersephoneFragments(ctx_.player);
+        print("Persephone’s scattered words lie before you. Put them in their true order.");
+
+        chosen_.reserve(owned_.size());
+        used_.assign(owned_.size(), false);
+
+        while (chosen_.size() < owned_.size()) {
+            print("Fragments:");
+            for (size_t i = 0; i < owned_.size(); ++i)
+                print(used_[i] ? "[X]" : "[ ]", " ", i+1, ": ", owned_[i].second);
+            SHRINE_CO_AWAIT(choose("Pick the next fragment in sequence:"));
+            {
+                const int pick = reply_.choice;
+                if (pick < 1 || pick > (int)owned_.size() || used_[pick-1]) {
+                    print("That fragment is not available. Try again.");
+                    continue;
+                }
+                used_[pick-1] = true;
+                chosen_.push_back(pick);
+            }
         }
-        used[pick-1] = true;
-        chosen.push_back(pick);
-    }
 
-    // Map back to the *true indices* of what the player picked
-    // owned[k] = (trueIndex, text)
-    std::vector<int> pickedTrueOrder;
-    pickedTrueOrder.reserve(chosen.size());
-    for (int displayIdx : chosen) {
-        pickedTrueOrder.push_back(owned[displayIdx-1].first);
+        judge();
+        SHRINE_CO_END;
     }
 
-    // Correct order is 1..8
-    bool correct = true;
-    for (int i=0;i<8;++i) if (pickedTrueOrder[i] != i+1) { correct = false; break; }
-
-    if (correct) {
-        out.journalEntry =
-            "The letter settles into sense — ragged, but undeniable. Persephone chose this path.\n"
-            "The truth steels you. (+2 Will, +1 Nerve, +1 Insight)";
-        out.willDelta    += 2;
-        out.nerveDelta   += 1;
-        out.insightDelta += 1;
-        ctx.flags["demeter_letter_solved"] = true;
-    } else {
-        out.journalEntry =
-            "Your arrangement scrapes like bone on stone. The message becomes a chant with no mercy.\n"
-            "Doubt fills the seams. (-2 Will, -1 Nerve, -1 Health)";
-        out.willDelta   -= 2;
-        out.nerveDelta  -= 1;
-        out.healthDelta -= 1;
-        ctx.flags["demeter_letter_solved"] = false;
+    void judge() {
+        // Correct order is 1..8, in terms of the *true indices* picked
+        bool correct = true;
+        for (int i=0;i<8;++i) if (owned_[chosen_[i]-1].first != i+1) { correct = false; break; }
+
+        if (correct) {
+            out_.journalEntry =
+                "The letter settles into sense — ragged, but undeniable. Persephone chose this path.\n"
+                "The truth steels you. (+2 Will, +1 Nerve, +1 Insight)";
+            out_.willDelta    += 2;
+            out_.nerveDelta   += 1;
+            out_.insightDelta += 1;
+            ctx_.flags["demeter_letter_solved"] = true;
+        } else {
+            out_.journalEntry =
+                "Your arrangement scrapes like bone on stone. The message becomes a chant with no mercy.\n"
+                "Doubt fills the seams. (-2 Will, -1 Nerve, -1 Health)";
+            out_.willDelta   -= 2;
+            out_.nerveDelta  -= 1;
+            out_.healthDelta -= 1;
+            ctx_.flags["demeter_letter_solved"] = false;
+        }
     }
-
-    return out;
-}
-
-// Show the uncorrupted Demeter letter using a provided set of lines.
-// Minimal implementation: prints lines, records success.
-Outcome ShowDemeterLetter_Uncorrupted(InteractionContext& ctx,
-                                      UI& ui,
-                                      const std::vector<std::string>& choices)
-{
-    for (const auto& line : choices) {
-        ui.print(line);
+};
+
+// Shows the uncorrupted letter, records success. Never waits.
+class DemeterLetterClean final : public ShrineCoroutine {
+public:
+    DemeterLetterClean(InteractionContext& ctx, std::vector<std::string> lines)
+        : ShrineCoroutine(ctx), lines_(std::move(lines)) {}
+
+private:
+    std::vector<std::string> lines_;
+
+    bool run() override {
+        for (const auto& line : lines_) print(line);
+
+        out_.journalEntry =
+            "You read Demeter’s uncorrupted letter in full. The meaning settles like clean snow. "
+            "(+1 Insight)";
+        out_.insightDelta += 1;
+        ctx_.flags["demeter_letter_solved"] = true; // mark as learned/resolved
+        return true;
     }
+};
 
-    Outcome out;
-    out.journalEntry =
-        "You read Demeter’s uncorrupted letter in full. The meaning settles like clean snow. "
-        "(+1 Insight)";
-    out.insightDelta += 1;
-    ctx.flags["demeter_letter_solved"] = true; // mark as learned/resolved
-    return out;
-}
+// --------------------- NYX ----------------------------------------------------
+class NyxTrade final : public ShrineCoroutine {
+public:
+    NyxTrade(InteractionContext& ctx, TakeMelasEntryFn take, GiveMelasEntryFn give)
+        : ShrineCoroutine(ctx), takeOne_(std::move(take)), giveOne_(std::move(give)) {}
+
+private:
+    TakeMelasEntryFn takeOne_;
+    GiveMelasEntryFn giveOne_;
+
+    bool run() override {
+        print("Nyx’s bowl shows a page that is yours but never was. She asks for a trade.");
+
+        if (!takeOne_) {
+            out_.journalEntry = "You have nothing to give that Nyx will take. The water darkens. (-1 Will)";
+            out_.willDelta -= 1;
+            return true;
+        }
 
-Outcome ShowDemeterLetter_Uncorrupted(InteractionContext& ctx, UI& ui) {
-    return ShowDemeterLetter_Uncorrupted(ctx, ui, kPersephoneLetterClean);
-}
+        auto offered = takeOne_(); // remove one Melas journal entry
+        if (!offered.has_value()) {
+            out_.journalEntry = "Your journal is silent. Nyx offers only silence back. (-1 Will)";
+            out_.willDelta -= 1;
+            return true;
+        }
 
-// --------------------- NYX ----------------------------------------------------
-Outcome RunNyxTrade(InteractionContext& ctx, UI& ui,
-                    TakeMelasEntryFn takeOne, GiveMelasEntryFn giveOne)
-{
-    Outcome out;
-    ui.print("Nyx’s bowl shows a page that is yours but never was. She asks for a trade.");
-
-    if (!takeOne) {
-        out.journalEntry = "You have nothing to give that Nyx will take. The water darkens. (-1 Will)";
-        out.willDelta -= 1;
-        return out;
-    }
+        // 50/50 helpful or misleading
+        bool helpful = (ctx_.rng.roll(1,100) <= 50);
+        std::string newEntry;
 
-    auto offered = takeOne(); // remove one Melas journal entry
-    if (!offered.has_value()) {
-        out.journalEntry = "Your journal is silent. Nyx offers only silence back. (-1 Will)";
-        out.willDelta -= 1;
-        return out;
-    }
+        if (helpful) {
+            static const std::vector<std::string> boons = {
+                "The bowl reveals a hidden latch behind the Archivist’s shelf.",
+                "A cracked tile marks a crawlspace in Pan’s corridor.",
+                "Apollo’s third riddle lies: choose what sounds wrong."
+            };
+            newEntry = boons[ctx_.rng.roll(0, (int)boons.size()-1)];
+            out_.journalEntry =
+                "You surrender a page to the dark. In return, stars arrange into instruction. (+1 Insight)";
+            out_.insightDelta += 1;
+            ctx_.flags["nyx_helpful_trade"] = true;
+        } else {
+            static const std::vector<std::string> banes = {
+                "Follow the echo, not the voice. (It circles back to the false hall.)",
+                "Count the doors that aren’t there.",
+                "Sleep where the floor is warm."
+            };
+            newEntry = banes[ctx_.rng.roll(0, (int)banes.size()-1)];
+            out_.journalEntry =
+                "Your page sinks without a ripple. The mirror returns a crooked map. (+2 Corruption)";
+            out_.corruptionDelta += 2;
+            ctx_.flags["nyx_helpful_trade"] = false;
+        }
 
-    // 50/50 helpful or misleading
-    bool helpful = (ctx.rng.roll(1,100) <= 50);
-    std::string newEntry;
-
-    if (helpful) {
-        static const std::vector<std::string> boons = {
-            "The bowl reveals a hidden latch behind the Archivist’s shelf.",
-            "A cracked tile marks a crawlspace in Pan’s corridor.",
-            "Apollo’s third riddle lies: choose what sounds wrong."
-        };
-        newEntry = boons[ctx.rng.roll(0, (int)boons.size()-1)];
-        out.journalEntry =
-            "You surrender a page to the dark. In return, stars arrange into instruction. (+1 Insight)";
-        out.insightDelta += 1;
-        ctx.flags["nyx_helpful_trade"] = true;
-    } else {
-        static const std::vector<std::string> banes = {
-            "Follow the echo, not the voice. (It circles back to the false hall.)",
-            "Count the doors that aren’t there.",
-            "Sleep where the floor is warm."
-        };
-        newEntry = banes[ctx.rng.roll(0, (int)banes.size()-1)];
-        out.journalEntry =
-            "Your page sinks without a ripple. The mirror returns a crooked map. (+2 Corruption)";
-        out.corruptionDelta += 2;
-        ctx.flags["nyx_helpful_trade"] = false;
+        if (giveOne_) giveOne_(newEntry);
+        return true;
     }
-
-    if (giveOne) giveOne(newEntry);
-    return out;
-}
+};
 
 // --------------------- APOLLO -------------------------------------------------
-Outcome RunApolloRiddles(InteractionContext& ctx, UI& ui, const std::vector<Riddle>& set)
-{
-    Outcome out;
-    ui.print("Apollo’s lyre hums out of tune. The sun points the wrong way.");
-    int right = 0, total = (int)set.size();
-
-    for (const auto& r : set) {
-        int pick = ui.choose(r.prompt, r.options);
-        if (pick == r.correctIndex1Based) {
-            ui.print("The strings tighten—wrong feels right.");
-            ++right;
-        } else {
-            ui.print("A bright chord snaps.");
+class ApolloRiddles final : public ShrineCoroutine {
+public:
+    ApolloRiddles(InteractionContext& ctx, const RiddleSet& set)
+        : ShrineCoroutine(ctx), set_(set) {}
+
+private:
+    RiddleSet set_;
+    int next_ = 0;
+    int right_ = 0;
+
+    bool run() override {
+        SHRINE_CO_BEGIN;
+        print("Apollo’s lyre hums out of tune. The sun points the wrong way.");
+
+        for (next_ = 0; next_ < set_.size(); ++next_) {
+            SHRINE_CO_AWAIT(choose(set_[next_].prompt, set_[next_].options.begin(),
+                                   set_[next_].options.begin() + set_[next_].optionCount));
+            if (reply_.choice == set_[next_].correctIndex1Based) {
+                print("The strings tighten—wrong feels right.");
+                ++right_;
+            } else {
+                print("A bright chord snaps.");
+            }
         }
-    }
 
-    bool majority = right * 2 >= total; // 3/5 or better
-    if (majority) {
-        out.journalEntry =
-            "You answer what no one sane would. The hymn completes. (+1 Insight, +1 Health, +1 Nerve, -1 Will)";
-        out.insightDelta += 1;
-        out.healthDelta  += 1;
-        out.nerveDelta   += 1;
-        out.willDelta    -= 1; // sanity cost
-        ctx.flags["apollo_majority_right"] = true;
-    } else {
-        out.journalEntry =
-            "Sense betrays you. Apollo’s light fractures. (-2 Will, +2 Corruption)";
-        out.willDelta -= 2;
-        out.corruptionDelta += 2;
-        ctx.flags["apollo_majority_right"] = false;
+        if (right_ * 2 >= set_.size()) { // 3/5 or better
+            out_.journalEntry =
+                "You answer what no one sane would. The hymn completes. (+1 Insight, +1 Health, +1 Nerve, -1 Will)";
+            out_.insightDelta += 1;
+            out_.healthDelta  += 1;
+            out_.nerveDelta   += 1;
+            out_.willDelta    -= 1; // sanity cost
+            ctx_.flags["apollo_majority_right"] = true;
+        } else {
+            out_.journalEntry =
+                "Sense betrays you. Apollo’s light fractures. (-2 Will, +2 Corruption)";
+            out_.willDelta -= 2;
+            out_.corruptionDelta += 2;
+            ctx_.flags["apollo_majority_right"] = false;
+        }
+        SHRINE_CO_END;
     }
-    return out;
-}
+};
 
 // --------------------- FALSE HERMES ------------------------------------------
-Outcome RunFalseHermesEndlessHall(InteractionContext& ctx, UI& ui)
-{
-    Outcome out;
-    ui.print("A silver‑tongued path promises shortcuts and mercy. Your name sounds better there.");
-
-    int successes = 0, failures = 0;
-    while (successes < 5 && failures <= 5) {
-        CheckMods mods; // you could inject item buffs here
-        bool ok = SkillCheck::resolve(ctx.rng, /*dc=*/7 + (ctx.player.corruption/25),
-                                      ctx.player.stats.will, mods);
-        if (ok) {
-            ++successes;
-            ui.print("You avert your eyes. The corridor shortens by one lie. (" + std::to_string(successes) + "/5)");
-            // small reward to keep momentum
-            ctx.player.stats.will = std::min(10, ctx.player.stats.will + 1);
-        } else {
-            ++failures;
-            ui.print("You look back. The hall lengthens. (" + std::to_string(failures) + " fails)");
-            ctx.player.corruption = std::min(100, ctx.player.corruption + 2);
-            if (failures % 2 == 0) ctx.player.stats.will = std::max(0, ctx.player.stats.will - 1);
+// All dice, no questions: runs straight through on the first step().
+class FalseHermesHall final : public ShrineCoroutine {
+public:
+    using ShrineCoroutine::ShrineCoroutine;
+
+private:
+    bool run() override {
+        print("A silver‑tongued path promises shortcuts and mercy. Your name sounds better there.");
+
+        int successes = 0, failures = 0;
+        while (successes < 5 && failures <= 5) {
+            CheckMods mods; // you could inject item buffs here
+            const int dc = balance().hermesBaseDc + (ctx_.player.corruption / balance().hermesCorruptionStep);
+            showOdds("keep your eyes ahead", dc, ctx_.player.stats.will, mods);
+            bool ok = SkillCheck::resolve(ctx_.rng, dc, ctx_.player.stats.will, mods);
+            if (ok) {
+                ++successes;
+                print("You avert your eyes. The corridor shortens by one lie. (", successes, "/5)");
+                // small reward to keep momentum
+                ctx_.player.stats.will = std::min(10, ctx_.player.stats.will + 1);
+            } else {
+                ++failures;
+                print("You look back. The hall lengthens. (", failures, " fails)");
+                ctx_.player.corruption = std::min(100, ctx_.player.corruption + 2);
+                if (failures % 2 == 0) ctx_.player.stats.will = std::max(0, ctx_.player.stats.will - 1);
+            }
         }
-    }
 
-    if (failures > 5) {
-        out.journalEntry =
-            "You turn one more time and the hall seals like a mouth. (Bad Ending: Endless Hall)";
-        ctx.flags["false_hermes_endless_hall"] = true;
-        out.corruptionDelta += 10;
-        // You can handle ending outside by reading the flag.
-    } else {
-        out.journalEntry =
-            "You keep walking even when the floor begs you to stop. At last the echoes thin. (+2 Nerve)";
-        out.nerveDelta += 2;
-        ctx.flags["false_hermes_endless_hall"] = false;
+        if (failures > 5) {
+            out_.journalEntry =
+                "You turn one more time and the hall seals like a mouth. (Bad Ending: Endless Hall)";
+            ctx_.flags["false_hermes_endless_hall"] = true;
+            out_.corruptionDelta += balance().hermesTrapCorruption;
+        } else {
+            out_.journalEntry =
+                "You keep walking even when the floor begs you to stop. At last the echoes thin. (+" +
+                std::to_string(balance().hermesEscapeNerve) + " Nerve)";
+            out_.nerveDelta += balance().hermesEscapeNerve;
+            ctx_.flags["false_hermes_endless_hall"] = false;
+        }
+        return true;
     }
-    return out;
-}
+};
 
 // --------------------- THANATOS ----------------------------------------------
-Outcome RunThanatosRest(InteractionContext& ctx, UI& ui)
-{
-    Outcome out;
-    int c = ui.choose(
-        "Thanatos offers quiet: \"Lay down, and I will keep you.\"",
-        {"Lay down and rest.", "Keep moving forward."}
-    );
-
-    if (c == 1) {
-        out.journalEntry = "You sleep as if the world never asked for you. (Passive Ending)";
-        ctx.flags["thanatos_sleep_end"] = true;
-        // No stat deltas needed; caller should end game based on flag.
-    } else {
-        out.journalEntry = "You pass the offered bed. It feels like a kindness refused. (+1 Will)";
-        out.willDelta += 1;
-        ctx.flags["thanatos_sleep_end"] = false;
+class ThanatosRest final : public ShrineCoroutine {
+public:
+    using ShrineCoroutine::ShrineCoroutine;
+
+private:
+    bool run() override {
+        SHRINE_CO_BEGIN;
+        SHRINE_CO_AWAIT(choose("Thanatos offers quiet: \"Lay down, and I will keep you.\"",
+                               {"Lay down and rest.", "Keep moving forward."}));
+
+        if (reply_.choice == 1) {
+            out_.journalEntry = "You sleep as if the world never asked for you. (Passive Ending)";
+            ctx_.flags["thanatos_sleep_end"] = true;
+            // No stat deltas needed; the ending rules pick up the flag.
+        } else {
+            out_.journalEntry = "You pass the offered bed. It feels like a kindness refused. (+" +
+                                std::to_string(balance().thanatosRefuseWill) + " Will)";
+            out_.willDelta += balance().thanatosRefuseWill;
+            ctx_.flags["thanatos_sleep_end"] = false;
+        }
+        SHRINE_CO_END;
     }
-    return out;
-}
+};
 
 // --------------------- PAN ----------------------------------------------------
-Outcome RunPanMemory(InteractionContext& ctx, UI& ui, int rounds, int noteRange)
-{
-    Outcome out;
-    ui.print("A reed flute on the altar wheezes out a pattern. Then silence.");
-
-    int correctRounds = 0;
-    for (int r = 1; r <= rounds; ++r) {
-        std::vector<int> seq;
-        for (int i=0;i<r;++i) seq.push_back(ctx.rng.roll(1, noteRange));
-
-        // show sequence
-        {
-            std::string show = "Notes: ";
-            for (int n : seq) show += std::to_string(n) + " ";
-            ui.print(show);
-            ui.waitForKey(); // clear after
-            ui.print(std::string(40,'\n')); // crude “erase”
-        }
-
-        // ask player
-        std::string ans = ui.ask("Repeat the notes separated by spaces:");
-        std::vector<int> got;
-        {
-            std::istringstream iss(ans);
-            int x; while (iss >> x) got.push_back(x);
+class PanMemory final : public ShrineCoroutine {
+public:
+    PanMemory(InteractionContext& ctx, int rounds, int noteRange, PanTiming timing)
+        : ShrineCoroutine(ctx), rounds_(rounds), noteRange_(noteRange), timing_(timing) {}
+
+private:
+    int rounds_, noteRange_;
+    PanTiming timing_;
+    int round_ = 1;
+    int correctRounds_ = 0;
+    std::vector<int> seq_;
+    std::string notes_;
+
+    bool timed() const { return timing_.showMs > 0; }
+
+    bool run() override {
+        SHRINE_CO_BEGIN;
+        print("A reed flute on the altar wheezes out a pattern. Then silence.");
+
+        for (round_ = 1; round_ <= rounds_; ++round_) {
+            seq_.clear();
+            for (int i=0;i<round_;++i) seq_.push_back(ctx_.rng.roll(1, noteRange_));
+
+            // show sequence
+            notes_.clear();
+            if (!quiet()) {
+                notes_ = "Notes: ";
+                for (int n : seq_) notes_ += std::to_string(n) + " ";
+            }
+            if (timed()) {
+                SHRINE_CO_AWAIT(flash(notes_, timing_.showMs));   // gone when it resumes
+            } else {
+                print(notes_);
+                SHRINE_CO_AWAIT(waitForKey()); // clear after
+                blank(40); // crude “erase”
+            }
+
+            // ask player
+            SHRINE_CO_AWAIT(ask("Repeat the notes separated by spaces:"));
+            {
+                std::vector<int> got;
+                std::istringstream iss(reply_.text);
+                int x; while (iss >> x) got.push_back(x);
+
+                if (!timed()) {
+                    if (got == seq_) {
+                        ++correctRounds_;
+                        print("Your fingers remember what your eyes forgot.");
+                    } else {
+                        print("A sour squeal betrays your hesitation.");
+                    }
+                    continue;
+                }
+
+                // Timed: the answer has to beat the tune, not just match it.
+                const auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(reply_.elapsed).count();
+                const bool inTime = ms <= timing_.answerMs + timing_.perNoteMs * round_;
+                char took[32];
+                std::snprintf(took, sizeof took, " (%.2f s)", static_cast<double>(ms) / 1000.0);
+
+                if (got == seq_ && inTime) {
+                    ++correctRounds_;
+                    print("Your fingers remember what your eyes forgot.", took);
+                } else if (got == seq_) {
+                    print("The right notes, but the tune has already run on without you.", took);
+                } else {
+                    print("A sour squeal betrays your hesitation.", took);
+                }
+            }
         }
 
-        if (got == seq) {
-            ++correctRounds;
-            ui.print("Your fingers remember what your eyes forgot.");
+        if (correctRounds_ * 2 >= rounds_) {
+            out_.journalEntry = "Pan laughs through his teeth. Chaos approves. (+1 Health, +" +
+                                std::to_string(balance().panMasteredNerve) + " Nerve)";
+            out_.healthDelta += 1;
+            out_.nerveDelta += balance().panMasteredNerve;
+            ctx_.flags["pan_memory_mastered"] = true;
         } else {
-            ui.print("A sour squeal betrays your hesitation.");
+            out_.journalEntry = "The pattern crawls away. Your certainty shakes. (-1 Nerve, -1 Insight)";
+            out_.nerveDelta -= 1;
+            out_.insightDelta -= 1;
+            ctx_.flags["pan_memory_mastered"] = false;
         }
+        SHRINE_CO_END;
     }
-
-    if (correctRounds * 2 >= rounds) {
-        out.journalEntry = "Pan laughs through his teeth. Chaos approves. (+1 Health, +2 Nerve)";
-        out.healthDelta += 1;
-        out.nerveDelta += 2;
-        ctx.flags["pan_memory_mastered"] = true;
-    } else {
-        out.journalEntry = "The pattern crawls away. Your certainty shakes. (-1 Nerve, -1 Insight)";
-        out.nerveDelta -= 1;
-        out.insightDelta -= 1;
-        ctx.flags["pan_memory_mastered"] = false;
-    }
-    return out;
-}
-
+};
 
 // --------------------- HECATE -------------------------------------------------
-Outcome RunHecateDoors(InteractionContext& ctx, UI& ui, GiveMelasEntryFn giveOne)
-{
-    Outcome out;
-    ui.print("Three doors stand before you, each marked only by a faint sigil.");
-    int choice = ui.choose(
-        "Which door do you open?",
-        {"The First Door — to the Past", "The Second Door — to the Future", "The Third Door — to the Present"}
-    );
-
-    if (choice == 1) {
-        out.journalEntry =
-            "You step into memory’s embrace. The air smells of an old, safe place. "
-            "Your wounds knit, and your mind steadies. (+2 Will, +1 Insight, +1 Health)";
-        out.willDelta    += 2;
-        out.insightDelta += 1;
-        out.healthDelta  += 1;
-        ctx.flags["hecate_choice"] = 1;
-    }
-    else if (choice == 2) {
-        out.journalEntry =
-            "A vision takes root — something that has not yet happened, but will. "
-            "It scrawls itself into your journal.";
-        if (giveOne) {
-            static const std::vector<std::string> visions = {
-                "A door with no frame. Do not knock.",
-                "Two shadows pass over you, but the floor is empty.",
-                "When you hear the third bell, hide."
-            };
-            giveOne(visions[ctx.rng.roll(0, (int)visions.size()-1)]);
+class HecateDoors final : public ShrineCoroutine {
+public:
+    HecateDoors(InteractionContext& ctx, GiveMelasEntryFn give)
+        : ShrineCoroutine(ctx), giveOne_(std::move(give)) {}
+
+private:
+    GiveMelasEntryFn giveOne_;
+
+    bool run() override {
+        SHRINE_CO_BEGIN;
+        print("Three doors stand before you, each marked only by a faint sigil.");
+        SHRINE_CO_AWAIT(choose(
+            "Which door do you open?",
+            {"The First Door — to the Past", "The Second Door — to the Future", "The Third Door — to the Present"}
+        ));
+
+        if (reply_.choice == 1) {
+            out_.journalEntry =
+                "You step into memory’s embrace. The air smells of an old, safe place. "
+                "Your wounds knit, and your mind steadies. (+" + std::to_string(balance().hecatePastWill) +
+                " Will, +1 Insight, +1 Health)";
+            out_.willDelta    += balance().hecatePastWill;
+            out_.insightDelta += 1;
+            out_.healthDelta  += 1;
+            ctx_.flags["hecate_choice"] = 1;
         }
-        ctx.flags["hecate_choice"] = 2;
-    }
-    else {
-        out.journalEntry =
-            "You open the door. There is only a hallway that swallows sound. "
-            "Your chest tightens for no reason you can name. (-2 Will)";
-        out.willDelta -= 2;
-        ctx.flags["hecate_choice"] = 3;
+        else if (reply_.choice == 2) {
+            out_.journalEntry =
+                "A vision takes root — something that has not yet happened, but will. "
+                "It scrawls itself into your journal.";
+            if (giveOne_) {
+                static const std::vector<std::string> visions = {
+                    "A door with no frame. Do not knock.",
+                    "Two shadows pass over you, but the floor is empty.",
+                    "When you hear the third bell, hide."
+                };
+                giveOne_(visions[ctx_.rng.roll(0, (int)visions.size()-1)]);
+            }
+            ctx_.flags["hecate_choice"] = 2;
+        }
+        else {
+            out_.journalEntry =
+                "You open the door. There is only a hallway that swallows sound. "
+                "Your chest tightens for no reason you can name. (-" +
+                std::to_string(balance().hecatePresentWill) + " Will)";
+            out_.willDelta -= balance().hecatePresentWill;
+            ctx_.flags["hecate_choice"] = 3;
+        }
+        SHRINE_CO_END;
     }
-
-    return out;
-}
-
+};
 
 // --------------------- ERIS ---------------------------------------------------
-Outcome RunErisFinal(InteractionContext& ctx, UI& ui)
-{
-    Outcome out;
-    ui.print("Eris arranges bones like wind chimes. Lysaia stands beside her, eyes bright and far.");
-
-    // Score what the player learned/did. You can tune these weights.
-    int score = 0;
-    if (ctx.flags["demeter_letter_solved"])  score += 2;
-    if (ctx.flags["apollo_majority_right"])  score += 2;
-    if (ctx.flags["pan_memory_mastered"])    score += 2;
-    if (ctx.flags["nyx_helpful_trade"])      score += 1;
-    if (ctx.flags["false_hermes_endless_hall"]) score -= 999; // shouldn’t be here if trapped
-
-    // Dialogue fork – very light; replace with your system later.
-    int choice = ui.choose(
-        "Three paths open:\n"
-        "1) Resist them both.\n"
-        "2) Speak to Lysaia alone.\n"
-        "3) Accept Eris’ offer.",
-        {"Resist", "Plead with Lysaia", "Join the Bone Choir"}
-    );
-
-    if (choice == 3) {
-        out.journalEntry =
-            "You step into the harmony of breaking. (Ending: Joined the Bone Choir)";
-        ctx.flags["ending_join_eris"] = true;
-        out.corruptionDelta += 10;
-        return out;
-    }
-
-    if (choice == 2) {
-        // Persuade Lysaia – base on score + Will
-        int dc = 8;
-        CheckMods mods; mods.flat = (score >= 4 ? 2 : 0); // strong prep helps
-        bool ok = SkillCheck::resolve(ctx.rng, dc, ctx.player.stats.will, mods);
-        if (ok) {
-            out.journalEntry =
-                "You call her by the name only you used. Something in her loosens. (Ending: Lysaia Turns)";
-            ctx.flags["ending_save_lysaia"] = true;
-            out.willDelta += 2;
-            return out;
-        } else {
-            out.journalEntry =
-                "Your words reach her and shatter anyway. Eris smiles with all her teeth. (-2 Will)";
-            out.willDelta -= 2;
-            ctx.flags["ending_save_lysaia"] = false;
-            return out;
+class ErisFinal final : public ShrineCoroutine {
+public:
+    using ShrineCoroutine::ShrineCoroutine;
+
+private:
+    int score_ = 0;
+
+    bool run() override {
+        SHRINE_CO_BEGIN;
+        print("Eris arranges bones like wind chimes. Lysaia stands beside her, eyes bright and far.");
+
+        // Score what the player learned/did. Weights live in ErisScoreDefs().
+        score_ = ErisScoreRules().score(ctx_.flags, ctx_.player);
+
+        // Same mods the checks below use, so the hint matches the roll.
+        showOdds("resist (Nerve)", balance().erisResistDc, ctx_.player.stats.nerve, resistMods());
+        showOdds("reach Lysaia (Will)", balance().erisPleadDc, ctx_.player.stats.will, pleadMods());
+
+        // Dialogue fork – very light; replace with your system later.
+        SHRINE_CO_AWAIT(choose(
+            "Three paths open:\n"
+            "1) Resist them both.\n"
+            "2) Speak to Lysaia alone.\n"
+            "3) Accept Eris’ offer.",
+            {"Resist", "Plead with Lysaia", "Join the Bone Choir"}
+        ));
+
+        if (reply_.choice == 3) {
+            out_.journalEntry =
+                "You step into the harmony of breaking. (Ending: Joined the Bone Choir)";
+            ctx_.flags["ending_join_eris"] = true;
+            out_.corruptionDelta += 10;
+        }
+        else if (reply_.choice == 2) {
+            // Persuade Lysaia – base on score + Will
+            if (SkillCheck::resolve(ctx_.rng, balance().erisPleadDc, ctx_.player.stats.will, pleadMods())) {
+                out_.journalEntry =
+                    "You call her by the name only you used. Something in her loosens. (Ending: Lysaia Turns)";
+                ctx_.flags["ending_save_lysaia"] = true;
+                out_.willDelta += balance().erisPleadWill;
+            } else {
+                out_.journalEntry =
+                    "Your words reach her and shatter anyway. Eris smiles with all her teeth. (-" +
+                    std::to_string(balance().erisPleadWill) + " Will)";
+                out_.willDelta -= balance().erisPleadWill;
+                ctx_.flags["ending_save_lysaia"] = false;
+            }
         }
+        else {
+            // straight resist test using accumulated knowledge
+            if (SkillCheck::resolve(ctx_.rng, balance().erisResistDc, ctx_.player.stats.nerve, resistMods())) {
+                out_.journalEntry =
+                    "You refuse, and refuse, until refusal is all that remains. (Ending: Overcame the Offer)";
+                ctx_.flags["ending_overcome"] = true;
+                out_.nerveDelta += balance().erisResistNerve;
+            } else {
+                out_.journalEntry =
+                    "Your stance wavers at the last word. She catches it. (Ending: Claimed by Discord)";
+                ctx_.flags["ending_claimed"] = true;
+                out_.corruptionDelta += balance().erisClaimedCorruption;
+                out_.willDelta -= 2;
+            }
+        }
+        SHRINE_CO_END;
     }
 
-    // choice == 1: straight resist test using accumulated knowledge
-    {
-        int dc = 9;
-        CheckMods mods;
-        if (score >= 5) mods.advantage = true;
-        bool ok = SkillCheck::resolve(ctx.rng, dc, ctx.player.stats.nerve, mods);
-        if (ok) {
-            out.journalEntry =
-                "You refuse, and refuse, until refusal is all that remains. (Ending: Overcame the Offer)";
-            ctx.flags["ending_overcome"] = true;
-            out.nerveDelta += 2;
-        } else {
-            out.journalEntry =
-                "Your stance wavers at the last word. She catches it. (Ending: Claimed by Discord)";
-            ctx.flags["ending_claimed"] = true;
-            out.corruptionDelta += 5;
-            out.willDelta -= 2;
-        }
-        return out;
+    // strong prep helps
+    CheckMods pleadMods() const {
+        CheckMods m; m.flat = (score_ >= balance().erisPleadScore ? balance().erisPleadBonus : 0); return m;
     }
+    CheckMods resistMods() const { CheckMods m; m.advantage = (score_ >= balance().erisResistScore); return m; }
+};
+
+} // namespace
+
+// --- factories ----------------------------------------------------------------
+std::unique_ptr<ShrineCoroutine> StartDemeterLetter_FromInventory(InteractionContext& ctx) {
+    return std::make_unique<DemeterLetter>(ctx);
+}
+std::unique_ptr<ShrineCoroutine> StartDemeterLetter_Uncorrupted(InteractionContext& ctx,
+                                                                 const std::vector<std::string>& choices) {
+    return std::make_unique<DemeterLetterClean>(ctx, choices);
 }
+std::unique_ptr<ShrineCoroutine> StartNyxTrade(InteractionContext& ctx, TakeMelasEntryFn take, GiveMelasEntryFn give) {
+    return std::make_unique<NyxTrade>(ctx, std::move(take), std::move(give));
+}
+std::unique_ptr<ShrineCoroutine> StartApolloRiddles(InteractionContext& ctx, const RiddleSet& set) {
+    return std::make_unique<ApolloRiddles>(ctx, set);
+}
+std::unique_ptr<ShrineCoroutine> StartHecateDoors(InteractionContext& ctx, GiveMelasEntryFn give) {
+    return std::make_unique<HecateDoors>(ctx, std::move(give));
+}
+std::unique_ptr<ShrineCoroutine> StartPanMemory(InteractionContext& ctx, int rounds, int noteRange,
+                                                PanTiming timing) {
+    return std::make_unique<PanMemory>(ctx, rounds, noteRange, timing);
+}
+PanRules PanRulesFor(const PlayerState& player) {
+    PanRules rules;
+    rules.timing.showMs = player.access.panFlashMs;
+    return rules;
+}
+std::unique_ptr<ShrineCoroutine> StartFalseHermesEndlessHall(InteractionContext& ctx) {
+    return std::make_unique<FalseHermesHall>(ctx);
+}
+std::unique_ptr<ShrineCoroutine> StartThanatosRest(InteractionContext& ctx) {
+    return std::make_unique<ThanatosRest>(ctx);
+}
+std::unique_ptr<ShrineCoroutine> StartErisFinal(InteractionContext& ctx) {
+    return std::make_unique<ErisFinal>(ctx);
+}
+
+// The two backends the game and its tools link against.
+SHRINE_BEHAVIOR_INSTANTIATE(, UI)
+SHRINE_BEHAVIOR_INSTANTIATE(, ScriptedUI)
@@ -0,0 +1,165 @@
+// ShrineModel.cpp
+#include "ShrineModel.hpp"
+#include "FalseHermesSolver.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace model {
+
+State apply(State s, const Delta& d) {
+    s.health     = std::clamp(s.health  + d.health,  0, 10);
+    s.will       = std::clamp(s.will    + d.will,    0, 10);
+    s.insight    = std::clamp(s.insight + d.insight, 0, 10);
+    s.nerve      = std::clamp(s.nerve   + d.nerve,   0, 10);
+    s.corruption = std::clamp(s.corruption + d.corruption, 0, 100);
+    return s;
+}
+
+double AtLeast(const std::vector<double>& chances, int k) {
+    std::vector<double> ways(chances.size() + 1, 0.0);   // ways[j] = P(j successes so far)
+    ways[0] = 1.0;
+    for (size_t i = 0; i < chances.size(); ++i) {
+        for (size_t j = i + 1; j > 0; --j)
+            ways[j] = ways[j] * (1 - chances[i]) + ways[j - 1] * chances[i];
+        ways[0] *= 1 - chances[i];
+    }
+    double sum = 0;
+    for (size_t j = static_cast<size_t>(std::max(0, k)); j < ways.size(); ++j) sum += ways[j];
+    return sum;
+}
+
+namespace {
+
+// Where a branch goes: on to the next shrine, or out of the run.
+struct Emit {
+    std::vector<Branch>& out;
+    void cont(const State& s, double p)           { if (p > 0) out.push_back({s, p, false, Ending::None}); }
+    void end(const State& s, double p, Ending e)  { if (p > 0) out.push_back({s, p, true, e}); }
+};
+
+// --------------------- DEMETER -----------------------------------------------
+void stepDemeter(const State& s, const ShrinePlay& pol, Emit& out) {
+    if (pol.view == WorldView::Uncorrupted) {
+        State t = apply(s, {0, 0, +1, 0, 0}); t.set(F_Demeter, true);
+        out.cont(t, 1);
+        return;
+    }
+    if (pol.demeterFragments < kFragments) { out.cont(apply(s, {0, -1, 0, 0, 0}), 1); return; }
+
+    const double win = pol.demeterOrder == ShrinePlay::Order::Known  ? 1.0
+                     : pol.demeterOrder == ShrinePlay::Order::Random ? 1.0 / kFragmentOrders
+                     : 0.0;
+    State ok  = apply(s, {0, +2, +1, +1, 0});  ok.set(F_Demeter, true);
+    State bad = apply(s, {-1, -2, 0, -1, 0});  bad.set(F_Demeter, false);
+    out.cont(ok, win);
+    out.cont(bad, 1 - win);
+}
+
+// --------------------- NYX ----------------------------------------------------
+void stepNyx(const State& s, const ShrinePlay& pol, Emit& out) {
+    if (!pol.nyxHasPages) { out.cont(apply(s, {0, -1, 0, 0, 0}), 1); return; }
+    State boon = apply(s, {0, 0, +1, 0, 0});  boon.set(F_Nyx, true);
+    State bane = apply(s, {0, 0, 0, 0, +2});  bane.set(F_Nyx, false);
+    out.cont(boon, 0.5);
+    out.cont(bane, 0.5);
+}
+
+// --------------------- APOLLO -------------------------------------------------
+void stepApollo(const State& s, const ShrinePlay& pol, Emit& out) {
+    const int known = std::clamp(pol.apolloKnown, 0, kApolloRiddles);
+    std::vector<double> chances(kApolloRiddles, pol.apolloGuessRest ? 1.0 / kApolloOptions : 0.0);
+    std::fill(chances.begin(), chances.begin() + known, 1.0);
+    const double win = AtLeast(chances, (kApolloRiddles + 1) / 2);   // right*2 >= total
+
+    State ok  = apply(s, {+1, -1, +1, +1, 0});  ok.set(F_Apollo, true);
+    State bad = apply(s, {0, -2, 0, 0, +2});    bad.set(F_Apollo, false);
+    out.cont(ok, win);
+    out.cont(bad, 1 - win);
+}
+
+// --------------------- HECATE -------------------------------------------------
+void stepHecate(const State& s, const ShrinePlay& pol, const BalanceParams& b, Emit& out) {
+    if (pol.hecateDoor == 1)      out.cont(apply(s, {+1, +b.hecatePastWill, +1, 0, 0}), 1);
+    else if (pol.hecateDoor == 2) out.cont(s, 1);
+    else                          out.cont(apply(s, {0, -b.hecatePresentWill, 0, 0, 0}), 1);
+}
+
+// --------------------- PAN ----------------------------------------------------
+void stepPan(const State& s, const ShrinePlay& pol, const BalanceParams& b, Emit& out) {
+    std::vector<double> chances;
+    for (int r = 1; r <= kPanRounds; ++r) {
+        if (r <= pol.panRecall)   chances.push_back(1.0);
+        else if (pol.panGuessRest) chances.push_back(std::pow(1.0 / kPanNoteRange, r));
+        else                       chances.push_back(0.0);
+    }
+    const double win = AtLeast(chances, (kPanRounds + 1) / 2);        // correct*2 >= rounds
+
+    State ok  = apply(s, {+1, 0, 0, +b.panMasteredNerve, 0});   ok.set(F_Pan, true);
+    State bad = apply(s, {0, 0, -1, -1, 0});   bad.set(F_Pan, false);
+    out.cont(ok, win);
+    out.cont(bad, 1 - win);
+}
+
+// --------------------- FALSE HERMES ------------------------------------------
+// The check loop is solved once per (will, corruption) in FalseHermesTable;
+// just fan out over the ways it can end.
+void stepFalseHermes(const State& s, const ShrinePlay&, const BalanceParams& b, Emit& out) {
+    const FalseHermesTable& table = FalseHermesTable::forBalance(b);
+    for (auto it = table.finalsBegin(s.will, s.corruption); it != table.finalsEnd(s.will, s.corruption); ++it) {
+        State t = s;
+        t.will = it->will;
+        t.corruption = it->corruption;
+        if (it->trapped) out.end(apply(t, {0, 0, 0, 0, +b.hermesTrapCorruption}), it->p, Ending::EndlessHall);
+        else             out.cont(apply(t, {0, 0, 0, +b.hermesEscapeNerve, 0}), it->p);
+    }
+}
+
+// --------------------- THANATOS ----------------------------------------------
+void stepThanatos(const State& s, const ShrinePlay& pol, const BalanceParams& b, Emit& out) {
+    if (pol.thanatosChoice == 1) out.end(s, 1, Ending::ThanatosSleep);
+    else                         out.cont(apply(s, {0, +b.thanatosRefuseWill, 0, 0, 0}), 1);
+}
+
+// --------------------- ERIS ---------------------------------------------------
+void stepEris(const State& s, const ShrinePlay& pol, const BalanceParams& b, Emit& out) {
+    int score = 0;
+    if (s.has(F_Demeter)) score += 2;
+    if (s.has(F_Apollo))  score += 2;
+    if (s.has(F_Pan))     score += 2;
+    if (s.has(F_Nyx))     score += 1;
+
+    if (pol.erisChoice == 3) { out.end(apply(s, {0, 0, 0, 0, +10}), 1, Ending::JoinedChoir); return; }
+
+    if (pol.erisChoice == 2) {
+        CheckMods mods; mods.flat = (score >= b.erisPleadScore ? b.erisPleadBonus : 0);
+        const double win = SkillCheck::successProbability(b.erisPleadDc, s.will, mods);
+        out.end(apply(s, {0, +b.erisPleadWill, 0, 0, 0}), win, Ending::LysaiaTurns);
+        out.end(apply(s, {0, -b.erisPleadWill, 0, 0, 0}), 1 - win, Ending::None);
+        return;
+    }
+
+    CheckMods mods; mods.advantage = (score >= b.erisResistScore);
+    const double win = SkillCheck::successProbability(b.erisResistDc, s.nerve, mods);
+    out.end(apply(s, {0, 0, 0, +b.erisResistNerve, 0}), win, Ending::Overcame);
+    out.end(apply(s, {0, -2, 0, 0, +b.erisClaimedCorruption}), 1 - win, Ending::Claimed);
+}
+
+} // namespace
+
+void ExpandShrine(Deity shrine, const State& s, const ShrinePlay& play, std::vector<Branch>& out,
+                  const BalanceParams& b) {
+    Emit emit{out};
+    switch (shrine) {
+        case Deity::Demeter:     stepDemeter(s, play, emit);     break;
+        case Deity::Nyx:         stepNyx(s, play, emit);         break;
+        case Deity::Apollo:      stepApollo(s, play, emit);      break;
+        case Deity::Hecate:      stepHecate(s, play, b, emit);      break;
+        case Deity::Pan:         stepPan(s, play, b, emit);         break;
+        case Deity::FalseHermes: stepFalseHermes(s, play, b, emit); break;
+        case Deity::Thanatos:    stepThanatos(s, play, b, emit);    break;
+        case Deity::Eris:        stepEris(s, play, b, emit);        break;
+        default:                 emit.cont(s, 1);                break;   // Persephone: quiet altar
+    }
+}
+
+} // namespace model
@@ -0,0 +1,246 @@
+// ShrineRegistry.cpp
+#include "ShrineRegistry.hpp"
+#include "ShrineCoroutine.hpp"
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cstddef>
+#include <filesystem>
+#include <iostream>
+
+#if defined(_WIN32)
+#  include <windows.h>
+#else
+#  include <dlfcn.h>
+#endif
+
+// --- registry ---------------------------------------------------------------
+std::string ShrineRegistry::normalize(std::string_view name) {
+    std::string n;
+    n.reserve(name.size());
+    for (char c : name) {
+        if (c == ' ' || c == '-') c = '_';
+        n.push_back(static_cast<char>(std::tolower(static_cast<unsigned char>(c))));
+    }
+    return n;
+}
+
+int ShrineRegistry::lookup(const std::string& normalized) const {
+    for (const auto& [known, id] : names_)
+        if (known == normalized) return id;
+    return -1;
+}
+
+bool ShrineRegistry::add(ShrineHandler handler) {
+    const std::string key = normalize(handler.key);
+    if (key.empty() || lookup(key) >= 0 || handlers_.size() > 0xFFFF) return false;
+    const auto id = static_cast<ShrineHandlerId>(handlers_.size());
+    names_.emplace_back(key, id);
+    if (!handler.label.empty() && normalize(handler.label) != key) names_.emplace_back(normalize(handler.label), id);
+    handlers_.push_back(std::move(handler));
+    return true;
+}
+
+void ShrineRegistry::alias(const std::string& name, const std::string& key) {
+    const int id = lookup(normalize(key));
+    if (id >= 0) names_.emplace_back(normalize(name), static_cast<ShrineHandlerId>(id));
+}
+
+ShrineHandlerId ShrineRegistry::find(std::string_view name) const {
+    const int id = lookup(normalize(name));
+    return id >= 0 ? static_cast<ShrineHandlerId>(id) : kQuietShrine;
+}
+
+std::unique_ptr<ShrineCoroutine> ShrineRegistry::start(ShrineHandlerId id, InteractionContext& ctx,
+                                                       const ShrineServices& svc) const {
+    const ShrineHandler& h = get(id);
+    if (h.module) return StartModuleShrine(*h.module, ctx);
+    if (h.start)  return h.start(ctx, svc);
+    return get(kQuietShrine).start(ctx, svc);
+}
+
+// --- modules ----------------------------------------------------------------
+bool ShrineRegistry::loadModule(const std::string& path, std::string& error) {
+#if defined(_WIN32)
+    HMODULE lib = LoadLibraryA(path.c_str());
+    if (!lib) { error = path + ": can't load"; return false; }
+    auto entry = reinterpret_cast<ShrineModuleEntryFn>(GetProcAddress(lib, SHRINE_MODULE_ENTRY));
+    auto unload = [lib] { FreeLibrary(lib); };
+#else
+    void* lib = dlopen(path.c_str(), RTLD_NOW | RTLD_LOCAL);
+    if (!lib) { error = dlerror(); return false; }
+    auto entry = reinterpret_cast<ShrineModuleEntryFn>(dlsym(lib, SHRINE_MODULE_ENTRY));
+    auto unload = [lib] { dlclose(lib); };
+#endif
+    const ShrineModuleInfo* info = entry ? entry() : nullptr;
+    if (!info) {
+        error = path + ": no " SHRINE_MODULE_ENTRY "()";
+        unload();
+        return false;
+    }
+    if (info->abi != SHRINE_MODULE_ABI) {
+        error = path + ": built for shrine ABI " + std::to_string(info->abi) +
+                ", this game speaks " + std::to_string(SHRINE_MODULE_ABI);
+        unload();
+        return false;
+    }
+
+    // All or nothing: a module with a taken key adds none of its shrines.
+    std::vector<std::string> keys, taken;
+    for (std::uint32_t i = 0; i < info->count; ++i) {
+        const ShrineModuleHandler& h = info->handlers[i];
+        if (!h.key || !h.step) continue;
+        const std::string key = normalize(h.key);
+        if (key.empty() || lookup(key) >= 0 || std::find(keys.begin(), keys.end(), key) != keys.end())
+            taken.push_back(h.key);
+        keys.push_back(key);
+    }
+    if (!taken.empty() || keys.empty() || handlers_.size() + keys.size() > 0x10000) {
+        if (keys.empty()) error = path + ": no shrines in it";
+        else if (taken.empty()) error = path + ": too many shrines";
+        else {
+            error = path + ": shrine" + (taken.size() > 1 ? "s " : " ");
+            for (std::size_t i = 0; i < taken.size(); ++i) error += (i ? ", '" : "'") + taken[i] + "'";
+            error += taken.size() > 1 ? " are already taken" : " is already taken";
+        }
+        unload();
+        return false;
+    }
+
+    for (std::uint32_t i = 0; i < info->count; ++i) {
+        const ShrineModuleHandler& h = info->handlers[i];
+        if (h.key && h.step) add({h.key, h.label ? h.label : h.key, Deity::Default, nullptr, &h});
+    }
+    return true;   // stays loaded for good: handlers point into it
+}
+
+int ShrineRegistry::loadModules(const std::string& dir) {
+    namespace fs = std::filesystem;
+    std::error_code ec;
+    std::vector<fs::path> files;
+    for (const fs::directory_entry& e : fs::directory_iterator(dir, ec)) {
+        const std::string ext = e.path().extension().string();
+        if (e.is_regular_file(ec) && (ext == ".so" || ext == ".dll" || ext == ".dylib"))
+            files.push_back(e.path());
+    }
+    std::sort(files.begin(), files.end());
+
+    const std::size_t before = handlers_.size();
+    for (const fs::path& f : files) {
+        std::string error;
+        if (!loadModule(f.string(), error))
+            std::cerr << "shrine module " << error << " (skipped)\n";
+    }
+    return static_cast<int>(handlers_.size() - before);
+}
+
+// --- the game's registry ----------------------------------------------------
+namespace {
+std::string& moduleDir() {
+    static std::string dir = "bin/modules";
+    return dir;
+}
+} // namespace
+
+void SetShrineModuleDir(const std::string& dir) { moduleDir() = dir; }
+
+ShrineRegistry& Shrines() {
+    static ShrineRegistry registry = [] {
+        ShrineRegistry r;
+        AddBuiltinShrines(r);
+        if (!moduleDir().empty()) r.loadModules(moduleDir());
+        return r;
+    }();
+    return registry;
+}
+
+// --- module host --------------------------------------------------------------
+namespace {
+
+const char* str(const char* s) { return s ? s : ""; }
+
+// A module's visit. The module's state lives here, zeroed, aligned for
+// anything; the host calls only ever touch this one coroutine.
+class ModuleShrine final : public ShrineCoroutine {
+public:
+    ModuleShrine(const ShrineModuleHandler& h, InteractionContext& ctx)
+        : ShrineCoroutine(ctx), h_(h),
+          state_((h.state_size + sizeof(std::max_align_t) - 1) / sizeof(std::max_align_t) + 1) {}
+
+private:
+    bool run() override { return h_.step(state_.data(), &kApi, reinterpret_cast<ShrineHost*>(this)) != 0; }
+
+    static ModuleShrine& self(ShrineHost* h) { return *reinterpret_cast<ModuleShrine*>(h); }
+
+    static int stat(ShrineHost* h, int which) {
+        const PlayerState& p = self(h).ctx_.player;
+        switch (which) {
+            case SHRINE_STAT_HEALTH:     return p.stats.health;
+            case SHRINE_STAT_WILL:       return p.stats.will;
+            case SHRINE_STAT_INSIGHT:    return p.stats.insight;
+            case SHRINE_STAT_NERVE:      return p.stats.nerve;
+            case SHRINE_STAT_CORRUPTION: return p.corruption;
+            default:                     return 0;
+        }
+    }
+    static int view(ShrineHost* h) {
+        return self(h).ctx_.view == WorldView::Corrupted ? SHRINE_VIEW_MELAS : SHRINE_VIEW_LYSAIA;
+    }
+    static int corrupted(ShrineHost* h) { return self(h).ctx_.shrineState == ShrineState::CORRUPTED; }
+    static int roll(ShrineHost* h, int lo, int hi) { return self(h).ctx_.rng.roll(std::min(lo, hi), std::max(lo, hi)); }
+    static int flag(ShrineHost* h, const char* name) { return self(h).ctx_.flags[str(name)] ? 1 : 0; }
+    static void setFlag(ShrineHost* h, const char* name, int value) { self(h).ctx_.flags[str(name)] = value != 0; }
+    static int hasItem(ShrineHost* h, const char* key) {
+        const ItemId id = ItemIdFromKey(str(key));
+        return id != ItemId::Count && self(h).ctx_.player.hasItem(id);
+    }
+
+    static void print(ShrineHost* h, const char* line) { self(h).ShrineCoroutine::print(str(line)); }
+    static void add(ShrineHost* h, int which, int delta) {
+        Outcome& o = self(h).out_;
+        switch (which) {
+            case SHRINE_STAT_HEALTH:     o.healthDelta += delta; break;
+            case SHRINE_STAT_WILL:       o.willDelta += delta; break;
+            case SHRINE_STAT_INSIGHT:    o.insightDelta += delta; break;
+            case SHRINE_STAT_NERVE:      o.nerveDelta += delta; break;
+            case SHRINE_STAT_CORRUPTION: o.corruptionDelta += delta; break;
+            default: break;
+        }
+    }
+    static void giveItem(ShrineHost* h, const char* key) {
+        const ItemId id = ItemIdFromKey(str(key));
+        if (id != ItemId::Count) self(h).out_.itemsGained.push_back(id);
+    }
+    static void journal(ShrineHost* h, const char* entry) { self(h).out_.journalEntry = str(entry); }
+
+    static void choose(ShrineHost* h, const char* text, const char* const* options, int count) {
+        const int n = options ? std::max(0, count) : 0;
+        self(h).ShrineCoroutine::choose(str(text), options, options + n);
+    }
+    static void ask(ShrineHost* h, const char* text) { self(h).ShrineCoroutine::ask(str(text)); }
+    static void waitKey(ShrineHost* h) { self(h).ShrineCoroutine::waitForKey(); }
+    static void flash(ShrineHost* h, const char* text, int ms) { self(h).ShrineCoroutine::flash(str(text), ms); }
+
+    static int replyChoice(ShrineHost* h) { return self(h).reply_.choice; }
+    static const char* replyText(ShrineHost* h) { return self(h).reply_.text.c_str(); }
+    static int replyMs(ShrineHost* h) {
+        return static_cast<int>(std::chrono::duration_cast<std::chrono::milliseconds>(self(h).reply_.elapsed).count());
+    }
+
+    static constexpr ShrineHostApi kApi = {
+        SHRINE_MODULE_ABI,
+        stat, view, corrupted, roll, flag, setFlag, hasItem,
+        print, add, giveItem, journal,
+        choose, ask, waitKey, flash,
+        replyChoice, replyText, replyMs,
+    };
+
+    const ShrineModuleHandler& h_;
+    std::vector<std::max_align_t> state_;
+};
+
+} // namespace
+
+std::unique_ptr<ShrineCoroutine> StartModuleShrine(const ShrineModuleHandler& handler, InteractionContext& ctx) {
+    return std::make_unique<ModuleShrine>(handler, ctx);
+}
@@ -1,97 +1,142 @@
-#include "ShrineRunner.hpp"
-#include "ShrineBehavior.hpp"   // Run* helpers + Riddle
-#include <algorithm>
-#include <cctype>
+#include "ShrineRunnerImpl.hpp"   // RunShrine + Run* helpers
+#include "RiddleBank.hpp"
+#include "ShrineRegistry.hpp"
+#include "ShrineScript.hpp"
+#include <cassert>
+#include <memory>
 #include <vector>
 
 // --- helpers ---------------------------------------------------------------
-static std::string lower(std::string s) {
-    std::transform(s.begin(), s.end(), s.begin(),
-                   [](unsigned char c){ return static_cast<char>(std::tolower(c)); });
-    return s;
-}
+namespace {
+// Shrines with no mechanic yet.
+class QuietAltar final : public ShrineCoroutine {
+public:
+    using ShrineCoroutine::ShrineCoroutine;
+private:
+    bool run() override {
+        out_.journalEntry = "The altar is quiet. Nothing answers you.";
+        return true;
+    }
+};
+} // namespace
 
 Deity DeityFromName(const std::string& deityName) {
-    const std::string d = lower(deityName);
-    if (d == "demeter")                     return Deity::Demeter;
-    if (d == "nyx")                         return Deity::Nyx;
-    if (d == "apollo")                      return Deity::Apollo;
-    if (d == "hecate")                      return Deity::Hecate;
-    if (d == "pan")                         return Deity::Pan;
-    if (d == "thanatos")                    return Deity::Thanatos;
-    if (d == "eris")                        return Deity::Eris;
-    if (d == "persephone")                  return Deity::Persephone;
-    if (d == "falsehermes" || d == "false hermes" || d == "fake hermes")
-                                            return Deity::FalseHermes;
-    return Deity::Default; // safe fallback
+    return Shrines().get(Shrines().find(deityName)).theme;   // Deity::Default if unknown
 }
 
-// --- dispatcher ------------------------------------------------------------
-Outcome RunShrine(const Shrine& shrine,
-                  InteractionContext& ctx,
-                  UI& ui,
-                  const ShrineServices& svc)
+const RiddleSet& ApolloRiddleSet() {
+    static const Riddle kRiddles[] = {
+        {"What breaks the fastest silence?", {"A shout","A thought","A whisper","Footsteps"}, 4, 3, 1},
+        {"What shines behind closed eyes?",  {"Sun","Dream","Candle","Window"},               4, 2, 1},
+        {"What answers every question?",     {"Echo","Silence","Time","Nothing"},             4, 4, 2},
+        {"What door has no hinge?",          {"Grave","Mouth","Storm","Threshold"},           4, 2, 2},
+        {"What song ends all songs?",        {"Lullaby","Requiem","Anthem","Hum"},            4, 2, 3}
+    };
+    static const RiddleSet set = [] {
+        RiddleSet s;
+        for (const Riddle& r : kRiddles) s.push(r);
+        return s;
+    }();
+    return set;
+}
+
+// Five from the session's bag if there is one (and it has riddles), else the usual five.
+static RiddleSet ApolloRiddlesFor(const ShrineServices& svc) {
+    if (svc.riddles) {
+        RiddleSet set = svc.riddles->draw(ApolloRiddleSet().size());
+        if (set.size()) return set;
+    }
+    return ApolloRiddleSet();
+}
+
+// --- built-in mechanics ------------------------------------------------------
+namespace {
+
+std::unique_ptr<ShrineCoroutine> StartQuiet(InteractionContext& ctx, const ShrineServices&) {
+    return std::make_unique<QuietAltar>(ctx);
+}
+
+std::unique_ptr<ShrineCoroutine> StartDemeter(InteractionContext& ctx, const ShrineServices&) {
+    // Melas: assemble Persephone letter from inventory fragments
+    // Lysaia: calm reading (no puzzle)
+    if (ctx.view == WorldView::Corrupted) return StartDemeterLetter_FromInventory(ctx);
+    return StartDemeterLetter_Uncorrupted(ctx, kPersephoneLetterClean);
+}
+
+std::unique_ptr<ShrineCoroutine> StartNyx(InteractionContext& ctx, const ShrineServices& svc) {
+    // If you haven't wired JournalManager hooks yet, svc.* may be empty (that’s fine)
+    return StartNyxTrade(ctx, svc.takeMelasEntry, svc.giveMelasEntry);
+}
+
+std::unique_ptr<ShrineCoroutine> StartApollo(InteractionContext& ctx, const ShrineServices& svc) {
+    return StartApolloRiddles(ctx, ApolloRiddlesFor(svc));
+}
+
+std::unique_ptr<ShrineCoroutine> StartHecate(InteractionContext& ctx, const ShrineServices& svc) {
+    return StartHecateDoors(ctx, svc.giveMelasEntry);
+}
+
+std::unique_ptr<ShrineCoroutine> StartPan(InteractionContext& ctx, const ShrineServices&) {
+    const PanRules pan = PanRulesFor(ctx.player);
+    return StartPanMemory(ctx, pan.rounds, pan.noteRange, pan.timing);
+}
+
+std::unique_ptr<ShrineCoroutine> StartFalseHermes(InteractionContext& ctx, const ShrineServices&) {
+    return StartFalseHermesEndlessHall(ctx);
+}
+std::unique_ptr<ShrineCoroutine> StartThanatos(InteractionContext& ctx, const ShrineServices&) {
+    return StartThanatosRest(ctx);
+}
+std::unique_ptr<ShrineCoroutine> StartEris(InteractionContext& ctx, const ShrineServices&) {
+    return StartErisFinal(ctx);
+}
+
+} // namespace
+
+void AddBuiltinShrines(ShrineRegistry& registry) {
+    struct Builtin { Deity deity; const char* key; ShrineStartFn start; };
+    // In Deity order: a built-in's id is its enum value.
+    static const Builtin kBuiltins[] = {
+        {Deity::Nyx,         "nyx",          StartNyx},
+        {Deity::Eris,        "eris",         StartEris},
+        {Deity::Pan,         "pan",          StartPan},
+        {Deity::Demeter,     "demeter",      StartDemeter},
+        {Deity::Persephone,  "persephone",   StartQuiet},     // script only
+        {Deity::FalseHermes, "false_hermes", StartFalseHermes},
+        {Deity::Thanatos,    "thanatos",     StartThanatos},
+        {Deity::Apollo,      "apollo",       StartApollo},
+        {Deity::Hecate,      "hecate",       StartHecate},
+        {Deity::Default,     "quiet_altar",  StartQuiet},
+    };
+    for (const Builtin& b : kBuiltins) {
+        assert(registry.size() == static_cast<std::size_t>(b.deity));
+        registry.add({b.key, deityLabel(b.deity), b.deity, b.start, nullptr});
+    }
+    registry.alias("falsehermes", "false_hermes");
+    registry.alias("fake hermes", "false_hermes");
+}
+
+// --- dispatcher -------------------------------------------------------------
+std::unique_ptr<ShrineCoroutine> StartShrine(const Shrine& shrine,
+                                             InteractionContext& ctx,
+                                             const ShrineServices& svc)
 {
-    // Preserve caller's state, but use the shrine's state during this run
-    const ShrineState prevState = ctx.shrineState;
     ctx.shrineState = shrine.getState();
-
-    const Deity deity = DeityFromName(shrine.getDeityName());
-    Outcome out;
-
-    switch (deity) {
-        case Deity::Demeter: {
-            if (ctx.view == WorldView::Corrupted) {
-                // Melas: assemble Persephone letter from inventory fragments
-                out = RunDemeterLetter_FromInventory(ctx, ui);
-            } else {
-                // Lysaia: calm reading (no puzzle). No extra 'letter' var needed.
-                out = ShowDemeterLetter_Uncorrupted(ctx, ui);
-            }
-        } break;
-
-        case Deity::Nyx: {
-            // If you haven't wired JournalManager hooks yet, svc.* may be empty (that’s fine)
-            out = RunNyxTrade(ctx, ui, svc.takeMelasEntry, svc.giveMelasEntry);
-        } break;
-
-        case Deity::Apollo: {
-            std::vector<Riddle> set = {
-                {"What breaks the fastest silence?", {"A shout","A thought","A whisper","Footsteps"}, 3},
-                {"What shines behind closed eyes?",  {"Sun","Dream","Candle","Window"},               2},
-                {"What answers every question?",     {"Echo","Silence","Time","Nothing"},             4},
-                {"What door has no hinge?",          {"Grave","Mouth","Storm","Threshold"},           2},
-                {"What song ends all songs?",        {"Lullaby","Requiem","Anthem","Hum"},            2}
-            };
-            out = RunApolloRiddles(ctx, ui, set);
-        } break;
-
-        case Deity::Hecate: {
-            out = RunHecateDoors(ctx, ui, svc.giveMelasEntry);
-        } break;
-
-        case Deity::Pan: {
-            out = RunPanMemory(ctx, ui, /*rounds=*/5, /*noteRange=*/5);
-        } break;
-
-        case Deity::FalseHermes: {
-            out = RunFalseHermesEndlessHall(ctx, ui);
-        } break;
-
-        case Deity::Thanatos: {
-            out = RunThanatosRest(ctx, ui);
-        } break;
-
-        case Deity::Eris: {
-            out = RunErisFinal(ctx, ui);
-        } break;
-
-        default: {
-            out.journalEntry = "The altar is quiet. Nothing answers you.";
-        } break;
+    if (const ShrineProgram* script = ShrineScriptFor(shrine.handler())) {
+        const bool apollo = shrine.handler() == static_cast<ShrineHandlerId>(Deity::Apollo);
+        return StartShrineScript(*script, ctx, svc, apollo ? ApolloRiddlesFor(svc) : RiddleSet{});
     }
+    return Shrines().start(shrine.handler(), ctx, svc);
+}
 
-    // restore caller’s shrine state
-    ctx.shrineState = prevState;
-    return out;
+std::unique_ptr<ShrineCoroutine> StartBuiltinShrine(const Shrine& shrine,
+                                                    InteractionContext& ctx,
+                                                    const ShrineServices& svc)
+{
+    ctx.shrineState = shrine.getState();
+    return Shrines().start(shrine.handler(), ctx, svc);
 }
+
+// --- backends ---------------------------------------------------------------
+template Outcome RunShrine<UI>(const Shrine&, InteractionContext&, UI&, const ShrineServices&);
+template Outcome RunShrine<ScriptedUI>(const Shrine&, InteractionContext&, ScriptedUI&, const ShrineServices&);
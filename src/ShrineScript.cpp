@@ -0,0 +1,686 @@
+// ShrineScript.cpp
+// .shrine compiler and loader. One pass: each line is lexed and emitted
+// straight into the program; blocks keep the jumps they still owe a target.
+#include "ShrineScript.hpp"
+#include "ShrineRegistry.hpp"
+#include "BalanceParams.hpp"
+#include <cctype>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sstream>
+
+namespace {
+
+// --- lexer -------------------------------------------------------------------
+
+enum class Tok : std::uint8_t { Ident, Number, String, Sym, End };
+
+struct Token {
+    Tok kind = Tok::End;
+    std::string text;   // identifier, symbol, or the raw (still escaped) string body
+    int value = 0;
+};
+
+bool lexLine(const std::string& line, std::vector<Token>& out, std::string& error) {
+    out.clear();
+    std::size_t i = 0;
+    while (i < line.size()) {
+        const unsigned char c = static_cast<unsigned char>(line[i]);
+        if (std::isspace(c)) { ++i; continue; }
+        if (c == '#') break;
+        Token t;
+        if (std::isalpha(c) || c == '_') {
+            std::size_t j = i;
+            while (j < line.size() && (std::isalnum(static_cast<unsigned char>(line[j])) || line[j] == '_')) ++j;
+            t.kind = Tok::Ident;
+            t.text = line.substr(i, j - i);
+            i = j;
+        } else if (std::isdigit(c)) {
+            std::size_t j = i;
+            while (j < line.size() && std::isdigit(static_cast<unsigned char>(line[j]))) ++j;
+            t.kind = Tok::Number;
+            t.text = line.substr(i, j - i);
+            t.value = std::stoi(t.text);
+            i = j;
+        } else if (c == '"') {
+            std::size_t j = i + 1;
+            while (j < line.size() && line[j] != '"') j += (line[j] == '\\' && j + 1 < line.size()) ? 2 : 1;
+            if (j >= line.size()) { error = "unterminated string"; return false; }
+            t.kind = Tok::String;
+            t.text = line.substr(i + 1, j - i - 1);
+            i = j + 1;
+        } else {
+            static const char* const two[] = {"==", "!=", "<=", ">=", "&&", "||", "+=", "-="};
+            t.kind = Tok::Sym;
+            t.text = std::string(1, static_cast<char>(c));
+            for (const char* s : two)
+                if (line.compare(i, 2, s) == 0) { t.text = s; break; }
+            if (std::string("()[],:+-*/%<>!=|&").find(t.text[0]) == std::string::npos) {
+                error = std::string("unexpected '") + static_cast<char>(c) + "'";
+                return false;
+            }
+            i += t.text.size();
+        }
+        out.push_back(std::move(t));
+    }
+    out.push_back(Token{});
+    return true;
+}
+
+// --- compiler ----------------------------------------------------------------
+
+using Op = ShrineOp;
+
+struct Builtin { const char* name; ShrineBuiltin id; int args; };
+const Builtin kBuiltins[] = {
+    {"fragments",         ShrineBuiltin::Fragments,       0},
+    {"has_all_fragments", ShrineBuiltin::HasAllFragments, 0},
+    {"fragment_index",    ShrineBuiltin::FragmentIndex,   1},
+    {"eris_score",        ShrineBuiltin::ErisScore,       0},
+    {"can_take",          ShrineBuiltin::CanTake,         0},
+    {"take_page",         ShrineBuiltin::TakePage,        0},
+    {"can_give",          ShrineBuiltin::CanGive,         0},
+    {"melas",             ShrineBuiltin::Melas,           0},
+    {"pan_flash_ms",      ShrineBuiltin::PanFlashMs,      0},
+    {"pan_rounds",        ShrineBuiltin::PanRounds,       0},
+    {"pan_notes",         ShrineBuiltin::PanNotes,        0},
+    {"pan_answer_ms",     ShrineBuiltin::PanAnswerMs,     0},
+    {"pan_note_ms",       ShrineBuiltin::PanNoteMs,       0},
+    {"elapsed_ms",        ShrineBuiltin::ElapsedMs,       0},
+    {"riddles",           ShrineBuiltin::Riddles,         0},
+    {"riddle_answer",     ShrineBuiltin::RiddleAnswer,    1},
+    {"letter_lines",      ShrineBuiltin::LetterLines,     0},
+};
+
+int statIndex(const std::string& s) {
+    if (s == "health")     return static_cast<int>(ShrineStat::Health);
+    if (s == "will")       return static_cast<int>(ShrineStat::Will);
+    if (s == "insight")    return static_cast<int>(ShrineStat::Insight);
+    if (s == "nerve")      return static_cast<int>(ShrineStat::Nerve);
+    if (s == "corruption") return static_cast<int>(ShrineStat::Corruption);
+    return -1;
+}
+
+class Compiler {
+public:
+    Compiler(ShrineProgram& prog, std::string name) : prog_(prog), name_(std::move(name)) {}
+
+    bool compile(const std::string& source, std::string& error) {
+        std::istringstream in(source);
+        std::string raw, line;
+        int lineNo = 0, startLine = 0;
+        while (std::getline(in, raw)) {
+            ++lineNo;
+            if (!raw.empty() && raw.back() == '\r') raw.pop_back();
+            if (line.empty()) startLine = lineNo;
+            if (!raw.empty() && raw.back() == '\\') { raw.pop_back(); line += raw; continue; }
+            line += raw;
+            line_ = startLine;
+            if (!lexLine(line, toks_, err_) || !statement()) break;
+            line.clear();
+        }
+        if (err_.empty() && !line.empty()) { line_ = startLine; fail("line continues past the end"); }
+        if (err_.empty() && !blocks_.empty()) { line_ = blocks_.back().line; fail("block never closed with 'end'"); }
+        if (!err_.empty()) { error = name_ + ":" + std::to_string(line_) + ": " + err_; return false; }
+        emit(Op::Stop);
+        prog_.locals = static_cast<int>(locals_.size());
+        prog_.arrays = static_cast<int>(arrays_.size());
+        return true;
+    }
+
+private:
+    enum class BlockKind : std::uint8_t { If, While, For };
+    struct Block {
+        Block(BlockKind k, int l) : kind(k), line(l) {}
+        BlockKind kind;
+        int line;
+        std::size_t top = 0;              // loop start (while) / step code (for, patched late)
+        std::size_t pendingJz = 0;        // if: jump to the next arm; loops: exit test
+        bool hasPending = false;
+        bool sawElse = false;
+        int forVar = -1;
+        std::vector<std::size_t> toEnd;   // jumps to the block's end
+        std::vector<std::size_t> toStep;  // for-loop `continue`s
+    };
+
+    ShrineProgram& prog_;
+    std::string name_;
+    std::string err_;
+    int line_ = 0;
+    std::vector<Token> toks_;
+    std::size_t at_ = 0;
+    std::map<std::string, int> locals_, arrays_;
+    std::vector<Block> blocks_;
+
+    bool fail(const std::string& what) { if (err_.empty()) err_ = what; return false; }
+
+    // --- emit ---
+    void emit(Op op) { prog_.code.push_back(static_cast<std::int32_t>(op)); }
+    void emit(Op op, int a) { emit(op); prog_.code.push_back(a); }
+    void emit(Op op, int a, int b) { emit(op, a); prog_.code.push_back(b); }
+    std::size_t here() const { return prog_.code.size(); }
+    std::size_t jump(Op op) { emit(op, -1); return here() - 1; }   // operand slot to patch
+    void patch(std::size_t slot, std::size_t target) { prog_.code[slot] = static_cast<std::int32_t>(target); }
+
+    // --- tokens ---
+    const Token& peek() const { return toks_[at_]; }
+    Token take() { return toks_[at_ < toks_.size() - 1 ? at_++ : at_]; }
+    bool isSym(const char* s) const { return peek().kind == Tok::Sym && peek().text == s; }
+    bool isWord(const char* s) const { return peek().kind == Tok::Ident && peek().text == s; }
+    bool accept(const char* s) { if (isSym(s)) { ++at_; return true; } return false; }
+    bool expect(const char* s) { return accept(s) || fail(std::string("expected '") + s + "'"); }
+    bool atEnd() const { return peek().kind == Tok::End; }
+    bool endOfLine() { return atEnd() || fail("unexpected '" + peek().text + "'"); }
+    bool ident(std::string& out) {
+        if (peek().kind != Tok::Ident) return fail("expected a name");
+        out = take().text;
+        return true;
+    }
+
+    int local(const std::string& n, bool declare) {
+        auto it = locals_.find(n);
+        if (it != locals_.end()) return it->second;
+        if (!declare) return -1;
+        const int id = static_cast<int>(locals_.size());
+        locals_[n] = id;
+        return id;
+    }
+    int array(const std::string& n) const { auto it = arrays_.find(n); return it == arrays_.end() ? -1 : it->second; }
+    bool reserved(const std::string& n) const {
+        if (statIndex(n) >= 0) return true;
+        for (const Builtin& b : kBuiltins) if (n == b.name) return true;
+        static const char* const words[] = {"roll", "check", "len", "same", "flag", "balance", "secs", "fragment", "letter"};
+        for (const char* w : words) if (n == w) return true;
+        return false;
+    }
+
+    // --- expressions (precedence climbing) ---
+    bool expr() { return orExpr(); }
+
+    bool orExpr() {
+        if (!andExpr()) return false;
+        while (accept("||")) {
+            emit(Op::Dup);
+            const std::size_t done = jump(Op::Jnz);
+            emit(Op::Pop);
+            if (!andExpr()) return false;
+            patch(done, here());
+            emit(Op::Bool);
+        }
+        return true;
+    }
+    bool andExpr() {
+        if (!cmpExpr()) return false;
+        while (accept("&&")) {
+            emit(Op::Dup);
+            const std::size_t done = jump(Op::Jz);
+            emit(Op::Pop);
+            if (!cmpExpr()) return false;
+            patch(done, here());
+            emit(Op::Bool);
+        }
+        return true;
+    }
+    bool cmpExpr() {
+        if (!addExpr()) return false;
+        static const std::pair<const char*, Op> ops[] = {
+            {"==", Op::Eq}, {"!=", Op::Ne}, {"<=", Op::Le}, {">=", Op::Ge}, {"<", Op::Lt}, {">", Op::Gt}};
+        for (;;) {
+            Op op = Op::Stop;
+            for (const auto& [s, o] : ops) if (isSym(s)) { op = o; break; }
+            if (op == Op::Stop) return true;
+            take();
+            if (!addExpr()) return false;
+            emit(op);
+        }
+    }
+    bool addExpr() {
+        if (!mulExpr()) return false;
+        for (;;) {
+            if (accept("+"))      { if (!mulExpr()) return false; emit(Op::Add); }
+            else if (accept("-")) { if (!mulExpr()) return false; emit(Op::Sub); }
+            else return true;
+        }
+    }
+    bool mulExpr() {
+        if (!unary()) return false;
+        for (;;) {
+            if (accept("*"))      { if (!unary()) return false; emit(Op::Mul); }
+            else if (accept("/")) { if (!unary()) return false; emit(Op::Div); }
+            else if (accept("%")) { if (!unary()) return false; emit(Op::Mod); }
+            else return true;
+        }
+    }
+    bool unary() {
+        if (accept("-")) { if (!unary()) return false; emit(Op::Neg); return true; }
+        if (accept("!")) { if (!unary()) return false; emit(Op::Not); return true; }
+        return primary();
+    }
+    bool args(int n) {
+        if (!expect("(")) return false;
+        for (int i = 0; i < n; ++i) {
+            if (i && !expect(",")) return false;
+            if (!expr()) return false;
+        }
+        return expect(")");
+    }
+    bool arrayArg(int& id) {
+        std::string n;
+        if (!ident(n)) return false;
+        id = array(n);
+        return id >= 0 || fail("'" + n + "' is not an array");
+    }
+    bool primary() {
+        const Token t = take();
+        if (t.kind == Tok::Number) { emit(Op::Push, t.value); return true; }
+        if (t.kind == Tok::Sym && t.text == "(") return expr() && expect(")");
+        if (t.kind != Tok::Ident) return fail("expected a value, got '" + t.text + "'");
+
+        const std::string& n = t.text;
+        if (const int s = statIndex(n); s >= 0) { emit(Op::Stat, s); return true; }
+        if (n == "roll")  { if (!args(2)) return false; emit(Op::Roll);  return true; }
+        if (n == "check") { if (!args(4)) return false; emit(Op::Check); return true; }
+        if (n == "len") {
+            int a;
+            if (!expect("(") || !arrayArg(a) || !expect(")")) return false;
+            emit(Op::ALen, a);
+            return true;
+        }
+        if (n == "same") {
+            int a, b;
+            if (!expect("(") || !arrayArg(a) || !expect(",") || !arrayArg(b) || !expect(")")) return false;
+            emit(Op::ASame, a, b);
+            return true;
+        }
+        if (n == "flag") {
+            std::string f;
+            if (!expect("(") || !ident(f) || !expect(")")) return false;
+            emit(Op::Flag, static_cast<int>(FlagStore::intern(f)));
+            return true;
+        }
+        if (n == "balance") {
+            std::string k;
+            if (!expect("(") || !ident(k) || !expect(")")) return false;
+            const int i = BalanceParamIndex(k);
+            if (i < 0) return fail("no balance number '" + k + "'");
+            emit(Op::Param, i);
+            return true;
+        }
+        for (const Builtin& b : kBuiltins) {
+            if (n != b.name) continue;
+            if (!args(b.args)) return false;
+            emit(Op::Call, static_cast<int>(b.id));
+            return true;
+        }
+        if (const int a = array(n); a >= 0) {
+            if (!expect("[") || !expr() || !expect("]")) return false;
+            emit(Op::ALoad, a);
+            return true;
+        }
+        const int v = local(n, false);
+        if (v < 0) return fail("unknown name '" + n + "'");
+        emit(Op::Load, v);
+        return true;
+    }
+
+    // --- text ---
+    // "..." "..." -> a ShrineText; {...} pieces compile to code that pushes
+    // their values, in order, ahead of the op that prints.
+    bool text(int& id) {
+        if (peek().kind != Tok::String) return fail("expected text in quotes");
+        std::string raw;
+        while (peek().kind == Tok::String) raw += take().text;
+
+        ShrineText out;
+        std::string lit;
+        auto flush = [&]() {
+            if (lit.empty()) return;
+            out.pieces.push_back({ShrineText::Part::Literal, lit, -1});
+            lit.clear();
+        };
+        for (std::size_t i = 0; i < raw.size(); ++i) {
+            const char c = raw[i];
+            if (c == '\\' && i + 1 < raw.size()) {
+                const char e = raw[++i];
+                lit += e == 'n' ? '\n' : e;
+                continue;
+            }
+            if (c != '{') { lit += c; continue; }
+            const std::size_t close = raw.find('}', i);
+            if (close == std::string::npos) return fail("'{' without '}'");
+            flush();
+            if (!piece(raw.substr(i + 1, close - i - 1), out)) return false;
+            i = close;
+        }
+        flush();
+        id = static_cast<int>(prog_.texts.size());
+        prog_.texts.push_back(std::move(out));
+        return true;
+    }
+
+    bool piece(const std::string& src, ShrineText& out) {
+        std::vector<Token> saved;
+        saved.swap(toks_);
+        const std::size_t savedAt = at_;
+        at_ = 0;
+        bool ok = lexLine(src, toks_, err_);
+        if (ok) {
+            ShrineText::Part part = ShrineText::Part::Int;
+            int arr = -1;
+            if (peek().kind == Tok::Ident && toks_[1].kind == Tok::End && array(peek().text) >= 0) {
+                part = ShrineText::Part::Array;
+                arr = array(take().text);
+            } else {
+                if (isWord("secs"))     part = ShrineText::Part::Seconds;
+                if (isWord("fragment")) part = ShrineText::Part::Fragment;
+                if (isWord("letter"))   part = ShrineText::Part::Letter;
+                if (part != ShrineText::Part::Int) { take(); ok = args(1); }
+                else ok = expr();
+                if (ok) ++out.values;
+            }
+            ok = ok && endOfLine();
+            if (ok) out.pieces.push_back({part, {}, arr});
+        }
+        toks_.swap(saved);
+        at_ = savedAt;
+        return ok;
+    }
+
+    // --- statements ---
+    bool statement() {
+        at_ = 0;
+        if (atEnd()) return true;
+        if (peek().kind != Tok::Ident) return fail("a line starts with a statement");
+        const std::string kw = take().text;
+
+        if (kw == "let")  { std::string n; return ident(n) && assign(n, true); }
+        if (kw == "if")   return ifStart();
+        if (kw == "elif") return elif();
+        if (kw == "else") return elseArm();
+        if (kw == "while") return whileStart();
+        if (kw == "for")  return forStart();
+        if (kw == "end")  return blockEnd();
+        if (kw == "break" || kw == "continue") return loopJump(kw == "break");
+        if (kw == "stop") { emit(Op::Stop); return endOfLine(); }
+        if (kw == "arr") {
+            std::string n;
+            if (!ident(n)) return false;
+            if (reserved(n) || local(n, false) >= 0 || array(n) >= 0) return fail("'" + n + "' is already taken");
+            const int id = static_cast<int>(arrays_.size());
+            arrays_[n] = id;
+            return endOfLine();
+        }
+        if (kw == "push")  { int a; if (!arrayArg(a) || !expr()) return false; emit(Op::APush, a); return endOfLine(); }
+        if (kw == "clear") { int a; if (!arrayArg(a)) return false; emit(Op::AClear, a); return endOfLine(); }
+        if (kw == "say" || kw == "journal") {
+            int t;
+            if (!text(t)) return false;
+            emit(kw == "say" ? Op::Say : Op::Journal, t);
+            return endOfLine();
+        }
+        if (kw == "blank") { if (!expr()) return false; emit(Op::Blank); return endOfLine(); }
+        if (kw == "outcome" || kw == "player") return statChange(kw == "player" ? Op::Player : Op::Outcome);
+        if (kw == "flag") {
+            std::string f;
+            if (!ident(f) || !expect("=") || !expr()) return false;
+            emit(Op::SetFlag, static_cast<int>(FlagStore::intern(f)));
+            return endOfLine();
+        }
+        if (kw == "odds") {
+            int t;
+            if (!text(t)) return false;
+            for (int i = 0; i < 4; ++i) if (!expect(",") || !expr()) return false;
+            emit(Op::Odds, t);
+            return endOfLine();
+        }
+        if (kw == "choose") {
+            std::string n;
+            int t;
+            if (!ident(n) || !text(t)) return false;
+            int menu = -1;
+            if (accept(":")) {
+                std::vector<std::string> opts;
+                do {
+                    int o;
+                    if (!text(o)) return false;
+                    if (prog_.texts[o].values) return fail("menu options are plain text");
+                    opts.push_back(plain(prog_.texts[o]));
+                    prog_.texts.pop_back();
+                } while (accept(","));
+                menu = static_cast<int>(prog_.menus.size());
+                prog_.menus.push_back(std::move(opts));
+            }
+            emit(Op::Choose, t, menu);
+            return store(n);
+        }
+        if (kw == "riddle") {
+            std::string n;
+            if (!ident(n) || !expr()) return false;
+            emit(Op::Riddle);
+            return store(n);
+        }
+        if (kw == "ask") {
+            int a, t;
+            if (!arrayArg(a) || !text(t)) return false;
+            emit(Op::Ask, a, t);
+            return endOfLine();
+        }
+        if (kw == "flash") {
+            int t;
+            if (!text(t) || !expect(",") || !expr()) return false;
+            emit(Op::Flash, t);
+            return endOfLine();
+        }
+        if (kw == "wait") { emit(Op::Wait); return endOfLine(); }
+        if (kw == "give") {
+            std::vector<std::string> pool;
+            do {
+                int o;
+                if (!text(o)) return false;
+                if (prog_.texts[o].values) return fail("give takes plain text");
+                pool.push_back(plain(prog_.texts[o]));
+                prog_.texts.pop_back();
+            } while (accept("|"));
+            emit(Op::Give, static_cast<int>(prog_.pools.size()));
+            prog_.pools.push_back(std::move(pool));
+            return endOfLine();
+        }
+
+        // x = ..., x += ..., xs[i] = ...
+        if (const int a = array(kw); a >= 0) {
+            if (!expect("[") || !expr() || !expect("]") || !expect("=") || !expr()) return false;
+            emit(Op::AStore, a);
+            return endOfLine();
+        }
+        return assign(kw, false);
+    }
+
+    static std::string plain(const ShrineText& t) {
+        std::string s;
+        for (const auto& p : t.pieces) s += p.literal;
+        return s;
+    }
+
+    bool store(const std::string& n) {
+        if (reserved(n) || array(n) >= 0) return fail("can't assign to '" + n + "'");
+        emit(Op::Store, local(n, true));
+        return endOfLine();
+    }
+
+    bool assign(const std::string& n, bool declare) {
+        if (reserved(n) || array(n) >= 0) return fail("can't assign to '" + n + "'");
+        const int existing = local(n, false);
+        if (accept("=")) {
+            if (!expr()) return false;
+            emit(Op::Store, local(n, true));
+            return endOfLine();
+        }
+        if (declare) return fail("expected '='");
+        const bool add = isSym("+=");
+        if (!add && !isSym("-=")) return fail(existing < 0 ? "unknown statement '" + n + "'" : "expected '=', '+=' or '-='");
+        take();
+        if (existing < 0) return fail("unknown name '" + n + "'");
+        emit(Op::Load, existing);
+        if (!expr()) return false;
+        emit(add ? Op::Add : Op::Sub);
+        emit(Op::Store, existing);
+        return endOfLine();
+    }
+
+    bool statChange(Op op) {
+        std::string s;
+        if (!ident(s)) return false;
+        const int stat = statIndex(s);
+        if (stat < 0) return fail("'" + s + "' is not a stat");
+        const bool add = isSym("+=");
+        if (!add && !isSym("-=")) return fail("expected '+=' or '-='");
+        take();
+        if (!expr()) return false;
+        if (!add) emit(Op::Neg);
+        emit(op, stat);
+        return endOfLine();
+    }
+
+    // --- blocks ---
+    bool ifStart() {
+        if (!expr()) return false;
+        Block b(BlockKind::If, line_);
+        b.pendingJz = jump(Op::Jz);
+        b.hasPending = true;
+        blocks_.push_back(std::move(b));
+        return endOfLine();
+    }
+    bool elif() {
+        if (blocks_.empty() || blocks_.back().kind != BlockKind::If || blocks_.back().sawElse)
+            return fail("'elif' outside an if");
+        Block& b = blocks_.back();
+        b.toEnd.push_back(jump(Op::Jmp));
+        patch(b.pendingJz, here());
+        if (!expr()) return false;
+        b.pendingJz = jump(Op::Jz);
+        return endOfLine();
+    }
+    bool elseArm() {
+        if (blocks_.empty() || blocks_.back().kind != BlockKind::If || blocks_.back().sawElse)
+            return fail("'else' outside an if");
+        Block& b = blocks_.back();
+        b.toEnd.push_back(jump(Op::Jmp));
+        patch(b.pendingJz, here());
+        b.hasPending = false;
+        b.sawElse = true;
+        return endOfLine();
+    }
+    bool whileStart() {
+        Block b(BlockKind::While, line_);
+        b.top = here();
+        if (!expr()) return false;
+        b.pendingJz = jump(Op::Jz);
+        b.hasPending = true;
+        blocks_.push_back(std::move(b));
+        return endOfLine();
+    }
+    bool forStart() {
+        std::string n;
+        if (!ident(n) || reserved(n) || array(n) >= 0) return fail("expected a loop variable");
+        const int v = local(n, true);
+        if (!expect("=") || !expr()) return false;
+        emit(Op::Store, v);
+        if (!isWord("to")) return fail("expected 'to'");
+        take();
+        Block b(BlockKind::For, line_);
+        b.forVar = v;
+        b.top = here();
+        emit(Op::Load, v);
+        if (!expr()) return false;
+        emit(Op::Le);
+        b.pendingJz = jump(Op::Jz);
+        b.hasPending = true;
+        blocks_.push_back(std::move(b));
+        return endOfLine();
+    }
+    bool loopJump(bool isBreak) {
+        for (auto it = blocks_.rbegin(); it != blocks_.rend(); ++it) {
+            if (it->kind == BlockKind::If) continue;
+            if (isBreak) it->toEnd.push_back(jump(Op::Jmp));
+            else if (it->kind == BlockKind::For) it->toStep.push_back(jump(Op::Jmp));
+            else emit(Op::Jmp, static_cast<int>(it->top));
+            return endOfLine();
+        }
+        return fail(std::string(isBreak ? "'break'" : "'continue'") + " outside a loop");
+    }
+    bool blockEnd() {
+        if (blocks_.empty()) return fail("'end' without a block");
+        Block b = std::move(blocks_.back());
+        blocks_.pop_back();
+        if (b.kind == BlockKind::For) {
+            for (std::size_t s : b.toStep) patch(s, here());
+            emit(Op::Load, b.forVar);
+            emit(Op::Push, 1);
+            emit(Op::Add);
+            emit(Op::Store, b.forVar);
+        }
+        if (b.kind != BlockKind::If) emit(Op::Jmp, static_cast<int>(b.top));
+        if (b.hasPending) patch(b.pendingJz, here());
+        for (std::size_t s : b.toEnd) patch(s, here());
+        return endOfLine();
+    }
+};
+
+// --- loader ------------------------------------------------------------------
+
+struct ScriptCache {
+    std::string dir = "assets/shrines";
+    bool loaded = false;
+    std::vector<ShrineProgram> programs;   // by handler id; empty code = no script
+};
+
+ScriptCache& cache() { static ScriptCache c; return c; }
+
+const Deity kScripted[] = { Deity::Demeter, Deity::Nyx, Deity::Apollo, Deity::Hecate, Deity::Pan,
+                            Deity::FalseHermes, Deity::Thanatos, Deity::Eris, Deity::Persephone };
+
+} // namespace
+
+bool CompileShrineScript(const std::string& source, const std::string& name,
+                         ShrineProgram& out, std::string& error) {
+    out = ShrineProgram{};
+    out.name = name;
+    return Compiler(out, name).compile(source, error);
+}
+
+std::string ShrineScriptName(Deity deity) {
+    if (deity == Deity::Default) return {};
+    return Shrines().get(static_cast<ShrineHandlerId>(deity)).key;   // built-in ids are the enum
+}
+
+void SetShrineScriptDir(const std::string& dir) {
+    ScriptCache& c = cache();
+    c.dir = dir;
+    c.loaded = false;
+    c.programs.clear();
+}
+
+const ShrineProgram* ShrineScriptFor(ShrineHandlerId id) {
+    ScriptCache& c = cache();
+    if (!c.loaded) {
+        c.loaded = true;
+        c.programs.assign(Shrines().size(), ShrineProgram{});
+        if (!c.dir.empty()) {
+            for (Deity d : kScripted) {
+                const std::string name = ShrineScriptName(d);
+                std::ifstream in(c.dir + "/" + name + ".shrine");
+                if (!in) continue;
+                std::stringstream src;
+                src << in.rdbuf();
+                ShrineProgram prog;
+                std::string error;
+                if (CompileShrineScript(src.str(), name + ".shrine", prog, error))
+                    c.programs[static_cast<std::size_t>(d)] = std::move(prog);   // built-in id == Deity
+                else
+                    std::cerr << "shrine script " << error << " (using the built-in shrine)\n";
+            }
+        }
+    }
+    return id < c.programs.size() && !c.programs[id].code.empty() ? &c.programs[id] : nullptr;
+}
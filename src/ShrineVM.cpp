@@ -0,0 +1,304 @@
+// ShrineVM.cpp
+// Runs a compiled ShrineProgram as a ShrineCoroutine. The whole machine state
+// (ip, int stack, locals, arrays) lives in members, so parking at a prompt is
+// just returning; resume() lands back on the op that asked.
+#include "ShrineScript.hpp"
+#include "EndingRules.hpp"          // ErisScoreRules
+#include "PersephoneFragments.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <sstream>
+
+namespace {
+
+using Op = ShrineOp;
+
+class ShrineVM final : public ShrineCoroutine {
+public:
+    ShrineVM(const ShrineProgram& prog, InteractionContext& ctx, const ShrineServices& svc,
+             const RiddleSet& riddles)
+        : ShrineCoroutine(ctx), prog_(prog), take_(svc.takeMelasEntry), give_(svc.giveMelasEntry),
+          riddles_(riddles), locals_(static_cast<std::size_t>(prog.locals), 0),
+          arrays_(static_cast<std::size_t>(prog.arrays)) {
+        stack_.reserve(16);
+    }
+
+private:
+    const ShrineProgram& prog_;
+    TakeMelasEntryFn take_;
+    GiveMelasEntryFn give_;
+    RiddleSet riddles_;
+
+    std::size_t ip_ = 0;
+    bool parked_ = false;   // the op at ip_ asked something; its answer is in reply_
+    std::vector<int> stack_;
+    std::vector<int> locals_;
+    std::vector<std::vector<int>> arrays_;
+    long long elapsedMs_ = 0;
+    std::vector<std::pair<int, std::string>> owned_;   // fragments, fetched on first use
+    bool ownedLoaded_ = false;
+
+    int pop() { const int v = stack_.back(); stack_.pop_back(); return v; }
+    void push(int v) { stack_.push_back(v); }
+    int operand(std::size_t k) const { return prog_.code[ip_ + k]; }
+
+    int& stat(int s) {
+        switch (static_cast<ShrineStat>(s)) {
+            case ShrineStat::Health:  return ctx_.player.stats.health;
+            case ShrineStat::Will:    return ctx_.player.stats.will;
+            case ShrineStat::Insight: return ctx_.player.stats.insight;
+            case ShrineStat::Nerve:   return ctx_.player.stats.nerve;
+            default:                  return ctx_.player.corruption;
+        }
+    }
+    int& outcomeField(int s) {
+        switch (static_cast<ShrineStat>(s)) {
+            case ShrineStat::Health:  return out_.healthDelta;
+            case ShrineStat::Will:    return out_.willDelta;
+            case ShrineStat::Insight: return out_.insightDelta;
+            case ShrineStat::Nerve:   return out_.nerveDelta;
+            default:                  return out_.corruptionDelta;
+        }
+    }
+
+    const std::vector<std::pair<int, std::string>>& owned() {
+        if (!ownedLoaded_) { owned_ = GetOwnedPersephoneFragments(ctx_.player); ownedLoaded_ = true; }
+        return owned_;
+    }
+
+    // 1-based, out of range reads 0 / writes nothing
+    static int at(const std::vector<int>& a, int i) { return i >= 1 && i <= (int)a.size() ? a[i - 1] : 0; }
+
+    CheckMods mods(int flat, int mode) const {
+        CheckMods m;
+        m.flat = flat;
+        m.advantage = mode == 1;
+        m.disadvantage = mode == 2;
+        return m;
+    }
+
+    // Pops the text's values (pushed in order) and renders it.
+    std::string render(int id) {
+        const ShrineText& t = prog_.texts[static_cast<std::size_t>(id)];
+        const std::size_t base = stack_.size() - static_cast<std::size_t>(t.values);
+        std::size_t v = base;
+        std::string s;
+        for (const ShrineText::Piece& p : t.pieces) {
+            switch (p.part) {
+                case ShrineText::Part::Literal: s += p.literal; break;
+                case ShrineText::Part::Int:     s += std::to_string(stack_[v++]); break;
+                case ShrineText::Part::Array: {
+                    const std::vector<int>& a = arrays_[static_cast<std::size_t>(p.array)];
+                    for (std::size_t i = 0; i < a.size(); ++i) s += (i ? " " : "") + std::to_string(a[i]);
+                    break;
+                }
+                case ShrineText::Part::Seconds: {
+                    char buf[32];
+                    std::snprintf(buf, sizeof buf, "%.2f", stack_[v++] / 1000.0);
+                    s += buf;
+                    break;
+                }
+                case ShrineText::Part::Fragment: {
+                    const int i = stack_[v++];
+                    if (i >= 1 && i <= (int)owned().size()) s += owned()[static_cast<std::size_t>(i - 1)].second;
+                    break;
+                }
+                case ShrineText::Part::Letter: {
+                    const int i = stack_[v++];
+                    if (i >= 1 && i <= (int)kPersephoneLetterClean.size()) s += kPersephoneLetterClean[static_cast<std::size_t>(i - 1)];
+                    break;
+                }
+            }
+        }
+        stack_.resize(base);
+        return s;
+    }
+
+    int call(ShrineBuiltin b) {
+        switch (b) {
+            case ShrineBuiltin::Fragments:       return CountPersephoneFragments(ctx_.player);
+            case ShrineBuiltin::HasAllFragments: return HasAllPersephoneFragments(ctx_.player);
+            case ShrineBuiltin::FragmentIndex: {
+                const int i = pop();
+                return i >= 1 && i <= (int)owned().size() ? owned()[static_cast<std::size_t>(i - 1)].first : 0;
+            }
+            case ShrineBuiltin::ErisScore:   return ErisScoreRules().score(ctx_.flags, ctx_.player);
+            case ShrineBuiltin::CanTake:     return static_cast<bool>(take_);
+            case ShrineBuiltin::TakePage:    return take_ && take_().has_value();
+            case ShrineBuiltin::CanGive:     return static_cast<bool>(give_);
+            case ShrineBuiltin::Melas:       return ctx_.view == WorldView::Corrupted;
+            case ShrineBuiltin::PanFlashMs:  return PanRulesFor(ctx_.player).timing.showMs;
+            case ShrineBuiltin::PanRounds:   return PanRulesFor(ctx_.player).rounds;
+            case ShrineBuiltin::PanNotes:    return PanRulesFor(ctx_.player).noteRange;
+            case ShrineBuiltin::PanAnswerMs: return PanRulesFor(ctx_.player).timing.answerMs;
+            case ShrineBuiltin::PanNoteMs:   return PanRulesFor(ctx_.player).timing.perNoteMs;
+            case ShrineBuiltin::ElapsedMs:   return static_cast<int>(std::min<long long>(elapsedMs_, 1 << 30));
+            case ShrineBuiltin::Riddles:     return riddles_.size();
+            case ShrineBuiltin::RiddleAnswer: {
+                const int i = pop();
+                return i >= 1 && i <= riddles_.size() ? riddles_[i - 1].correctIndex1Based : 0;
+            }
+            case ShrineBuiltin::LetterLines: return static_cast<int>(kPersephoneLetterClean.size());
+        }
+        return 0;
+    }
+
+    // The answer to whatever op parked us, then step past it.
+    void land() {
+        switch (static_cast<Op>(prog_.code[ip_])) {
+            case Op::Choose: push(reply_.choice); ip_ += 3; break;
+            case Op::Riddle: push(reply_.choice); ip_ += 1; break;
+            case Op::Ask: {
+                std::vector<int>& a = arrays_[static_cast<std::size_t>(operand(1))];
+                a.clear();
+                std::istringstream iss(reply_.text);
+                int x;
+                while (iss >> x) a.push_back(x);
+                elapsedMs_ = std::chrono::duration_cast<std::chrono::milliseconds>(reply_.elapsed).count();
+                ip_ += 3;
+                break;
+            }
+            case Op::Flash: ip_ += 2; break;
+            default:        ip_ += 1; break;   // Wait
+        }
+    }
+
+    bool run() override {
+        if (parked_) { parked_ = false; land(); }
+        const std::int32_t* code = prog_.code.data();
+
+        for (;;) {
+            const Op op = static_cast<Op>(code[ip_]);
+            switch (op) {
+                case Op::Push:  push(code[ip_ + 1]); ip_ += 2; break;
+                case Op::Load:  push(locals_[static_cast<std::size_t>(code[ip_ + 1])]); ip_ += 2; break;
+                case Op::Store: locals_[static_cast<std::size_t>(code[ip_ + 1])] = pop(); ip_ += 2; break;
+
+                case Op::ALoad: {
+                    const int i = pop();
+                    push(at(arrays_[static_cast<std::size_t>(code[ip_ + 1])], i));
+                    ip_ += 2;
+                    break;
+                }
+                case Op::AStore: {
+                    const int v = pop(), i = pop();
+                    std::vector<int>& a = arrays_[static_cast<std::size_t>(code[ip_ + 1])];
+                    if (i >= 1 && i <= (int)a.size()) a[static_cast<std::size_t>(i - 1)] = v;
+                    ip_ += 2;
+                    break;
+                }
+                case Op::APush:  arrays_[static_cast<std::size_t>(code[ip_ + 1])].push_back(pop()); ip_ += 2; break;
+                case Op::AClear: arrays_[static_cast<std::size_t>(code[ip_ + 1])].clear(); ip_ += 2; break;
+                case Op::ALen:   push(static_cast<int>(arrays_[static_cast<std::size_t>(code[ip_ + 1])].size())); ip_ += 2; break;
+                case Op::ASame:
+                    push(arrays_[static_cast<std::size_t>(code[ip_ + 1])] == arrays_[static_cast<std::size_t>(code[ip_ + 2])]);
+                    ip_ += 3;
+                    break;
+
+                case Op::Add: { const int b = pop(); stack_.back() += b; ++ip_; break; }
+                case Op::Sub: { const int b = pop(); stack_.back() -= b; ++ip_; break; }
+                case Op::Mul: { const int b = pop(); stack_.back() *= b; ++ip_; break; }
+                case Op::Div: { const int b = pop(); stack_.back() = b ? stack_.back() / b : 0; ++ip_; break; }
+                case Op::Mod: { const int b = pop(); stack_.back() = b ? stack_.back() % b : 0; ++ip_; break; }
+                case Op::Neg:  stack_.back() = -stack_.back(); ++ip_; break;
+                case Op::Not:  stack_.back() = !stack_.back(); ++ip_; break;
+                case Op::Bool: stack_.back() = stack_.back() != 0; ++ip_; break;
+                case Op::Eq: { const int b = pop(); stack_.back() = stack_.back() == b; ++ip_; break; }
+                case Op::Ne: { const int b = pop(); stack_.back() = stack_.back() != b; ++ip_; break; }
+                case Op::Lt: { const int b = pop(); stack_.back() = stack_.back() <  b; ++ip_; break; }
+                case Op::Le: { const int b = pop(); stack_.back() = stack_.back() <= b; ++ip_; break; }
+                case Op::Gt: { const int b = pop(); stack_.back() = stack_.back() >  b; ++ip_; break; }
+                case Op::Ge: { const int b = pop(); stack_.back() = stack_.back() >= b; ++ip_; break; }
+                case Op::Dup: push(stack_.back()); ++ip_; break;
+                case Op::Pop: stack_.pop_back(); ++ip_; break;
+
+                case Op::Jmp: ip_ = static_cast<std::size_t>(code[ip_ + 1]); break;
+                case Op::Jz:  ip_ = pop() ? ip_ + 2 : static_cast<std::size_t>(code[ip_ + 1]); break;
+                case Op::Jnz: ip_ = pop() ? static_cast<std::size_t>(code[ip_ + 1]) : ip_ + 2; break;
+
+                case Op::Stat: push(stat(code[ip_ + 1])); ip_ += 2; break;
+                case Op::Player: {
+                    const int s = code[ip_ + 1];
+                    const int hi = static_cast<ShrineStat>(s) == ShrineStat::Corruption ? 100 : 10;
+                    stat(s) = std::clamp(stat(s) + pop(), 0, hi);
+                    ip_ += 2;
+                    break;
+                }
+                case Op::Outcome: outcomeField(code[ip_ + 1]) += pop(); ip_ += 2; break;
+                case Op::Flag:    push(ctx_.flags.get(static_cast<FlagId>(code[ip_ + 1]))); ip_ += 2; break;
+                case Op::SetFlag: ctx_.flags.set(static_cast<FlagId>(code[ip_ + 1]), pop() != 0); ip_ += 2; break;
+                case Op::Param:   push(balance().*BalanceParamDefs()[code[ip_ + 1]].field); ip_ += 2; break;
+
+                case Op::Roll: { const int hi = pop(), lo = pop(); push(ctx_.rng.roll(lo, hi)); ++ip_; break; }
+                case Op::Check: {
+                    const int mode = pop(), flat = pop(), statScore = pop(), dc = pop();
+                    push(SkillCheck::resolve(ctx_.rng, dc, statScore, mods(flat, mode)));
+                    ++ip_;
+                    break;
+                }
+                case Op::Odds: {
+                    const int mode = pop(), flat = pop(), statScore = pop(), dc = pop();
+                    if (!quiet()) showOdds(render(code[ip_ + 1]), dc, statScore, mods(flat, mode));
+                    ip_ += 2;
+                    break;
+                }
+                case Op::Call: { const int v = call(static_cast<ShrineBuiltin>(code[ip_ + 1])); push(v); ip_ += 2; break; }
+
+                case Op::Say:     if (!quiet()) print(render(code[ip_ + 1])); ip_ += 2; break;
+                case Op::Journal: out_.journalEntry = render(code[ip_ + 1]); ip_ += 2; break;
+                case Op::Blank:   blank(pop()); ++ip_; break;
+                case Op::Give: {
+                    const std::vector<std::string>& pool = prog_.pools[static_cast<std::size_t>(code[ip_ + 1])];
+                    const std::string& line = pool[static_cast<std::size_t>(ctx_.rng.roll(0, (int)pool.size() - 1))];
+                    if (give_) give_(line);
+                    ip_ += 2;
+                    break;
+                }
+
+                // --- the ones that wait for the player ---
+                case Op::Choose: {
+                    const int menu = code[ip_ + 2];
+                    const std::string text = quiet() ? std::string() : render(code[ip_ + 1]);
+                    if (menu < 0) choose(text);
+                    else choose(text, prog_.menus[static_cast<std::size_t>(menu)]);
+                    parked_ = true;
+                    return false;
+                }
+                case Op::Riddle: {
+                    const int i = pop();
+                    if (i < 1 || i > riddles_.size()) { push(0); ++ip_; break; }
+                    const Riddle& r = riddles_[i - 1];
+                    choose(r.prompt, r.options.begin(), r.options.begin() + r.optionCount);
+                    parked_ = true;
+                    return false;
+                }
+                case Op::Ask:
+                    ask(quiet() ? std::string() : render(code[ip_ + 2]));
+                    parked_ = true;
+                    return false;
+                case Op::Flash: {
+                    const int ms = pop();
+                    flash(quiet() ? std::string() : render(code[ip_ + 1]), ms);
+                    parked_ = true;
+                    return false;
+                }
+                case Op::Wait:
+                    waitForKey();
+                    parked_ = true;
+                    return false;
+
+                case Op::Stop:
+                    return true;
+            }
+        }
+    }
+};
+
+} // namespace
+
+std::unique_ptr<ShrineCoroutine> StartShrineScript(const ShrineProgram& program, InteractionContext& ctx,
+                                                   const ShrineServices& svc,
+                                                   const RiddleSet& riddles) {
+    return std::make_unique<ShrineVM>(program, ctx, svc, riddles);
+}
@@ -0,0 +1,125 @@
+// TempleGenerator.cpp
+#include "TempleGenerator.hpp"
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <string>
+
+namespace {
+
+struct WingSpec {
+    Deity deity;
+    const char* deityName;   // as Shrine/DeityFromName expects it
+    Dir spoke;               // hub -> wing entry
+};
+
+// Same spokes as Game::setupConnections.
+const WingSpec kWings[] = {
+    {Deity::Demeter,     "Demeter",      Dir::North},
+    {Deity::Nyx,         "Nyx",          Dir::NorthEast},
+    {Deity::Apollo,      "Apollo",       Dir::East},
+    {Deity::Hecate,      "Hecate",       Dir::SouthEast},
+    {Deity::Persephone,  "Persephone",   Dir::South},
+    {Deity::Pan,         "Pan",          Dir::SouthWest},
+    {Deity::FalseHermes, "False Hermes", Dir::West},
+    {Deity::Thanatos,    "Thanatos",     Dir::NorthWest},
+    {Deity::Eris,        "Eris",         Dir::Up},
+};
+constexpr int kWingCount = static_cast<int>(sizeof(kWings) / sizeof(kWings[0]));
+
+// One direction per axis; the opposite is the way back.
+const Dir kAxes[] = { Dir::East, Dir::North, Dir::NorthEast, Dir::SouthEast, Dir::Up };
+
+bool sameAxis(Dir a, Dir b) { return a == b || oppositeDir(a) == b; }
+
+const char* const kOpenings[] = {
+    "Cracked tiles run under a low arch.",
+    "The ceiling is lost in soot.",
+    "A cold draft moves the dust in slow circles.",
+    "Wax has pooled and hardened along the walls.",
+    "The floor slopes, very slightly, toward the hub.",
+    "Niches line the walls, each one empty.",
+};
+const char* const kDetails[] = {
+    "Something was written here and scraped away.",
+    "You hear footsteps that stop when yours do.",
+    "An offering bowl sits overturned.",
+    "The air tastes of iron and old incense.",
+    "A single candle burns without shrinking.",
+    "The mosaics have been turned to face the wall.",
+};
+
+void link(TempleMap& map, int a, Dir d, int b) {
+    map.addEdge(a, d, b);
+    map.addEdge(b, oppositeDir(d), a);
+}
+
+} // namespace
+
+void GenerateTemple(const TempleGenOptions& opts, GeneratedTemple& out) {
+    out.rooms.clear();
+    out.map.clear();
+    out.shrines.clear();
+
+    const int total = opts.roomCount < 1 ? 1 : opts.roomCount;
+    std::mt19937 rng(opts.seed);
+    std::uniform_int_distribution<int> pct(0, 99);
+    auto pick = [&](const char* const* list, int n) { return list[std::uniform_int_distribution<int>(0, n - 1)(rng)]; };
+
+    out.rooms.reserve(static_cast<size_t>(total));
+
+    auto addRoom = [&](const std::string& name, const std::string& desc, bool shrine, int shrineId, Deity d) {
+        out.rooms.emplace_back(name, desc, shrine, shrineId);
+        return out.map.addNode(name, shrine, d);
+    };
+
+    out.hub = addRoom("Main Hall of the Temple",
+                      "Pillars rise into shadow. Corridors leave in every direction, more than you can count.",
+                      false, -1, Deity::Default);
+
+    // Spread the remaining rooms over the wings; earlier wings take the remainder.
+    const int rest = total - 1;
+    for (int w = 0; w < kWingCount && w < rest; ++w) {
+        const WingSpec& spec = kWings[w];
+        const int count = rest / kWingCount + (w < rest % kWingCount ? 1 : 0);
+        if (count <= 0) continue;
+
+        // Grid axes: anything but the spoke's axis, so the entry's way back to
+        // the hub never collides with a grid exit.
+        Dir axes[3]; int na = 0;
+        for (Dir a : kAxes) if (na < 3 && !sameAxis(a, spec.spoke)) axes[na++] = a;
+        const Dir across = axes[0], along = axes[1], diagonal = axes[2];
+
+        const int width = std::max(1, static_cast<int>(std::ceil(std::sqrt(static_cast<double>(count)))));
+
+        Shrine shrine(spec.deityName, std::string("Shrine of ") + spec.deityName);
+        shrine.setState(ShrineState::CORRUPTED);
+        out.shrines[w] = shrine;
+
+        const int first = out.map.size();
+        for (int i = 0; i < count; ++i) {
+            const int row = i / width, col = i % width;
+            const bool farEnd = (i == count - 1);
+            const bool minor  = !farEnd && opts.shrineEvery > 0 && i > 0 && i % opts.shrineEvery == 0;
+
+            std::string name;
+            if (farEnd)     name = std::string("Shrine of ") + spec.deityName;
+            else if (minor) name = std::string(spec.deityName) + " Wayshrine " + std::to_string(row) + ":" + std::to_string(col);
+            else            name = std::string(spec.deityName) + " Wing " + std::to_string(row) + ":" + std::to_string(col);
+
+            std::string desc = pick(kOpenings, 6);
+            desc += ' ';
+            desc += pick(kDetails, 6);
+
+            const int id = addRoom(name, desc, farEnd || minor, (farEnd || minor) ? w : -1, spec.deity);
+
+            if (col > 0) link(out.map, id - 1, across, id);
+            if (row > 0) {
+                link(out.map, id - width, along, id);
+                if (col > 0 && pct(rng) < opts.loopPercent) link(out.map, id - width - 1, diagonal, id);
+            }
+        }
+
+        link(out.map, out.hub, spec.spoke, first);
+    }
+}
@@ -115,6 +115,23 @@ static const Theme& hecateTheme() {
     return t;
 }
 
+// ---- Names ------------------------------------------------------------------
+
+const char* deityLabel(Deity d) {
+    switch (d) {
+        case Deity::Nyx:         return "Nyx";
+        case Deity::Eris:        return "Eris";
+        case Deity::Pan:         return "Pan";
+        case Deity::Demeter:     return "Demeter";
+        case Deity::Persephone:  return "Persephone";
+        case Deity::FalseHermes: return "False Hermes";
+        case Deity::Thanatos:    return "Thanatos";
+        case Deity::Apollo:      return "Apollo";
+        case Deity::Hecate:      return "Hecate";
+        default:                 return "Hub";
+    }
+}
+
 // ---- ThemeRegistry impl -----------------------------------------------------
 
 const Theme& ThemeRegistry::get(Deity d) {
@@ -0,0 +1,199 @@
+// Wanderers.cpp
+#include "Wanderers.hpp"
+#include <algorithm>
+
+const char* wandererName(WandererKind k) {
+    switch (k) {
+        case WandererKind::Shadow:  return "shadow";
+        case WandererKind::Stalker: return "stalker";
+        default:                    return "?";
+    }
+}
+
+// --- setup -------------------------------------------------------------------
+
+void Wanderers::attach(const TempleMap& map, std::uint32_t seed) {
+    map_ = &map;
+    seed_ = seed;
+    tick_ = 0;
+    const int n = map.size();
+
+    // exits out of each room, then the same edges turned round
+    outStart_.assign(n + 1, 0);
+    inStart_.assign(n + 1, 0);
+    for (int r = 0; r < n; ++r)
+        for (int to : map.exitsFrom(r))
+            if (to >= 0) { ++outStart_[r + 1]; ++inStart_[to + 1]; }
+    for (int r = 0; r < n; ++r) { outStart_[r + 1] += outStart_[r]; inStart_[r + 1] += inStart_[r]; }
+    out_.resize(outStart_[n]);
+    in_.resize(inStart_[n]);
+    std::vector<std::int32_t> fill(inStart_.begin(), inStart_.end() - 1);
+    for (int r = 0, o = 0; r < n; ++r)
+        for (int to : map.exitsFrom(r))
+            if (to >= 0) { out_[o++] = to; in_[fill[to]++] = r; }
+
+    lit_.assign(n, 0);
+    litRooms_.clear();
+    ++litVersion_;
+    for (Field* f : {&hunt_, &light_}) {
+        f->cell.assign(n, 0);
+        f->gen = 0;
+        f->key = ~0ull;
+    }
+    clear();
+}
+
+void Wanderers::clear() {
+    room.clear();
+    kind.clear();
+    rest.clear();
+}
+
+std::uint32_t Wanderers::spawn(WandererKind k, int at) {
+    room.push_back(at);
+    kind.push_back(k);
+    rest.push_back(0);
+    return static_cast<std::uint32_t>(room.size() - 1);
+}
+
+void Wanderers::setLit(int at, bool lit) {
+    if (at < 0 || at >= static_cast<int>(lit_.size()) || (lit_[at] != 0) == lit) return;
+    lit_[at] = lit;
+    if (lit) litRooms_.push_back(at);
+    else litRooms_.erase(std::find(litRooms_.begin(), litRooms_.end(), at));
+    ++litVersion_;
+}
+
+int Wanderers::countIn(int at, WandererKind k) const {
+    int n = 0;
+    for (std::size_t i = 0; i < room.size(); ++i) n += room[i] == at && kind[i] == k;
+    return n;
+}
+
+// --- fields ------------------------------------------------------------------
+
+// BFS out to `radius`. towardSources walks exits backwards, so a room's
+// distance is how many steps it takes to get from there to a source.
+void Wanderers::search(Field& f, const std::vector<std::int32_t>& sources, int radius, bool towardSources) {
+    if (++f.gen == 1u << 24) { std::fill(f.cell.begin(), f.cell.end(), 0); f.gen = 1; }
+    const std::uint32_t stamp = f.gen << 8;
+    f.queue.clear();
+    for (int s : sources) {
+        if (f.cell[s] >> 8 == f.gen) continue;
+        f.cell[s] = stamp;
+        f.queue.push_back(s);
+    }
+    const std::vector<std::int32_t>& start = towardSources ? inStart_ : outStart_;
+    const std::vector<std::int32_t>& edge  = towardSources ? in_ : out_;
+    for (std::size_t head = 0; head < f.queue.size(); ++head) {
+        const int r = f.queue[head];
+        const std::uint32_t d = f.cell[r] & 0xFF;
+        if (static_cast<int>(d) >= radius) continue;
+        for (int e = start[r]; e < start[r + 1]; ++e) {
+            const int to = edge[e];
+            if (f.cell[to] >> 8 == f.gen) continue;
+            f.cell[to] = stamp | (d + 1);
+            f.queue.push_back(to);
+        }
+    }
+}
+
+// --- tick --------------------------------------------------------------------
+
+// splitmix64 over (seed, tick, lane): no per-lane state, same dice every replay
+std::uint64_t Wanderers::dice(std::uint32_t lane) const {
+    std::uint64_t z = (static_cast<std::uint64_t>(seed_) << 32 ^ tick_ * 0x9E3779B97F4A7C15ull) + lane;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+Dir Wanderers::exitTo(int from, int to) const {
+    for (int d = 0; d < kDirCount; ++d)
+        if (map_->exit(from, static_cast<Dir>(d)) == to) return static_cast<Dir>(d);
+    return Dir::Count;
+}
+
+void Wanderers::step(int playerRoom, bool candle, std::vector<WandererSighting>& seen) {
+    ++tick_;
+    const int n = static_cast<int>(lit_.size());
+    const bool here = playerRoom >= 0 && playerRoom < n;
+
+    // fields only change when the player or a light does
+    const std::uint64_t huntKey = here ? static_cast<std::uint64_t>(playerRoom) : ~1ull;
+    if (hunt_.key != huntKey) {
+        sources_.clear();
+        if (here) sources_.push_back(playerRoom);
+        search(hunt_, sources_, kHuntRadius, true);
+        hunt_.key = huntKey;
+    }
+    const bool candleLit = here && candle;
+    const std::uint64_t lightKey = static_cast<std::uint64_t>(litVersion_) << 33
+                                 | static_cast<std::uint64_t>(candleLit) << 32
+                                 | static_cast<std::uint32_t>(candleLit ? playerRoom : -1);
+    if (light_.key != lightKey) {
+        sources_ = litRooms_;
+        if (candleLit) sources_.push_back(playerRoom);
+        search(light_, sources_, kLightRadius, false);
+        light_.key = lightKey;
+    }
+
+    // Neighbour of r lowest (or highest) in a field; ties go to whoever comes
+    // first from a random starting exit. kFar counts as highest.
+    auto extreme = [&](std::uint64_t& z, int r, const Field& f, bool lowest) {
+        const int begin = outStart_[r], deg = outStart_[r + 1] - begin;
+        const int first = roll(z, deg);
+        int best = out_[begin + first];
+        for (int k = 1; k < deg; ++k) {
+            const int to = out_[begin + (first + k) % deg];
+            if (lowest ? f.at(to) < f.at(best) : f.at(to) > f.at(best)) best = to;
+        }
+        return best;
+    };
+
+    // decide every lane against the same fields, then move them all
+    const std::uint32_t lanes = static_cast<std::uint32_t>(room.size());
+    next_.resize(lanes);
+    for (std::uint32_t i = 0; i < lanes; ++i) {
+        const int r = room[i];
+        const int deg = outStart_[r + 1] - outStart_[r];
+        int to = r;
+        if (deg > 0) {
+            std::uint64_t z = dice(i);
+            if (kind[i] == WandererKind::Stalker) {
+                if (rest[i] > 0) {
+                    --rest[i];
+                    to = extreme(z, r, hunt_, false);
+                } else if (here && r != playerRoom && hunt_.at(r) != kFar) {
+                    const int best = extreme(z, r, hunt_, true);
+                    const bool inView = best == playerRoom && candleLit;
+                    if (roll(z, 3) != 0 && !inView && hunt_.at(best) < hunt_.at(r)) to = best;
+                } else if (roll(z, 2) == 0) {
+                    to = out_[outStart_[r] + roll(z, deg)];
+                }
+            } else {   // Shadow
+                if (light_.at(r) != kFar) {
+                    const int best = extreme(z, r, light_, false);
+                    if (light_.at(best) > light_.at(r)) to = best;
+                } else if (roll(z, 3) == 0) {
+                    const int any = out_[outStart_[r] + roll(z, deg)];
+                    if (light_.at(any) == kFar) to = any;
+                }
+            }
+        }
+        next_[i] = to;
+    }
+
+    for (std::uint32_t i = 0; i < lanes; ++i) {
+        const int from = room[i], to = next_[i];
+        if (from == to) continue;
+        room[i] = to;
+        if (!here) continue;
+        if (to == playerRoom) {
+            seen.push_back({i, kind[i], true, exitTo(playerRoom, from)});
+            if (kind[i] == WandererKind::Stalker) rest[i] = kStalkerRest;
+        } else if (from == playerRoom) {
+            seen.push_back({i, kind[i], false, exitTo(playerRoom, to)});
+        }
+    }
+}
@@ -0,0 +1,104 @@
+// WorldValidator.cpp
+#include "WorldValidator.hpp"
+#include <cstdlib>
+#include <iostream>
+
+namespace {
+
+const char* kindName(WorldIssue::Kind k) {
+    switch (k) {
+        case WorldIssue::Kind::Unreachable:        return "unreachable";
+        case WorldIssue::Kind::MissingReverse:     return "one-way exit";
+        case WorldIssue::Kind::DanglingTitle:      return "unknown title";
+        case WorldIssue::Kind::DuplicateDirection: return "exit wired twice";
+        case WorldIssue::Kind::NoLocationId:       return "no location id";
+        case WorldIssue::Kind::NoDeity:            return "no deity";
+    }
+    return "?";
+}
+
+std::string roomLabel(const TempleMap& map, int id) {
+    return "'" + map.nodes()[id].name + "' (#" + std::to_string(id) + ")";
+}
+
+} // namespace
+
+WorldReport ValidateWorld(const TempleMap& map, int start) {
+    WorldReport report;
+    const int n = map.size();
+    report.rooms = n;
+    auto add = [&](WorldIssue::Kind k, std::string detail) {
+        report.issues.push_back({k, std::move(detail)});
+    };
+
+    // --- wiring log: typos and overwrites never make it into the graph ------
+    for (const std::string& title : map.unresolvedTitles())
+        add(WorldIssue::Kind::DanglingTitle, "'" + title + "'");
+    for (const auto& c : map.clashes())
+        add(WorldIssue::Kind::DuplicateDirection,
+            roomLabel(map, c.from) + " " + dirName(c.dir) + ": " +
+            roomLabel(map, c.was) + " replaced by " + roomLabel(map, c.now));
+
+    // --- reachability: one BFS from the start room -------------------------
+    std::vector<bool> seen(static_cast<size_t>(n), false);
+    if (start >= 0 && start < n) {
+        std::vector<int> queue;
+        queue.reserve(static_cast<size_t>(n));
+        queue.push_back(start);
+        seen[start] = true;
+        for (size_t head = 0; head < queue.size(); ++head) {
+            for (int v : map.exitsFrom(queue[head])) {
+                if (v < 0 || seen[v]) continue;
+                seen[v] = true;
+                queue.push_back(v);
+            }
+        }
+    } else if (n > 0) {
+        add(WorldIssue::Kind::Unreachable, "start room #" + std::to_string(start) + " does not exist");
+    }
+
+    // --- per room: metadata, exits and their way back ----------------------
+    for (int id = 0; id < n; ++id) {
+        const MapNode& node = map.nodes()[id];
+        if (!seen[id])
+            add(WorldIssue::Kind::Unreachable, roomLabel(map, id));
+
+        if (id != start) {
+            if (node.locId.empty()) add(WorldIssue::Kind::NoLocationId, roomLabel(map, id));
+            if (node.deity == Deity::Default) add(WorldIssue::Kind::NoDeity, roomLabel(map, id));
+        }
+
+        for (int d = 0; d < kDirCount; ++d) {
+            const Dir dir = static_cast<Dir>(d);
+            const int to = map.exit(id, dir);
+            if (to < 0) continue;
+            ++report.exits;
+            if (map.isOneWay(id, dir)) continue;
+            if (map.exit(to, oppositeDir(dir)) != id)
+                add(WorldIssue::Kind::MissingReverse,
+                    roomLabel(map, id) + " " + dirName(dir) + " -> " + roomLabel(map, to) +
+                    ", but " + dirName(oppositeDir(dir)) + " from there doesn't lead back");
+        }
+    }
+    return report;
+}
+
+void PrintWorldReport(const WorldReport& report, std::ostream& os) {
+    os << "=== WORLD CHECK: " << report.rooms << " rooms, " << report.exits << " exits, "
+       << report.issues.size() << " issue(s) ===\n";
+    for (const auto& issue : report.issues)
+        os << "  [" << kindName(issue.kind) << "] " << issue.detail << "\n";
+}
+
+bool CheckWorld(const TempleMap& map, int start, const char* worldName) {
+    const WorldReport report = ValidateWorld(map, start);
+    if (report.ok()) return true;
+
+    std::cerr << "[world] " << worldName << " failed validation\n";
+    PrintWorldReport(report, std::cerr);
+#ifndef NDEBUG
+    std::cerr << "[world] aborting (debug build); fix the wiring above.\n";
+    std::abort();
+#endif
+    return false;
+}
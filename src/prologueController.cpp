@@ -4,8 +4,15 @@
 #include <string>
 
 namespace {
-    void printPrologueHelpBanner() {
-        std::cout
+    // What the nights bring, booked on the night after day 2, 4 and 6.
+    const char* const kOmens[] = {
+        "Somewhere, a page turns though no one is there.",
+        "The corridors feel longer tonight, but you arrive all the same.",
+        "You wake from a dream you can’t recall—only warmth and candlelight.",
+    };
+
+    void printPrologueHelpBanner(std::ostream& out) {
+        out
             << "\n— Lysaia’s Prologue —\n"
             << "Commands:\n"
             << "  look / look around      reprint the room\n"
@@ -19,106 +26,119 @@ namespace {
     }
 }
 
-void PrologueController::run() {
-    // Auto-flush every insertion during the prologue so banners/prompt lines appear immediately.
-    std::cout << std::unitbuf;
+// ---- Safe wrappers so empty std::function never throws ----
+void PrologueController::describe() {
+    if (hooks_.describe) hooks_.describe();
+    else *out_ << "(No description available.)\n";
+}
 
-    // ---- Safe wrappers so empty std::function never throws ----
-    auto safePrompt = [this]() -> std::string {
-        return hooks_.promptPrefix ? hooks_.promptPrefix() : std::string("> ");
-    };
-    auto callDescribe = [this]() {
-        if (hooks_.describe) hooks_.describe();
-        else std::cout << "(No description available.)\n";
-    };
-    auto callListExits = [this]() {
-        if (hooks_.listExits) hooks_.listExits();
-        else std::cout << "(No exit info available.)\n";
-    };
-    auto callShowJournal = [this]() {
-        if (hooks_.showJournal) hooks_.showJournal();
-        else std::cout << "(Journal is unavailable.)\n";
-    };
-    auto callWriteJournal = [this](int day) {
-        if (hooks_.writeJournal) hooks_.writeJournal(day);
-    };
-    auto callMoveTo = [this](const std::string& dir) -> bool {
-        return hooks_.moveTo ? hooks_.moveTo(dir) : false;
-    };
+void PrologueController::listExits() {
+    if (hooks_.listExits) hooks_.listExits();
+    else *out_ << "(No exit info available.)\n";
+}
 
-    constexpr int kMaxDays = 7;
-
-    // Print header + banner ONCE before the loop.
-    std::cout << "\n(Prologue) Type 'help' for commands.\n";
-    printPrologueHelpBanner();
-
-    for (int day = 1; day <= kMaxDays; ++day) {
-        std::cout << "\n— Day " << day << " —\n";
-
-        // Ensure header is visibly out before the (chatty) describe path runs.
-        std::cout.flush();
-        callDescribe();          // (your describe also prints Exits)
-
-        bool wrote = false, endDay = false;
-        while (!endDay) {
-            std::cout << safePrompt();
-
-            std::string line;
-            if (!std::getline(std::cin, line)) {
-                std::cout << std::nounitbuf; // restore
-                return;
-            }
-
-            const std::string lineTrim = trim_copy(line);
-            if (lineTrim.empty()) continue;
-
-            auto [cmdTok, restRaw] = split_first(lineTrim);
-            const std::string cmd = toLower(cmdTok);
-            const std::string rest = restRaw;
-            const std::string wholeLower = toLower(lineTrim);
-
-            if (auto dir = normalize_dir(cmd); !dir.empty()) {
-                const bool moved = callMoveTo(dir);
-                if (moved) callDescribe();
-                continue;
-            }
-            if (is_move_verb(cmd)) {
-                if (auto dir = normalize_dir(rest); !dir.empty()) {
-                    const bool moved = callMoveTo(dir);
-                    if (moved) callDescribe();
-                } else if (!rest.empty()) {
-                    const bool moved = callMoveTo(rest);
-                    if (moved) callDescribe();
-                } else {
-                    std::cout << "Move where?\n";
-                }
-                continue;
-            }
-            if (cmd == "help") { printPrologueHelpBanner(); continue; }
-            if (cmd == "look" || wholeLower == "look around") { callDescribe(); continue; }
-            if (cmd == "exits") { callListExits(); continue; }
-            if (cmd == "where") { callDescribe(); callListExits(); continue; }
-            if (cmd == "journal") { callShowJournal(); continue; }
-            if (cmd == "write") {
-                if (wrote) std::cout << "(You’ve already written today.)\n";
-                else { callWriteJournal(day); wrote = true; }
-                continue;
-            }
-            if (cmd == "end" || cmd == "sleep" || cmd == "finish" || cmd == "next") {
-                if (!wrote) { std::cout << "(You haven’t written today. Type 'end' again to sleep anyway.)\n"; wrote = true; }
-                else { endDay = true; }
-                continue;
-            }
-            std::cout << "Unknown command. Type 'help'.\n";
-        }
+bool PrologueController::moveTo(const std::string& dir) {
+    const bool moved = hooks_.moveTo ? hooks_.moveTo(dir) : false;
+    if (moved) describe();
+    return moved;
+}
+
+std::string PrologueController::prompt() const {
+    return hooks_.promptPrefix ? hooks_.promptPrefix() : std::string("> ");
+}
+
+void PrologueController::start() {
+    day_ = 0;
+    nights_.clear();
+    for (int i = 0; i < 3; ++i) nights_.schedule(2 + 2 * i, TimedEvent{TimedKind::Omen, i});
+    // Print header + banner ONCE before the first day.
+    *out_ << "\n(Prologue) Type 'help' for commands.\n";
+    printPrologueHelpBanner(*out_);
+    beginDay();
+}
 
-        if (day == 2) std::cout << "Somewhere, a page turns though no one is there.\n";
-        if (day == 4) std::cout << "The corridors feel longer tonight, but you arrive all the same.\n";
-        if (day == 6) std::cout << "You wake from a dream you can’t recall—only warmth and candlelight.\n";
+void PrologueController::beginDay() {
+    ++day_;
+    wrote_ = false;
+    *out_ << "\n— Day " << day_ << " —\n";
+
+    // Ensure header is visibly out before the (chatty) describe path runs.
+    out_->flush();
+    describe();          // (your describe also prints Exits)
+}
+
+void PrologueController::endDay() {
+    nights_.advance(1);
+    for (TimedEvent e; nights_.next(e);)
+        if (e.kind == TimedKind::Omen) *out_ << kOmens[e.arg] << "\n";
+
+    if (day_ < kMaxDays) { beginDay(); return; }
+
+    ++day_;   // past the last day: done()
+    *out_ << "\nThe candle gutters. The temple is not as it was.\nPrologue complete.\n";
+}
+
+bool PrologueController::feed(const std::string& line) {
+    if (done()) return false;
+
+    const std::string lineTrim = trim_copy(line);
+    if (lineTrim.empty()) return true;
+
+    auto [cmdTok, restRaw] = split_first(lineTrim);
+    const std::string cmd = toLower(cmdTok);
+    const std::string rest = restRaw;
+    const std::string wholeLower = toLower(lineTrim);
+
+    if (auto dir = normalize_dir(cmd); !dir.empty()) {
+        moveTo(dir);
+        return true;
     }
+    if (is_move_verb(cmd)) {
+        if (auto dir = normalize_dir(rest); !dir.empty()) moveTo(dir);
+        else if (!rest.empty())                            moveTo(rest);
+        else *out_ << "Move where?\n";
+        return true;
+    }
+    if (cmd == "help") { printPrologueHelpBanner(*out_); return true; }
+    if (cmd == "look" || wholeLower == "look around") { describe(); return true; }
+    if (cmd == "exits") { listExits(); return true; }
+    if (cmd == "where") { describe(); listExits(); return true; }
+    if (cmd == "journal") {
+        if (hooks_.showJournal) hooks_.showJournal();
+        else *out_ << "(Journal is unavailable.)\n";
+        return true;
+    }
+    if (cmd == "write") {
+        if (wrote_) *out_ << "(You’ve already written today.)\n";
+        else {
+            if (hooks_.writeJournal) hooks_.writeJournal(day_);
+            wrote_ = true;
+        }
+        return true;
+    }
+    if (cmd == "end" || cmd == "sleep" || cmd == "finish" || cmd == "next") {
+        if (!wrote_) { *out_ << "(You haven’t written today. Type 'end' again to sleep anyway.)\n"; wrote_ = true; }
+        else endDay();
+        return !done();
+    }
+    *out_ << "Unknown command. Type 'help'.\n";
+    return true;
+}
 
-    std::cout << "\nThe candle gutters. The temple is not as it was.\nPrologue complete.\n";
+bool PrologueController::run(CancelToken& cancel, std::chrono::milliseconds idle) {
+    // Auto-flush every insertion during the prologue so banners/prompt lines appear immediately.
+    *out_ << std::unitbuf;
+
+    start();
+    while (!done()) {
+        *out_ << prompt();
+
+        std::string line;
+        if (!readLineOrCancel(line, cancel, idle)) break;
+        feed(line);
+    }
 
     // Restore normal buffering once we exit the prologue.
-    std::cout << std::nounitbuf;
+    *out_ << std::nounitbuf;
+    return done();
 }
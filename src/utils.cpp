@@ -16,6 +16,9 @@
   #endif
   #define ISATTY _isatty
 #else
+  #include <cerrno>
+  #include <poll.h>
+  #include <termios.h>
   #include <unistd.h>
   #define ISATTY isatty
 #endif
@@ -104,6 +107,63 @@ void flush() {
     std::fflush(stdout);
 }
 
+void discardPendingInput() {
+#if defined(_WIN32)
+    FlushConsoleInputBuffer(GetStdHandle(STD_INPUT_HANDLE));
+#else
+    if (ISATTY(STDIN_FILENO)) tcflush(STDIN_FILENO, TCIFLUSH);
+#endif
+}
+
+bool waitForInput(CancelToken& token, std::chrono::milliseconds idle) {
+    using clock = std::chrono::steady_clock;
+    constexpr std::chrono::milliseconds kSlice{100};
+    const auto deadline = clock::now() + idle;
+
+    for (;;) {
+        if (token.cancelled()) return false;
+        if (std::cin.rdbuf()->in_avail() > 0) return true;   // already buffered
+
+        auto slice = kSlice;
+        if (idle.count() > 0) {
+            const auto left = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - clock::now());
+            if (left.count() <= 0) { token.cancel(CancelToken::Reason::Timeout); return false; }
+            slice = std::min(slice, left);
+        }
+#if defined(_WIN32)
+        // Only a console handle can be waited on; pipes and files just read.
+        const HANDLE in = GetStdHandle(STD_INPUT_HANDLE);
+        if (GetFileType(in) != FILE_TYPE_CHAR) return true;
+        if (WaitForSingleObject(in, static_cast<DWORD>(slice.count())) == WAIT_OBJECT_0) return true;
+#else
+        pollfd p{STDIN_FILENO, POLLIN, 0};
+        const int ready = ::poll(&p, 1, static_cast<int>(slice.count()));
+        if (ready > 0) return true;                    // a line, or EOF/hangup for getline to see
+        if (ready < 0 && errno != EINTR) return true;  // can't wait on this stdin; just read
+#endif
+    }
+}
+
+bool readLineOrCancel(std::string& out, CancelToken& token, std::chrono::milliseconds idle) {
+    if (!waitForInput(token, idle)) return false;
+    if (!std::getline(std::cin, out)) {
+        token.cancel(CancelToken::Reason::EndOfInput);
+        return false;
+    }
+    return true;
+}
+
+void flashLine(std::string_view text, int ms) {
+    std::cout << std::flush;   // whatever iostream still holds goes out first
+    writeRaw(text);
+    flush();
+    sleepMillis(ms);
+    if (ansiCapable()) writeRaw("\r\x1b[2K");
+    else { cr(); writeRaw(std::string(text.size(), ' ')); cr(); }
+    flush();
+    discardPendingInput();
+}
+
  std::string trim_copy(std::string s) {
         auto not_space = [](int ch){ return !std::isspace(ch); };
         s.erase(s.begin(), std::find_if(s.begin(), s.end(), not_space));
@@ -0,0 +1,240 @@
+// autoplay.cpp — best achievable chance of each ending, and the play that gets it.
+// Build: make autoplay     Run: ./bin/autoplay [options]   (--help for the list)
+//
+// With --play N the bot also plays N real runs per ending: the actual shrine
+// code (StartShrine + fragment pickups) with seeded dice, answering every
+// prompt the way its policy says. The runs advance together in a PlayerBatch. The hit rate should land on the predicted
+// chance; if it doesn't, ShrineModel has drifted from the mechanics.
+#include "AutoPlayer.hpp"
+#include "EndingRules.hpp"
+#include "FragmentPlacer.hpp"
+#include "PersephoneFragments.hpp"
+#include "PlayerBatch.hpp"
+#include "ShrineRunner.hpp"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+namespace {
+
+void usage() {
+    std::cout <<
+        "usage: autoplay [options]\n"
+        "  --stats H,W,I,N     starting health/will/insight/nerve (default 5,7,2,2)\n"
+        "  --corruption N      starting corruption (default 10)\n"
+        "  --nyx-pages         Nyx can take a journal page\n"
+        "  --no-stop           must play on until Eris or an ending\n"
+        "  --play N            also play N real runs per ending with the bot's policy\n"
+        "  --seed S            first seed for --play (default 1)\n";
+}
+
+struct NullJournal : IJournalSink {
+    void writeLysaia(const std::string&) override {}
+    void writeMelas(const std::string&) override {}
+};
+
+// Answers prompts the way the chosen BotMove plays the shrine.
+struct BotUI {
+    const BotMove& move;
+    const PlayerState& player;
+    int picks = 0;
+    std::string lastNotes;
+
+    void print(const std::string& s) {
+        if (s.rfind("Notes: ", 0) == 0) lastNotes = s.substr(7);
+    }
+    void waitForKey() {}
+    void flash(const std::string& s, int) { print(s); }
+
+    int choose(const std::string& prompt, const std::vector<std::string>& options) {
+        const model::ShrinePlay& play = move.play;
+        switch (move.shrine) {
+            case Deity::Demeter: {
+                // in order: true index 1, 2, 3...; out of order: 8, 7, 6...
+                const int want = play.demeterOrder == model::ShrinePlay::Order::Known ? picks + 1 : 8 - picks;
+                ++picks;
+                const auto owned = GetOwnedPersephoneFragments(player);
+                for (size_t i = 0; i < owned.size(); ++i)
+                    if (owned[i].first == want) return static_cast<int>(i) + 1;
+                return 1;
+            }
+            case Deity::Apollo:
+                for (const Riddle* r : ApolloRiddleSet()) {
+                    if (r->prompt != prompt) continue;
+                    if (play.apolloKnown > 0) return r->correctIndex1Based;
+                    return r->correctIndex1Based % static_cast<int>(options.size()) + 1;
+                }
+                return 1;
+            case Deity::Hecate:   return play.hecateDoor;
+            case Deity::Thanatos: return play.thanatosChoice;
+            case Deity::Eris:     return play.erisChoice;
+            default:              return 1;
+        }
+    }
+
+    std::string ask(const std::string&) { return move.play.panRecall > 0 ? lastNotes : "0"; }
+};
+
+Ending endingFromRule(const std::string& id) {
+    if (id == "endless_hall")   return Ending::EndlessHall;
+    if (id == "thanatos_sleep") return Ending::ThanatosSleep;
+    if (id == "joined_choir")   return Ending::JoinedChoir;
+    if (id == "lysaia_turns")   return Ending::LysaiaTurns;
+    if (id == "overcame")       return Ending::Overcame;
+    if (id == "claimed")        return Ending::Claimed;
+    return Ending::None;
+}
+
+BotState botStateOf(const PlayerState& ps, FlagStore& flags, std::uint16_t visited) {
+    BotState s;
+    s.stats = { ps.stats.health, ps.stats.will, ps.stats.insight, ps.stats.nerve, ps.corruption, 0 };
+    s.stats.set(model::F_Demeter, flags["demeter_letter_solved"]);
+    s.stats.set(model::F_Apollo,  flags["apollo_majority_right"]);
+    s.stats.set(model::F_Pan,     flags["pan_memory_mastered"]);
+    s.stats.set(model::F_Nyx,     flags["nyx_helpful_trade"]);
+    s.visited = visited;
+    return s;
+}
+
+// The authored fragment layout; the bot walks each room of a wing.
+void pickUp(InteractionContext& ctx, std::initializer_list<const char*> rooms) {
+    for (const char* room : rooms)
+        for (const SpawnEntry& s : PersephoneFragmentSpawns())
+            if (std::string(s.room) == room) PickUpItem(ctx, s.item);
+}
+
+// `runs` real runs played for `target`, in lockstep: each step every live run
+// picks its move and plays its shrine on a scratch PlayerState, then the whole
+// batch takes its outcomes in one pass. Run k rolls RNG(seed + k). Returns
+// how many ended with `target`.
+int playReal(AutoPlayer& bot, Ending target, const Stats& start, int corruption,
+             const BotOptions& opt, unsigned seed, int runs) {
+    const std::size_t n = static_cast<std::size_t>(runs);
+    PlayerBatch batch(n, start, corruption);
+    OutcomeBatch outcomes(n);
+    std::vector<RNG> rngs;
+    for (std::size_t k = 0; k < n; ++k) rngs.emplace_back(seed + static_cast<unsigned>(k));
+    std::vector<FlagStore> flags(n);
+    std::vector<std::uint16_t> visited(n, 0);
+    std::vector<std::size_t> live(n);
+    for (std::size_t k = 0; k < n; ++k) live[k] = k;
+
+    NullJournal journal;
+    PlayerState ps;
+    ps.view = WorldView::Corrupted;
+    ShrineServices svc;
+    if (opt.nyxHasPages) svc.takeMelasEntry = []() -> std::optional<std::string> { return std::string("page"); };
+
+    int hits = 0;
+    std::vector<Deity> played(n, Deity::Default);
+    while (!live.empty()) {
+        outcomes.clear();
+        for (std::size_t k : live) {
+            batch.load(k, ps);
+            const BotMove move = bot.bestMove(target, botStateOf(ps, flags[k], visited[k]));
+            played[k] = move.shrine;
+            if (move.shrine == Deity::Default) continue;
+
+            for (std::size_t i = 0; i < BotWingCount(); ++i)
+                if (BotWing(i) == move.shrine) visited[k] |= static_cast<std::uint16_t>(1u << i);
+
+            InteractionContext ctx{ps, rngs[k], journal, WorldView::Corrupted, ShrineState::CORRUPTED, flags[k]};
+            if (move.shrine == Deity::Persephone) pickUp(ctx, {"Hall of Petals", "Orchard Walk", "The Frozen Spring"});
+            if (move.shrine == Deity::Demeter)    pickUp(ctx, {"The Threadbare Womb", "The Hall of Hunger"});
+
+            const Shrine shrine(deityLabel(move.shrine), "");
+            BotUI ui{move, ps, 0, {}};
+            outcomes.set(k, DriveShrine(*StartShrine(shrine, ctx, svc), ui));
+            batch.store(k, ps);   // pickups and anything the shrine spent
+        }
+        batch.apply(outcomes);
+
+        std::size_t still = 0;
+        for (std::size_t k : live) {
+            // walked away, or Eris let the run end without one
+            if (played[k] == Deity::Default) { hits += target == Ending::None; continue; }
+            batch.load(k, ps);
+            const int rule = EndingRules().firstHolding(flags[k], ps);
+            if (rule >= 0) { hits += endingFromRule(EndingRules().def(rule).id) == target; continue; }
+            if (played[k] == Deity::Eris) { hits += target == Ending::None; continue; }
+            live[still++] = k;
+        }
+        live.resize(still);
+    }
+    return hits;
+}
+
+// The line of play the bot expects: its move, then the likeliest way it goes.
+void printPlan(AutoPlayer& bot, Ending target) {
+    BotState s = bot.start();
+    std::vector<model::Branch> branches;
+    std::vector<BotState> next;
+    for (int step = 0; step < 12; ++step) {
+        const BotMove m = bot.bestMove(target, s);
+        std::cout << "      " << m.describe();
+        if (m.shrine == Deity::Default) { std::cout << "\n"; return; }
+
+        bot.expand(s, m, branches, next);
+        std::size_t likely = 0;
+        for (std::size_t i = 1; i < branches.size(); ++i)
+            if (branches[i].p > branches[likely].p) likely = i;
+        const model::Branch& b = branches[likely];
+        std::cout << std::fixed << std::setprecision(3) << "   (" << b.p << ")";
+        if (b.over) { std::cout << " -> " << endingName(b.ending) << "\n"; return; }
+        std::cout << "\n";
+        s = next[likely];
+    }
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Stats start;                 // same start as InitMechanics for Melas
+    start.health = 5; start.will = 7; start.insight = 2; start.nerve = 2;
+    int corruption = 10;
+    BotOptions opt;
+    int plays = 0;
+    unsigned seed = 1;
+
+    for (int i = 1; i < argc; ++i) {
+        const std::string a = argv[i];
+        auto val = [&]() -> std::string { return (i + 1 < argc) ? argv[++i] : ""; };
+        if      (a == "--stats")      std::sscanf(val().c_str(), "%d,%d,%d,%d", &start.health, &start.will, &start.insight, &start.nerve);
+        else if (a == "--corruption") corruption = std::atoi(val().c_str());
+        else if (a == "--nyx-pages")  opt.nyxHasPages = true;
+        else if (a == "--no-stop")    opt.allowStop = false;
+        else if (a == "--play")       plays = std::atoi(val().c_str());
+        else if (a == "--seed")       seed = static_cast<unsigned>(std::strtoul(val().c_str(), nullptr, 10));
+        else { usage(); return a == "--help" ? 0 : 1; }
+    }
+
+    AutoPlayer bot(start, corruption, opt);
+
+    const auto t0 = std::chrono::steady_clock::now();
+    double best[kEndingCount];
+    for (int e = 0; e < kEndingCount; ++e) best[e] = bot.bestChance(static_cast<Ending>(e));
+    const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+
+    std::cout << "Best chance of each ending, playing for it\n";
+    for (int e = 0; e < kEndingCount; ++e) {
+        const Ending end = static_cast<Ending>(e);
+        std::cout << "  " << std::left << std::setw(24) << endingName(end) << std::right
+                  << std::fixed << std::setprecision(4) << std::setw(8) << best[e] * 100.0 << " %";
+        if (plays > 0) {
+            const int hits = playReal(bot, end, start, corruption, opt, seed, plays);
+            const double rate = static_cast<double>(hits) / plays;
+            const double sigma = std::sqrt(std::max(best[e] * (1 - best[e]), 1e-12) / plays);
+            std::cout << "   played " << std::setw(8) << rate * 100.0 << " %  ("
+                      << std::setprecision(1) << std::abs(rate - best[e]) / sigma << " sigma)";
+        }
+        std::cout << "\n";
+        printPlan(bot, end);
+    }
+    std::cout << "\n" << bot.tableSize() << " positions in the table, " << bot.nodesExpanded()
+              << " searched, " << std::setprecision(1) << ms << " ms\n";
+    return 0;
+}
@@ -0,0 +1,311 @@
+// balance.cpp — tune the shrine numbers (BalanceParams) toward target ending rates.
+// Build: make balance     Run: ./bin/balance [options]   (--help for the list)
+//
+// Each candidate set of numbers is scored by playing a population of simulated
+// players through the real shrines (StartShrine + DriveShrine, the scripts if
+// they load) from the Melas start, every wing in hub order, Eris last. Player
+// k rolls RNG(seed + k) under every candidate, so two candidates differ by
+// their numbers, not their dice. The search is a plain random search: perturb
+// the best set so far inside each key's range, keep whatever scores better,
+// narrow the steps as it goes. Candidates of a generation are played on all
+// cores at once.
+#include "BalanceParams.hpp"
+#include "EndingAnalyzer.hpp"   // DefaultShrineRoute
+#include "EndingRules.hpp"
+#include "FragmentPlacer.hpp"
+#include "PersephoneFragments.hpp"
+#include "ShrineRegistry.hpp"
+#include "ShrineRunner.hpp"
+#include "ShrineScript.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+void usage() {
+    std::cout <<
+        "usage: balance [options]\n"
+        "  --target id=P,...   wanted share of each ending, P in 0..1 (ids from EndingRules:\n"
+        "                      endless_hall, thanatos_sleep, joined_choir, lysaia_turns,\n"
+        "                      overcame, claimed; 'none' for no ending). Without targets\n"
+        "                      it only reports the current numbers.\n"
+        "  --from FILE         start from this file (default: assets/balance.txt)\n"
+        "  --runs N            simulated players per candidate (default 2000)\n"
+        "  --gens G            generations (default 30)\n"
+        "  --pop P             candidates per generation (default 16)\n"
+        "  --threads T         worker threads (default: every core)\n"
+        "  --seed S            first player seed; the search uses S too (default 1)\n"
+        "  --out FILE          write the tuned numbers here (default: stdout)\n";
+}
+
+struct NullJournal : IJournalSink {
+    void writeLysaia(const std::string&) override {}
+    void writeMelas(const std::string&) override {}
+};
+
+// One simulated player. `skill` is how often they get a puzzle right (Apollo,
+// Pan, Demeter's order); menus with no right answer are picked at random.
+struct SimUI {
+    RNG& rng;
+    const PlayerState& player;
+    Deity shrine = Deity::Default;
+    double skill = 0.5;
+    int picks = 0;
+    std::vector<bool> used;   // Demeter's fragments laid down so far
+    std::string lastNotes;
+
+    bool sure() { return rng.roll(1, 1000) <= static_cast<int>(skill * 1000); }
+
+    void print(const std::string& s) {
+        if (s.rfind("Notes: ", 0) == 0) lastNotes = s.substr(7);
+    }
+    void waitForKey() {}
+    void flash(const std::string& s, int) { print(s); }
+
+    int choose(const std::string& prompt, const std::vector<std::string>& options) {
+        const int n = std::max(1, static_cast<int>(options.size()));
+        switch (shrine) {
+            case Deity::Demeter: {
+                // the altar asks again for a fragment already laid down, so
+                // guesses come from the ones left
+                const auto owned = GetOwnedPersephoneFragments(player);
+                used.resize(owned.size(), false);
+                std::vector<int> left;
+                for (size_t i = 0; i < owned.size(); ++i) if (!used[i]) left.push_back(static_cast<int>(i));
+                if (left.empty()) return 1;
+                int pick = left[rng.roll(0, static_cast<int>(left.size()) - 1)];
+                if (sure())
+                    for (int i : left) if (owned[i].first == picks + 1) pick = i;
+                used[pick] = true;
+                ++picks;
+                return pick + 1;
+            }
+            case Deity::Apollo:
+                for (const Riddle* r : ApolloRiddleSet())
+                    if (r->prompt == prompt && sure()) return r->correctIndex1Based;
+                return rng.roll(1, n);
+            default:
+                return rng.roll(1, n);
+        }
+    }
+
+    std::string ask(const std::string&) { return sure() ? lastNotes : "0"; }
+};
+
+// Ending slots: EndingRules() in table order, then "none".
+struct Targets {
+    std::vector<std::string> ids;
+    std::vector<double> want;      // < 0 = not targeted
+    bool any = false;
+
+    Targets() {
+        for (std::size_t i = 0; i < EndingRules().size(); ++i) ids.push_back(EndingRules().def(i).id);
+        ids.push_back("none");
+        want.assign(ids.size(), -1.0);
+    }
+    int slot(const std::string& id) const {
+        for (std::size_t i = 0; i < ids.size(); ++i) if (ids[i] == id) return static_cast<int>(i);
+        return -1;
+    }
+    std::size_t none() const { return ids.size() - 1; }
+};
+
+bool parseTargets(const std::string& list, Targets& t) {
+    std::istringstream iss(list);
+    for (std::string item; std::getline(iss, item, ',');) {
+        const std::size_t eq = item.find('=');
+        const int s = eq == std::string::npos ? -1 : t.slot(item.substr(0, eq));
+        if (s < 0) { std::cerr << "bad target '" << item << "'\n"; return false; }
+        const double p = std::atof(item.c_str() + eq + 1);
+        if (p < 0 || p > 1) { std::cerr << "target '" << item << "' must be 0..1\n"; return false; }
+        t.want[s] = p;
+        t.any = true;
+    }
+    return true;
+}
+
+struct Setup {
+    Stats start;
+    int corruption = 10;
+    std::vector<Deity> route;
+    int runs = 2000;
+    unsigned seed = 1;
+};
+
+// Player k from the Melas start to an ending, or through Eris without one.
+std::size_t playOne(const Setup& s, const Targets& t, const BalanceParams& params, unsigned k) {
+    RNG rng(s.seed + k);
+    NullJournal journal;
+    FlagStore flags;
+    PlayerState ps;
+    ps.stats = s.start;
+    ps.corruption = s.corruption;
+    ps.view = WorldView::Corrupted;
+    InteractionContext ctx{ps, rng, journal, WorldView::Corrupted, ShrineState::CORRUPTED, flags, &params};
+
+    // the authored fragment layout, all of it
+    for (const SpawnEntry& e : PersephoneFragmentSpawns()) PickUpItem(ctx, e.item);
+
+    SimUI ui{rng, ps, Deity::Default, 0.5, 0, {}, {}};
+    ui.skill = rng.roll(0, 100) / 100.0;
+    for (Deity d : s.route) {
+        ui.shrine = d;
+        ui.picks = 0;
+        ui.used.clear();
+        const Shrine shrine(deityLabel(d), "");
+        ps.applyOutcome(DriveShrine(*StartShrine(shrine, ctx), ui));
+        const int rule = EndingRules().firstHolding(flags, ps);
+        if (rule >= 0) return static_cast<std::size_t>(rule);
+    }
+    return t.none();
+}
+
+std::vector<double> distribution(const Setup& s, const Targets& t, const BalanceParams& params) {
+    std::vector<double> share(t.ids.size(), 0.0);
+    for (int k = 0; k < s.runs; ++k) share[playOne(s, t, params, static_cast<unsigned>(k))] += 1.0;
+    for (double& v : share) v /= s.runs;
+    return share;
+}
+
+// Squared miss on the targeted endings, plus a nudge toward the starting
+// numbers so keys the targets don't care about stay put.
+double score(const Targets& t, const std::vector<double>& share,
+             const BalanceParams& p, const BalanceParams& from) {
+    double err = 0;
+    for (std::size_t i = 0; i < share.size(); ++i)
+        if (t.want[i] >= 0) err += (share[i] - t.want[i]) * (share[i] - t.want[i]);
+    double drift = 0;
+    for (std::size_t i = 0; i < BalanceParamCount(); ++i) {
+        const BalanceParamDef& d = BalanceParamDefs()[i];
+        drift += std::abs(p.*d.field - from.*d.field) / static_cast<double>(d.hi - d.lo);
+    }
+    return err + 1e-4 * drift;
+}
+
+void printDistribution(const Targets& t, const std::vector<double>& share, const char* title) {
+    std::cout << title << "\n";
+    for (std::size_t i = 0; i < share.size(); ++i) {
+        std::cout << "  " << std::left << std::setw(16) << t.ids[i] << std::right
+                  << std::fixed << std::setprecision(2) << std::setw(7) << share[i] * 100.0 << " %";
+        if (t.want[i] >= 0) std::cout << "   want " << std::setw(6) << t.want[i] * 100.0 << " %";
+        std::cout << "\n";
+    }
+}
+
+// Perturb `best`: each key moves with chance 1/3 by up to `radius` of its range.
+BalanceParams mutate(const BalanceParams& best, RNG& rng, double radius) {
+    BalanceParams p = best;
+    bool moved = false;
+    while (!moved) {
+        for (std::size_t i = 0; i < BalanceParamCount(); ++i) {
+            const BalanceParamDef& d = BalanceParamDefs()[i];
+            if (rng.roll(1, 3) != 1) continue;
+            const int step = std::max(1, static_cast<int>((d.hi - d.lo) * radius + 0.5));
+            const int v = std::clamp(p.*d.field + rng.roll(-step, step), d.lo, d.hi);
+            moved |= v != p.*d.field;
+            p.*d.field = v;
+        }
+    }
+    return p;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Setup setup;                 // same start as InitMechanics for Melas
+    setup.start.health = 5; setup.start.will = 7; setup.start.insight = 2; setup.start.nerve = 2;
+    setup.route = DefaultShrineRoute();
+    Targets targets;
+    std::string from = "assets/balance.txt", out;
+    int gens = 30, pop = 16;
+    unsigned threads = std::max(1u, std::thread::hardware_concurrency());
+
+    for (int i = 1; i < argc; ++i) {
+        const std::string a = argv[i];
+        auto val = [&]() -> std::string { return (i + 1 < argc) ? argv[++i] : ""; };
+        if      (a == "--target")  { if (!parseTargets(val(), targets)) return 1; }
+        else if (a == "--from")    from = val();
+        else if (a == "--runs")    setup.runs = std::max(1, std::atoi(val().c_str()));
+        else if (a == "--gens")    gens = std::max(0, std::atoi(val().c_str()));
+        else if (a == "--pop")     pop = std::max(1, std::atoi(val().c_str()));
+        else if (a == "--threads") threads = static_cast<unsigned>(std::max(1, std::atoi(val().c_str())));
+        else if (a == "--seed")    setup.seed = static_cast<unsigned>(std::strtoul(val().c_str(), nullptr, 10));
+        else if (a == "--out")     out = val();
+        else { usage(); return a == "--help" ? 0 : 1; }
+    }
+
+    BalanceParams start;
+    std::string error;
+    if (!LoadBalanceParams(from, start, error)) { std::cerr << "balance " << error << "\n"; return 1; }
+
+    // Load everything lazy before the workers start: the registry, the
+    // scripts, the rule tables and the session's numbers.
+    Shrines();
+    for (Deity d : setup.route) ShrineScriptFor(d);
+    EndingRules();
+    ErisScoreRules();
+    Balance();
+
+    const auto t0 = std::chrono::steady_clock::now();
+    const std::vector<double> before = distribution(setup, targets, start);
+    printDistribution(targets, before, "Endings now");
+    if (!targets.any) return 0;
+
+    BalanceParams best = start;
+    double bestScore = score(targets, before, start, start);
+    std::vector<double> bestShare = before;
+    RNG search(setup.seed);
+
+    std::vector<BalanceParams> cands(static_cast<std::size_t>(pop));
+    std::vector<std::vector<double>> shares(cands.size());
+    for (int g = 0; g < gens; ++g) {
+        const double radius = 0.5 * (1.0 - static_cast<double>(g) / gens) + 0.05;
+        for (BalanceParams& c : cands) c = mutate(best, search, radius);
+
+        std::atomic<std::size_t> next{0};
+        auto work = [&] {
+            for (std::size_t i; (i = next++) < cands.size();)
+                shares[i] = distribution(setup, targets, cands[i]);
+        };
+        std::vector<std::thread> pool;
+        for (unsigned w = 1; w < std::min<unsigned>(threads, static_cast<unsigned>(cands.size())); ++w)
+            pool.emplace_back(work);
+        work();
+        for (std::thread& th : pool) th.join();
+
+        for (std::size_t i = 0; i < cands.size(); ++i) {
+            const double sc = score(targets, shares[i], cands[i], start);
+            if (sc < bestScore) { bestScore = sc; best = cands[i]; bestShare = shares[i]; }
+        }
+        std::cout << "gen " << std::setw(3) << g + 1 << "  score " << std::scientific
+                  << std::setprecision(3) << bestScore << std::defaultfloat << "\n";
+    }
+    const double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+
+    printDistribution(targets, bestShare, "Endings tuned");
+    std::cout << std::fixed << std::setprecision(1) << secs << " s, "
+              << static_cast<long long>(gens) * pop * setup.runs << " runs, " << threads << " threads\n";
+
+    std::ostringstream header;
+    header << "Tuned by bin/balance (" << setup.runs << " runs x " << gens << " generations, seed "
+           << setup.seed << ") for:\n";
+    for (std::size_t i = 0; i < targets.ids.size(); ++i)
+        if (targets.want[i] >= 0)
+            header << "  " << targets.ids[i] << " " << std::setprecision(3) << targets.want[i] << "\n";
+    const std::string text = FormatBalanceParams(best, header.str());
+    if (out.empty()) { std::cout << "\n" << text; return 0; }
+    std::ofstream file(out);
+    if (!(file << text)) { std::cerr << "can't write " << out << "\n"; return 1; }
+    std::cout << "wrote " << out << "\n";
+    return 0;
+}
@@ -0,0 +1,356 @@
+// bench.cpp — world/graph stress benchmarks on procedurally generated temples,
+// plus simulated-player bookkeeping (scalar PlayerState vs PlayerBatch),
+// skill-check dice (RNG + resolve vs D10Stream + resolveBatch), many
+// sessions' timed events (SessionScheduler), wanderers on each temple, and
+// shrines driven with no UI (quiet) against one that reads every line.
+// Build: make bench OPTFLAGS=-O2     Run: ./bin/bench [maxRooms] [seed]
+#include "TempleGenerator.hpp"
+#include "Pathfinding.hpp"
+#include "Dice.hpp"
+#include "EventScheduler.hpp"
+#include "HeadlessUI.hpp"
+#include "Map.hpp"
+#include "PersephoneFragments.hpp"
+#include "PlayerBatch.hpp"
+#include "ShrineBehavior.hpp"
+#include "ShrineRunner.hpp"
+#include "Wanderers.hpp"
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <iomanip>
+#include <random>
+#include <sstream>
+#include <string>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double msSince(Clock::time_point t0) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+}
+
+// Above this the n*n next-hop table doesn't fit in a laptop's memory.
+constexpr double kMaxTableBytes = 2.0 * 1024 * 1024 * 1024;
+
+void row(const std::string& what, const std::string& value) {
+    std::cout << "  " << std::left << std::setw(28) << what << value << "\n";
+}
+
+std::string fmtMs(double ms) {
+    std::ostringstream oss; oss << std::fixed << std::setprecision(2) << ms << " ms";
+    return oss.str();
+}
+
+std::string fmtNs(double ns) {
+    std::ostringstream oss; oss << std::fixed << std::setprecision(1) << ns << " ns";
+    return oss.str();
+}
+
+void benchSize(int rooms, std::uint32_t seed) {
+    std::cout << "\n=== " << rooms << " rooms (seed " << seed << ") ===\n";
+
+    // --- world build --------------------------------------------------------
+    GeneratedTemple world;
+    TempleGenOptions opts;
+    opts.seed = seed;
+    opts.roomCount = rooms;
+    auto t0 = Clock::now();
+    GenerateTemple(opts, world);
+    row("world build", fmtMs(msSince(t0)));
+
+    const int n = world.map.size();
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> anyRoom(0, n - 1);
+    std::uniform_int_distribution<int> anyDir(0, kDirCount - 1);
+
+    // --- movement: random walk through TempleMap::exit ----------------------
+    {
+        const int steps = 2'000'000;
+        int cur = world.hub, moved = 0;
+        t0 = Clock::now();
+        for (int i = 0; i < steps; ++i) {
+            const int to = world.map.exit(cur, static_cast<Dir>(anyDir(rng)));
+            if (to >= 0) { cur = to; ++moved; }
+        }
+        const double ms = msSince(t0);
+        row("movement (exit lookup)", fmtNs(ms * 1e6 / steps) + " / step (" + std::to_string(moved) + " moves)");
+    }
+
+    // --- title index --------------------------------------------------------
+    {
+        const int lookups = 200'000;
+        int hits = 0;
+        t0 = Clock::now();
+        for (int i = 0; i < lookups; ++i)
+            hits += world.map.indexByTitle(world.map.nodes()[anyRoom(rng)].name) >= 0;
+        row("title lookup", fmtNs(msSince(t0) * 1e6 / lookups) + " / lookup (" + std::to_string(hits) + " hits)");
+    }
+
+    // --- pathfinding: all-pairs next-hop table -----------------------------
+    {
+        const double bytes = static_cast<double>(n) * n * sizeof(int);
+        if (bytes > kMaxTableBytes) {
+            std::ostringstream oss;
+            oss << "SKIPPED: table needs " << std::fixed << std::setprecision(1)
+                << bytes / (1024.0 * 1024 * 1024) << " GiB (n^2 ints)";
+            row("next-hop table build", oss.str());
+        } else {
+            NextHopTable paths;
+            t0 = Clock::now();
+            paths.build(world.map);
+            row("next-hop table build", fmtMs(msSince(t0)));
+
+            const int routes = 100'000;
+            long long steps = 0;
+            t0 = Clock::now();
+            for (int i = 0; i < routes; ++i) {
+                int cur = anyRoom(rng);
+                const int to = anyRoom(rng);
+                while (cur != to && cur >= 0) { cur = paths.next(cur, to); ++steps; }
+            }
+            const double ms = msSince(t0);
+            row("route walk", fmtNs(ms * 1e6 / (steps ? steps : 1)) + " / step (avg "
+                + std::to_string(steps / routes) + " steps)");
+        }
+    }
+
+    // --- wanderers: 5000 shadows and stalkers while the player walks ---------
+    {
+        const int count = 5000, ticks = 200;
+        Wanderers pack;
+        t0 = Clock::now();
+        pack.attach(world.map, seed);
+        pack.setLit(world.hub, true);
+        for (int i = 0; i < count; ++i)
+            pack.spawn(i % 4 ? WandererKind::Shadow : WandererKind::Stalker, anyRoom(rng));
+        row("wanderers attach + spawn", fmtMs(msSince(t0)));
+
+        std::vector<WandererSighting> seen;
+        int cur = world.hub;
+        std::size_t sightings = 0;
+        t0 = Clock::now();
+        for (int t = 0; t < ticks; ++t) {
+            if (t % 2) {   // the player moves every other tick
+                const int to = world.map.exit(cur, static_cast<Dir>(anyDir(rng)));
+                if (to >= 0) cur = to;
+            }
+            seen.clear();
+            pack.step(cur, t < ticks / 2, seen);
+            sightings += seen.size();
+        }
+        row("wanderers step", fmtNs(msSince(t0) * 1e6 / (static_cast<double>(count) * ticks))
+            + " / wanderer (" + std::to_string(sightings) + " sightings)");
+    }
+
+    // --- map rendering ------------------------------------------------------
+    {
+        MapView view;
+        AccessibilitySettings as;
+        as.colorEnabled = false;
+        view.reset(world.map, world.hub);
+        view.setStyle(as, ShrineState::CORRUPTED);
+
+        t0 = Clock::now();
+        const size_t bytes = view.render(world.hub).size();
+        row("map first render", fmtMs(msSince(t0)) + " (" + std::to_string(bytes / 1024) + " KiB)");
+
+        const int visits = 200;
+        t0 = Clock::now();
+        for (int i = 0; i < visits; ++i) view.markVisited(anyRoom(rng));
+        row("map visit patch", fmtNs(msSince(t0) * 1e6 / visits) + " / visit");
+
+        t0 = Clock::now();
+        for (int i = 0; i < visits; ++i) view.render(anyRoom(rng));
+        row("map re-render (move)", fmtNs(msSince(t0) * 1e6 / visits) + " / call");
+    }
+}
+
+// --- simulated players: applyOutcome per PlayerState vs one PlayerBatch pass ---
+void benchPlayers(std::uint32_t seed) {
+    const std::size_t players = 100'000;
+    const int steps = 50;
+    std::cout << "\n=== " << players << " simulated players, " << steps << " outcomes each ===\n";
+
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> delta(-2, 2);
+    std::vector<Outcome> outs(players);
+    OutcomeBatch staged(players);
+    for (std::size_t i = 0; i < players; ++i) {
+        outs[i].healthDelta = delta(rng);  outs[i].willDelta = delta(rng);
+        outs[i].insightDelta = delta(rng); outs[i].nerveDelta = delta(rng);
+        outs[i].corruptionDelta = delta(rng) * 5;
+        staged.set(i, outs[i]);
+    }
+
+    std::vector<PlayerState> scalar(players);
+    auto t0 = Clock::now();
+    for (int s = 0; s < steps; ++s)
+        for (std::size_t i = 0; i < players; ++i) scalar[i].applyOutcome(outs[i]);
+    const double scalarMs = msSince(t0);
+    row("PlayerState::applyOutcome", fmtNs(scalarMs * 1e6 / (players * steps)) + " / player");
+
+    PlayerBatch batch(players);
+    t0 = Clock::now();
+    for (int s = 0; s < steps; ++s) batch.apply(staged);
+    const double batchMs = msSince(t0);
+    row("PlayerBatch::apply", fmtNs(batchMs * 1e6 / (players * steps)) + " / player");
+
+    // same numbers either way
+    std::size_t diff = 0;
+    for (std::size_t i = 0; i < players; ++i)
+        diff += scalar[i].stats.will != batch.will[i] || scalar[i].corruption != batch.corruption[i];
+    row("lanes that disagree", std::to_string(diff));
+}
+
+// --- skill checks: one RNG roll at a time vs bulk dice ------------------------
+void benchChecks(std::uint32_t seed) {
+    const std::size_t checks = 1'000'000;
+    std::cout << "\n=== " << checks << " skill checks (mixed advantage) ===\n";
+
+    std::vector<int> dc(checks), stat(checks);
+    std::vector<CheckMods> mods(checks);
+    std::mt19937 rng(seed);
+    for (std::size_t i = 0; i < checks; ++i) {
+        dc[i] = 6 + static_cast<int>(rng() % 6);
+        stat[i] = static_cast<int>(rng() % 8);
+        mods[i].advantage = i % 3 == 1;
+        mods[i].disadvantage = i % 3 == 2;
+    }
+    double expected = 0;
+    for (std::size_t i = 0; i < checks; ++i) expected += SkillCheck::successProbability(dc[i], stat[i], mods[i]);
+
+    RNG scalarRng(seed);
+    std::size_t passed = 0;
+    auto t0 = Clock::now();
+    for (std::size_t i = 0; i < checks; ++i) passed += SkillCheck::resolve(scalarRng, dc[i], stat[i], mods[i]);
+    const double scalarMs = msSince(t0);
+    row("RNG + SkillCheck::resolve", fmtNs(scalarMs * 1e6 / checks) + " / check ("
+        + std::to_string(passed) + " passed)");
+
+    D10Stream dice(seed);
+    std::vector<std::uint8_t> ok(checks);
+    t0 = Clock::now();
+    SkillCheck::resolveBatch(dice, dc.data(), stat.data(), mods.data(), ok.data(), checks);
+    const double batchMs = msSince(t0);
+    passed = 0;
+    for (std::uint8_t p : ok) passed += p;
+    row("D10Stream + resolveBatch", fmtNs(batchMs * 1e6 / checks) + " / check ("
+        + std::to_string(passed) + " passed)");
+    row("expected passes", std::to_string(static_cast<long long>(expected + 0.5)));
+}
+
+// --- timed events: many sessions, each with a few pending, ticked together ----
+void benchScheduler(std::uint32_t seed) {
+    const std::size_t sessions = 10'000;
+    const int ticks = 1000;
+    std::cout << "\n=== " << sessions << " sessions, " << ticks << " turns + clock ticks ===\n";
+
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> soon(1, 600), later(1, 20'000);
+    std::vector<SessionScheduler> all(sessions);
+    const auto origin = SessionScheduler::Clock::now();
+    auto t0 = Clock::now();
+    for (SessionScheduler& s : all) {
+        s.start(origin);
+        for (int i = 0; i < 4; ++i) s.inTurns(soon(rng), {TimedKind::Whisper, i});
+        s.in(std::chrono::milliseconds(later(rng) * 100), {TimedKind::CorruptionCreep});
+    }
+    row("schedule", fmtNs(msSince(t0) * 1e6 / (sessions * 5)) + " / event");
+
+    std::size_t fired = 0;
+    t0 = Clock::now();
+    for (int t = 1; t <= ticks; ++t) {
+        const auto now = origin + t * SessionScheduler::kClockTick;
+        for (SessionScheduler& s : all) {
+            s.turn();
+            s.tick(now);
+            for (TimedEvent e; s.next(e);) {
+                ++fired;
+                if (e.kind == TimedKind::Whisper) s.inTurns(soon(rng), e);   // ambience re-arms
+            }
+        }
+    }
+    row("turn + tick + drain", fmtNs(msSince(t0) * 1e6 / (sessions * ticks)) + " / session");
+    std::size_t pending = 0;
+    for (const SessionScheduler& s : all) pending += s.pending();
+    row("fired / still pending", std::to_string(fired) + " / " + std::to_string(pending));
+}
+
+// --- shrine text: quiet (HeadlessUI) vs a backend that reads every line -------
+struct NullJournal : IJournalSink {
+    void writeLysaia(const std::string&) override {}
+    void writeMelas(const std::string&) override {}
+};
+
+// Takes the text like a terminal would, picks like RandomPolicy.
+struct ReadingUI {
+    RNG* rng = nullptr;
+    std::size_t chars = 0;
+    void print(const std::string& s) { chars += s.size(); }
+    void waitForKey() {}
+    void flash(const std::string& s, int) { chars += s.size(); }
+    int choose(const std::string& prompt, const std::vector<std::string>& options) {
+        chars += prompt.size();
+        for (const std::string& o : options) chars += o.size();
+        return rng->roll(1, options.empty() ? 8 : static_cast<int>(options.size()));
+    }
+    std::string ask(const std::string& prompt) { chars += prompt.size(); return {}; }
+};
+
+template <class UIT>
+double shrineRunNs(std::unique_ptr<ShrineCoroutine> (*start)(InteractionContext&), UIT& ui, RNG& rng, int runs) {
+    PlayerState ps;
+    for (int i = 1; i <= kPersephoneFragmentCount; ++i) ps.addItem(PersephoneFragmentItem(i));
+    NullJournal journal;
+    FlagStore flags;
+    InteractionContext ctx{ps, rng, journal, WorldView::Corrupted, ShrineState::CORRUPTED, flags};
+    volatile int sink = 0;
+    const auto t0 = Clock::now();
+    for (int i = 0; i < runs; ++i) {
+        ps.stats.will = 5;
+        ps.corruption = i % 40;
+        sink = sink + DriveShrine(*start(ctx), ui).willDelta;
+    }
+    return msSince(t0) * 1e6 / runs;
+}
+
+void benchShrineText(std::uint32_t seed) {
+    const int runs = 20'000;
+    std::cout << "\n=== " << runs << " runs per shrine, random picks ===\n";
+    struct Case { const char* name; std::unique_ptr<ShrineCoroutine> (*start)(InteractionContext&); };
+    const Case cases[] = {
+        {"Demeter", StartDemeterLetter_FromInventory},
+        {"Apollo", [](InteractionContext& c) { return StartApolloRiddles(c, ApolloRiddleSet()); }},
+        {"Pan", [](InteractionContext& c) { const PanRules p; return StartPanMemory(c, p.rounds, p.noteRange); }},
+        {"False Hermes", StartFalseHermesEndlessHall},
+        {"Eris", StartErisFinal},
+    };
+    for (const Case& c : cases) {
+        RNG quietRng(seed), readRng(seed);
+        HeadlessUI<RandomPolicy> quiet;
+        quiet.policy.rng = &quietRng;
+        ReadingUI reading;
+        reading.rng = &readRng;
+        const double quietNs = shrineRunNs(c.start, quiet, quietRng, runs);
+        const double readNs = shrineRunNs(c.start, reading, readRng, runs);
+        row(c.name, fmtNs(quietNs) + " quiet, " + fmtNs(readNs) + " read ("
+            + std::to_string(reading.chars / runs) + " chars a run)");
+    }
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const int maxRooms = argc > 1 ? std::atoi(argv[1]) : 1'000'000;
+    const auto seed = static_cast<std::uint32_t>(argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 1u);
+
+    for (int rooms = 1000; rooms <= maxRooms; rooms *= 10) benchSize(rooms, seed);
+    benchPlayers(seed);
+    benchChecks(seed);
+    benchScheduler(seed);
+    benchShrineText(seed);
+    return 0;
+}
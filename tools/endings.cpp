@@ -0,0 +1,97 @@
+// endings.cpp — exact ending odds for a shrine route and play policy.
+// Build: make endings     Run: ./bin/endings [options]   (--help for the list)
+#include "EndingAnalyzer.hpp"
+#include "ShrineRunner.hpp"   // DeityFromName
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+namespace {
+
+void usage() {
+    std::cout <<
+        "usage: endings [options]\n"
+        "  --route a,b,...     shrines in visit order (default: every wing, Eris last)\n"
+        "  --stats H,W,I,N     starting health/will/insight/nerve (default 5,7,2,2)\n"
+        "  --corruption N      starting corruption (default 10)\n"
+        "  --lysaia            uncorrupted temple (default: Melas)\n"
+        "  --fragments N       Persephone fragments held at Demeter (default 8)\n"
+        "  --guess-order       arrange Demeter's letter at random\n"
+        "  --nyx-pages         Nyx can take a journal page\n"
+        "  --apollo-known N    riddles known for sure, rest guessed (default 5)\n"
+        "  --hecate N          door 1/2/3 (default 1)\n"
+        "  --pan-recall N      longest note run remembered (default 5)\n"
+        "  --thanatos N        1 rest, 2 keep moving (default 2)\n"
+        "  --eris N            1 resist, 2 plead, 3 join (default 1)\n";
+}
+
+std::vector<Deity> parseRoute(const std::string& list) {
+    std::vector<Deity> route;
+    std::istringstream iss(list);
+    std::string name;
+    while (std::getline(iss, name, ',')) {
+        const Deity d = DeityFromName(name);
+        if (d == Deity::Default) std::cerr << "unknown shrine '" << name << "', skipped\n";
+        else route.push_back(d);
+    }
+    return route;
+}
+
+std::string signedFixed(double v) {
+    std::ostringstream oss;
+    oss << std::showpos << std::fixed << std::setprecision(3) << v;
+    return oss.str();
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Stats start;                 // same start as InitMechanics for Melas
+    start.health = 5; start.will = 7; start.insight = 2; start.nerve = 2;
+    int corruption = 10;
+    AnalyzerPolicy policy;
+    policy.route = DefaultShrineRoute();
+
+    for (int i = 1; i < argc; ++i) {
+        const std::string a = argv[i];
+        auto val = [&]() -> std::string { return (i + 1 < argc) ? argv[++i] : ""; };
+        if      (a == "--route")        policy.route = parseRoute(val());
+        else if (a == "--stats")        std::sscanf(val().c_str(), "%d,%d,%d,%d", &start.health, &start.will, &start.insight, &start.nerve);
+        else if (a == "--corruption")   corruption = std::atoi(val().c_str());
+        else if (a == "--lysaia")       { policy.view = WorldView::Uncorrupted; corruption = 0; }
+        else if (a == "--fragments")    policy.demeterFragments = std::atoi(val().c_str());
+        else if (a == "--guess-order")  policy.demeterKnowsOrder = false;
+        else if (a == "--nyx-pages")    policy.nyxHasPages = true;
+        else if (a == "--apollo-known") policy.apolloKnown = std::atoi(val().c_str());
+        else if (a == "--hecate")       policy.hecateDoor = std::atoi(val().c_str());
+        else if (a == "--pan-recall")   policy.panRecall = std::atoi(val().c_str());
+        else if (a == "--thanatos")     policy.thanatosChoice = std::atoi(val().c_str());
+        else if (a == "--eris")         policy.erisChoice = std::atoi(val().c_str());
+        else { usage(); return a == "--help" ? 0 : 1; }
+    }
+
+    const auto t0 = std::chrono::steady_clock::now();
+    const EndingReport r = AnalyzeEndings(start, corruption, policy);
+    const double us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - t0).count();
+
+    std::cout << "=== ENDINGS (exact) ===\n";
+    for (int e = 0; e < kEndingCount; ++e) {
+        std::cout << "  " << std::left << std::setw(24) << endingName(static_cast<Ending>(e))
+                  << std::right << std::fixed << std::setprecision(4)
+                  << r.probability[e] * 100.0 << " %\n";
+    }
+    std::cout << "\n=== EXPECTED CHANGE ===\n"
+              << "  health     " << signedFixed(r.health) << "\n"
+              << "  will       " << signedFixed(r.will) << "\n"
+              << "  insight    " << signedFixed(r.insight) << "\n"
+              << "  nerve      " << signedFixed(r.nerve) << "\n"
+              << "  corruption " << signedFixed(r.corruption) << "\n"
+              << "\n  broken (health or will at 0): " << std::noshowpos << std::setprecision(4)
+              << r.pBroken * 100.0 << " %\n"
+              << "  " << r.peakStates << " states at most, " << std::setprecision(0) << us << " us\n";
+    return 0;
+}
@@ -0,0 +1,44 @@
+// hermes.cpp — False Hermes endless-hall odds for every starting will/corruption.
+// Build: make hermes     Run: ./bin/hermes            (trap % grid)
+//                             ./bin/hermes WILL CORR  (one start in detail)
+#include "FalseHermesSolver.hpp"
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+
+int main(int argc, char** argv) {
+    const auto t0 = std::chrono::steady_clock::now();
+    const FalseHermesTable& table = FalseHermesTable::instance();
+    const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+
+    if (argc >= 3) {
+        const int will = std::atoi(argv[1]), corruption = std::atoi(argv[2]);
+        const HermesOdds& o = table.odds(will, corruption);
+        std::cout << std::fixed << std::setprecision(4)
+                  << "=== FALSE HERMES: will " << will << ", corruption " << corruption << " ===\n"
+                  << "  trapped          " << o.trap * 100.0 << " %\n"
+                  << "  will after       " << o.will << "\n"
+                  << "  corruption after " << o.corruption << "\n"
+                  << "  nerve change     " << o.nerveDelta << "\n"
+                  << "  rolls            " << o.checks << "\n\n"
+                  << "  ends (will, corruption before the outcome):\n";
+        for (auto it = table.finalsBegin(will, corruption); it != table.finalsEnd(will, corruption); ++it)
+            std::cout << "    " << (it->trapped ? "trapped " : "escaped ") << std::setw(2) << it->will
+                      << ", " << std::setw(3) << it->corruption << "   " << it->p * 100.0 << " %\n";
+        return 0;
+    }
+
+    std::cout << "=== FALSE HERMES: P(trapped) %, will down / corruption across ===\n      ";
+    for (int c = 0; c <= FalseHermesTable::kMaxCorruption; c += 10) std::cout << std::setw(6) << c;
+    std::cout << "\n";
+    for (int w = 0; w <= FalseHermesTable::kMaxWill; ++w) {
+        std::cout << std::setw(6) << w;
+        for (int c = 0; c <= FalseHermesTable::kMaxCorruption; c += 10)
+            std::cout << std::setw(6) << std::fixed << std::setprecision(1) << table.odds(w, c).trap * 100.0;
+        std::cout << "\n";
+    }
+    std::cout << "\n(solved all " << (FalseHermesTable::kMaxWill + 1) * (FalseHermesTable::kMaxCorruption + 1)
+              << " starts in " << std::setprecision(2) << ms << " ms)\n";
+    return 0;
+}
@@ -0,0 +1,271 @@
+// shrines.cpp — check the .shrine scripts against the built-in C++ mechanics.
+// Build: make shrines     Run: ./bin/shrines [SEEDS] [DIR]
+// Compiles every script in DIR (default assets/shrines), replays each shrine
+// over SEEDS seeded players both ways and diffs the transcripts, outcomes and
+// flags, then times the two with no UI at all. Then lists the shrine registry
+// and plays every module shrine (bin/modules, see `make modules`) over the
+// same seeds, twice, to check a visit depends on nothing but its seed. Last,
+// checks the riddle bank (assets/riddles.txt) and its shuffle-bag.
+#include "HeadlessUI.hpp"
+#include "ItemCatalog.hpp"
+#include "PersephoneFragments.hpp"
+#include "RiddleBank.hpp"
+#include "ScriptedUI.hpp"
+#include "ShrineCoroutine.hpp"
+#include "ShrineRegistry.hpp"
+#include "ShrineRunner.hpp"
+#include "ShrineScript.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <optional>
+#include <set>
+#include <sstream>
+
+namespace {
+
+const char* const kDeities[] = {"Demeter", "Nyx", "Apollo", "Hecate", "Pan",
+                                "False Hermes", "Thanatos", "Eris", "Persephone"};
+const char* const kFlags[] = {"demeter_letter_solved", "nyx_helpful_trade", "apollo_majority_right",
+                              "pan_memory_mastered", "false_hermes_endless_hall", "thanatos_sleep_end",
+                              "ending_join_eris", "ending_save_lysaia", "ending_overcome",
+                              "ending_claimed", "hecate_choice"};
+
+struct NullJournal : IJournalSink {
+    void writeLysaia(const std::string&) override {}
+    void writeMelas(const std::string&) override {}
+};
+
+// One seeded player, varied enough to reach every branch across a few hundred seeds.
+struct Setup {
+    RNG rng;
+    PlayerState ps;
+    NullJournal journal;
+    FlagStore flags;
+    RiddleBag riddles;
+    InteractionContext ctx;
+    int taken = 0;
+    ShrineServices svc;
+    std::vector<std::string> given;
+
+    Setup(int seed, bool melas)
+        : rng(seed), riddles(DefaultRiddleBank(), static_cast<std::uint32_t>(seed)),
+          ctx{ps, rng, journal, melas ? WorldView::Corrupted : WorldView::Uncorrupted,
+              ShrineState::CORRUPTED, flags} {
+        ps.corruption = seed % 60;
+        ps.stats.will = seed % 11;
+        ps.stats.nerve = seed % 7;
+        if (seed % 3) for (int i = 1; i <= 8; ++i) ps.addItem(PersephoneFragmentItem(i));
+        if (seed % 4 == 0) {
+            flags["apollo_majority_right"] = true;
+            flags["pan_memory_mastered"] = true;
+            flags["demeter_letter_solved"] = true;
+        }
+        if (seed % 2) {
+            svc.takeMelasEntry = [this]() -> std::optional<std::string> {
+                if (taken++) return std::nullopt;
+                return std::string("page");
+            };
+            svc.giveMelasEntry = [this](const std::string& s) { given.push_back(s); };
+        } else {
+            svc.riddles = &riddles;   // Apollo from the bank rather than his usual five
+        }
+    }
+};
+
+void queueAnswers(ScriptedUI& ui, int seed) {
+    RNG a(seed * 7);
+    for (int k = 0; k < 40; ++k) {
+        if (k % 5 == 4) ui.answer(std::to_string(a.roll(1, 5)) + " " + std::to_string(a.roll(1, 5)));
+        else            ui.answer(a.roll(1, (seed % 8) + 2));
+    }
+}
+
+std::string replay(const std::string& deity, int seed, bool melas, bool script) {
+    Setup s(seed, melas);
+    ScriptedUI ui;
+    queueAnswers(ui, seed);
+    const Shrine shrine(deity, "room");
+    auto co = script ? StartShrine(shrine, s.ctx, s.svc) : StartBuiltinShrine(shrine, s.ctx, s.svc);
+    const Outcome o = DriveShrine(*co, ui);
+
+    std::ostringstream out;
+    for (const auto& line : ui.transcript()) out << line << "\n";
+    for (const auto& g : s.given) out << "GIVE " << g << "\n";
+    out << "OUT " << o.healthDelta << " " << o.willDelta << " " << o.insightDelta << " " << o.nerveDelta
+        << " " << o.corruptionDelta << " items " << o.itemsGained.size() << " | " << o.journalEntry << "\n"
+        << "PS " << s.ps.stats.will << " " << s.ps.corruption << " left " << ui.pending()
+        << " next " << s.rng.roll(1, 1000) << "\nFLAGS ";
+    for (const char* f : kFlags) out << static_cast<bool>(s.flags[f]);
+    out << "\n";
+    return out.str();
+}
+
+std::string firstDifference(const std::string& a, const std::string& b) {
+    std::istringstream ia(a), ib(b);
+    std::string la, lb;
+    for (int n = 1;; ++n) {
+        const bool ga = static_cast<bool>(std::getline(ia, la)), gb = static_cast<bool>(std::getline(ib, lb));
+        if (!ga && !gb) return "";
+        if (!ga || !gb || la != lb)
+            return "line " + std::to_string(n) + "\n      C++:    " + (ga ? la : "<end>") +
+                   "\n      script: " + (gb ? lb : "<end>");
+    }
+}
+
+// Whole shrine with random picks and no output, `runs` times. Returns ns per run.
+double timeRuns(const char* deity, bool script, int runs) {
+    const Shrine shrine(deity, "room");
+    const auto t0 = std::chrono::steady_clock::now();
+    volatile int sink = 0;   // keep the runs from being optimised away
+    for (int i = 0; i < runs; ++i) {
+        Setup s(i + 1, true);
+        HeadlessUI<RandomPolicy> ui;
+        ui.policy.rng = &s.rng;
+        auto co = script ? StartShrine(shrine, s.ctx, s.svc) : StartBuiltinShrine(shrine, s.ctx, s.svc);
+        sink = sink + DriveShrine(*co, ui).willDelta;
+    }
+    const double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - t0).count();
+    return ns / runs;
+}
+
+// Deal ten passes of the bank, a visit at a time. A visit must not repeat a
+// riddle, and no riddle may be dealt twice before every other one has been:
+// at any point the deal counts differ by at most one.
+int checkRiddleBag(const RiddleBank& bank) {
+    RiddleBag bag(bank, 7);
+    const int perVisit = ApolloRiddleSet().size();
+    std::vector<int> dealt(bank.size(), 0);
+    int problems = 0;
+    for (int visit = 0; visit < 10 * static_cast<int>(bank.size()) / perVisit; ++visit) {
+        const RiddleSet set = bag.draw(perVisit);
+        if (static_cast<int>(std::set<const Riddle*>(set.begin(), set.end()).size()) != perVisit) ++problems;
+        for (int i = 1; i < set.size(); ++i)
+            if (set[i].difficulty < set[i - 1].difficulty) ++problems;
+        for (const Riddle* r : set) ++dealt[static_cast<std::size_t>(r - &bank[0])];
+        const auto [lo, hi] = std::minmax_element(dealt.begin(), dealt.end());
+        if (*hi - *lo > 1) ++problems;
+    }
+    return problems;
+}
+
+void usage() {
+    std::cout <<
+        "usage: shrines [SEEDS] [DIR]\n"
+        "  SEEDS   seeded players per shrine, at least 1 (default 400)\n"
+        "  DIR     where the .shrine scripts are (default assets/shrines)\n";
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    int seeds = 400;
+    if (argc >= 2) {
+        const std::string a = argv[1];
+        char* end = nullptr;
+        const long n = std::strtol(a.c_str(), &end, 10);
+        if (a.empty() || *end != '\0' || n < 1 || n > 1'000'000 || argc > 3) {
+            usage();
+            return a == "--help" ? 0 : 1;
+        }
+        seeds = static_cast<int>(n);
+    }
+    const std::string dir = argc >= 3 ? argv[2] : "assets/shrines";
+    SetShrineScriptDir(dir);
+
+    std::cout << "=== SCRIPTS (" << dir << ") ===\n";
+    bool anyScript = false;
+    for (const char* deity : kDeities) {
+        const std::string name = ShrineScriptName(DeityFromName(deity));
+        std::ifstream in(dir + "/" + name + ".shrine");
+        if (!in) { std::cout << "  " << std::left << std::setw(14) << name << "missing (built-in)\n"; continue; }
+        std::stringstream src;
+        src << in.rdbuf();
+        ShrineProgram program;
+        std::string error;
+        if (!CompileShrineScript(src.str(), name + ".shrine", program, error)) {
+            std::cout << "  " << std::left << std::setw(14) << name << "ERROR " << error << "\n";
+            continue;
+        }
+        anyScript = true;
+        std::cout << "  " << std::left << std::setw(14) << name << std::right << std::setw(5)
+                  << program.code.size() << " words, " << program.texts.size() << " texts, "
+                  << program.locals << " locals\n";
+    }
+    if (!anyScript) return 1;
+
+    std::cout << "\n=== SCRIPT vs C++, " << seeds << " seeds x 2 views ===\n";
+    int failures = 0;
+    for (const char* deity : kDeities) {
+        if (!ShrineScriptFor(DeityFromName(deity))) continue;
+        int same = 0;
+        std::string report;
+        for (int seed = 1; seed <= seeds; ++seed)
+            for (int view = 0; view < 2; ++view) {
+                const std::string a = replay(deity, seed, view, false), b = replay(deity, seed, view, true);
+                if (a == b) { ++same; continue; }
+                if (report.empty())
+                    report = "    seed " + std::to_string(seed) + " view " + std::to_string(view) + ", " +
+                             firstDifference(a, b) + "\n";
+            }
+        std::cout << "  " << std::left << std::setw(14) << deity << std::right << std::setw(6) << same << "/"
+                  << seeds * 2 << (same == seeds * 2 ? "  same\n" : "  DIFFERENT\n") << report;
+        failures += seeds * 2 - same;
+    }
+
+    std::cout << "\n=== SHRINE REGISTRY ===\n";
+    for (std::size_t i = 0; i < Shrines().size(); ++i) {
+        const ShrineHandler& h = Shrines().get(static_cast<ShrineHandlerId>(i));
+        const bool resolves = Shrine(h.label, "room").handler() == i;
+        std::cout << "  " << std::setw(3) << i << "  " << std::left << std::setw(14) << h.key << std::right
+                  << (h.module ? "module" : ShrineScriptFor(static_cast<ShrineHandlerId>(i)) ? "script" : "C++")
+                  << (resolves ? "" : "  NAME DOESN'T RESOLVE") << "\n";
+        failures += !resolves;
+    }
+    for (std::size_t i = 0; i < Shrines().size(); ++i) {
+        const ShrineHandler& h = Shrines().get(static_cast<ShrineHandlerId>(i));
+        if (!h.module) continue;
+        int same = 0, favoured = 0;
+        for (int seed = 1; seed <= seeds; ++seed)
+            for (int view = 0; view < 2; ++view) {
+                const std::string a = replay(h.label, seed, view, true);
+                same += a == replay(h.label, seed, view, true);
+                favoured += a.find("OUT 0 0 0") == std::string::npos;   // anything happened at all
+            }
+        std::cout << "  " << std::left << std::setw(14) << h.label << std::right << std::setw(6) << same << "/"
+                  << seeds * 2 << (same == seeds * 2 ? "  repeatable" : "  NOT REPEATABLE") << ", "
+                  << favoured << " changed the player\n";
+        failures += seeds * 2 - same;
+    }
+
+    std::cout << "\n=== TIME PER SHRINE (headless, random picks) ===\n"
+              << "                   C++      script   ratio\n";
+    for (const char* deity : kDeities) {
+        if (!ShrineScriptFor(DeityFromName(deity))) continue;
+        const int runs = 20000;
+        const double native = timeRuns(deity, false, runs), script = timeRuns(deity, true, runs);
+        std::cout << "  " << std::left << std::setw(14) << deity << std::right << std::fixed
+                  << std::setprecision(0) << std::setw(7) << native << " ns" << std::setw(8) << script
+                  << " ns" << std::setprecision(2) << std::setw(7) << script / native << "x\n";
+    }
+
+    const RiddleBank& bank = DefaultRiddleBank();
+    std::cout << "\n=== RIDDLE BANK ===\n  " << bank.size() << " riddles (easy " << bank.count(1)
+              << ", middling " << bank.count(2) << ", hard " << bank.count(3) << ")\n";
+    if (!bank.empty()) {
+        const int problems = checkRiddleBag(bank);
+        RiddleBag bag(bank, 1);
+        const int draws = 1000000;
+        const auto t0 = std::chrono::steady_clock::now();
+        int sink = 0;
+        for (int i = 0; i < draws; ++i) sink += bag.draw(ApolloRiddleSet().size()).size();
+        const double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - t0).count();
+        std::cout << "  shuffle-bag: " << (problems ? "REPEATS" : "no repeats") << " over 10 passes, "
+                  << std::setprecision(1) << ns / draws << " ns a visit (" << sink / draws << " riddles)\n";
+        failures += problems;
+    }
+    return failures ? 1 : 0;
+}